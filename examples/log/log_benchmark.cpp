@@ -0,0 +1,1128 @@
+#include "log_benchmark.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <mutex>
+#include <queue>
+#include <sstream>
+#include <string>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace yalgo {
+namespace examples {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// 与日志器中一条格式化后日志长度相当的测试消息
+const std::string kSampleMessage =
+    "[2026-10-16 12:00:00.000000] [INFO] [log_benchmark.cpp:42:producer] "
+    "benchmark message payload 0123456789";
+
+const size_t kQueueCapacity = 65536;
+
+// 关闭级别基准中参数表达式被求值的次数
+int g_argument_evaluations = 0;
+
+// 代价较高的日志参数：记录求值次数并构造字符串
+std::string expensiveArgument(int i) {
+    ++g_argument_evaluations;
+    return "payload-" + std::to_string(i);
+}
+
+// 复刻AsyncLogger原有的互斥锁队列路径：加锁、判满、入队、notify_one
+class MutexQueueBench {
+public:
+    bool push(std::string&& msg) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.size() >= kQueueCapacity) {
+            return false;
+        }
+        queue_.push(std::move(msg));
+        cv_.notify_one();
+        return true;
+    }
+
+    bool pop(std::string& msg, const std::atomic<bool>& running) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [&]() { return !queue_.empty() || !running; });
+        if (queue_.empty()) {
+            return false;
+        }
+        msg = std::move(queue_.front());
+        queue_.pop();
+        return true;
+    }
+
+    void wakeUp() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cv_.notify_one();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::queue<std::string> queue_;
+};
+
+// 与AsyncLogger LOCKFREE_RING模式相同的入队/唤醒协议
+class RingQueueBench {
+public:
+    RingQueueBench() : ring_(kQueueCapacity), waiting_(false) {}
+
+    bool push(std::string&& msg) {
+        if (!ring_.tryPush(std::move(msg))) {
+            return false;
+        }
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiting_.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cv_.notify_one();
+        }
+        return true;
+    }
+
+    bool pop(std::string& msg, const std::atomic<bool>& running) {
+        if (ring_.tryPop(msg)) {
+            return true;
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        waiting_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        cv_.wait(lock, [&]() { return !ring_.empty() || !running; });
+        waiting_.store(false, std::memory_order_relaxed);
+        return ring_.tryPop(msg);
+    }
+
+    void wakeUp() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cv_.notify_one();
+    }
+
+private:
+    yalgo::log::MpscRingBuffer<std::string> ring_;
+    std::atomic<bool> waiting_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+};
+
+struct QueueBenchResult {
+    double msgs_per_sec;
+    double p50_ns;
+    double p99_ns;
+};
+
+template <typename Queue>
+QueueBenchResult runQueueBench(int producers, size_t total_msgs) {
+    Queue queue;
+    std::atomic<bool> running(true);
+    std::atomic<bool> start(false);
+    size_t per_producer = total_msgs / producers;
+    size_t expected = per_producer * producers;
+
+    std::thread consumer([&]() {
+        std::string msg;
+        size_t consumed = 0;
+        while (consumed < expected && queue.pop(msg, running)) {
+            ++consumed;
+        }
+    });
+
+    std::vector<std::vector<uint32_t>> latencies(producers);
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        latencies[p].reserve(per_producer);
+        threads.emplace_back([&, p]() {
+            while (!start.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (size_t i = 0; i < per_producer; ++i) {
+                std::string msg = kSampleMessage;
+                auto t0 = Clock::now();
+                while (!queue.push(std::move(msg))) {
+                    std::this_thread::yield();
+                }
+                auto t1 = Clock::now();
+                latencies[p].push_back(static_cast<uint32_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()));
+            }
+        });
+    }
+
+    auto begin = Clock::now();
+    start.store(true, std::memory_order_release);
+    for (auto& t : threads) {
+        t.join();
+    }
+    consumer.join();
+    auto end = Clock::now();
+    running = false;
+    queue.wakeUp();
+
+    std::vector<uint32_t> all;
+    all.reserve(expected);
+    for (auto& v : latencies) {
+        all.insert(all.end(), v.begin(), v.end());
+    }
+    std::sort(all.begin(), all.end());
+
+    double seconds = std::chrono::duration<double>(end - begin).count();
+    QueueBenchResult result;
+    result.msgs_per_sec = expected / seconds;
+    result.p50_ns = all[all.size() / 2];
+    result.p99_ns = all[std::min(all.size() - 1, all.size() * 99 / 100)];
+    return result;
+}
+
+void printQueueResult(const char* name, int producers, const QueueBenchResult& r) {
+    std::cout << "  " << std::left << std::setw(14) << name
+              << std::right << std::setw(4) << producers << " 生产者"
+              << std::setw(14) << std::fixed << std::setprecision(0) << r.msgs_per_sec << " msg/s"
+              << "  p50 " << std::setw(8) << r.p50_ns << " ns"
+              << "  p99 " << std::setw(8) << r.p99_ns << " ns" << std::endl;
+}
+
+// 复刻getFormattedTime原有实现：每条日志都做本地时间转换并用ostringstream拼接
+std::string legacyFormattedTime(uint64_t timestamp_us) {
+    time_t time_t_now = static_cast<time_t>(timestamp_us / 1000000);
+    struct tm local_tm;
+#ifdef _WIN32
+    localtime_s(&local_tm, &time_t_now);
+#else
+    localtime_r(&time_t_now, &local_tm);
+#endif
+    char time_buf[32];
+    std::strftime(time_buf, sizeof(time_buf), "%Y-%m-%d %H:%M:%S", &local_tm);
+    std::ostringstream oss;
+    oss << time_buf << "." << std::setw(6) << std::setfill('0') << (timestamp_us % 1000000);
+    return oss.str();
+}
+
+// 复刻LogStream原有实现：正文写入成员std::ostringstream，析构时再用一个std::ostringstream拼接前缀
+class LegacyLogStream {
+public:
+    LegacyLogStream(yalgo::log::LogLevel level, const std::string& level_str,
+                    const char* file, int line, const char* func, const std::string& module = "")
+        : level_(level), level_str_(level_str), file_(file), line_(line), func_(func), module_(module) {}
+
+    ~LegacyLogStream() {
+        std::ostringstream oss;
+        if (!module_.empty()) {
+            oss << "[" << module_ << "] ";
+        }
+        oss << "[" << file_ << ":" << line_ << ":" << func_ << "] " << stream_.str();
+        yalgo::log::AsyncLogger::getInstance().log(level_, level_str_, oss.str());
+    }
+
+    template<typename T>
+    LegacyLogStream& operator<<(const T& value) {
+        stream_ << value;
+        return *this;
+    }
+
+private:
+    yalgo::log::LogLevel level_;
+    std::string level_str_;
+    const char* file_;
+    int line_;
+    const char* func_;
+    std::string module_;
+    std::ostringstream stream_;
+};
+
+// 每条日志耗时约100μs的输出目标
+class SlowBenchSink : public yalgo::log::LogSink {
+public:
+    std::string name() const override { return "slow"; }
+    void write(const yalgo::log::LogSinkMessage&) override {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+};
+
+// 统计正文含指定标记的日志条数及其从产生到写出的最大延迟
+class MarkerCountSink : public yalgo::log::LogSink {
+public:
+    explicit MarkerCountSink(const char* marker) : marker_(marker) {}
+    std::string name() const override { return "marker"; }
+    void write(const yalgo::log::LogSinkMessage& message) override {
+        if (message.text.find(marker_) == std::string_view::npos) {
+            return;
+        }
+        uint64_t now = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        uint64_t delay = now > message.timestamp_us ? now - message.timestamp_us : 0;
+        count_.fetch_add(1, std::memory_order_relaxed);
+        if (delay > max_delay_us_.load(std::memory_order_relaxed)) {
+            max_delay_us_.store(delay, std::memory_order_relaxed);
+        }
+    }
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t maxDelayUs() const { return max_delay_us_.load(std::memory_order_relaxed); }
+
+private:
+    const char* marker_;
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> max_delay_us_{0};
+};
+
+#ifndef _WIN32
+// 填写Unix套接字地址
+sockaddr_un unixAddress(const char* path) {
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+    return addr;
+}
+#endif
+
+} // namespace
+
+// 对比互斥锁队列与无锁环形队列
+void LogBenchmark::benchQueues() {
+    std::cout << "=== 日志队列吞吐量/入队延迟对比 ===" << std::endl;
+
+    const size_t total_msgs = 256000;
+    const int producer_counts[] = {1, 4, 16, 64};
+    for (int producers : producer_counts) {
+        printQueueResult("mutex_queue", producers,
+                         runQueueBench<MutexQueueBench>(producers, total_msgs));
+        printQueueResult("lockfree_ring", producers,
+                         runQueueBench<RingQueueBench>(producers, total_msgs));
+    }
+
+    std::cout << "\n";
+}
+
+// 多个线程同时执行op，返回每次调用的平均耗时（纳秒）
+template <typename Op>
+double runContended(int threads, int iterations, Op op) {
+    std::atomic<bool> start(false);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            while (!start.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (int i = 0; i < iterations; ++i) {
+                op(static_cast<uint64_t>(t * iterations + i));
+            }
+        });
+    }
+    auto begin = Clock::now();
+    start.store(true, std::memory_order_release);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    auto end = Clock::now();
+    return std::chrono::duration<double, std::nano>(end - begin).count() /
+           (static_cast<double>(threads) * iterations);
+}
+
+// 对比统计计数器的争用开销
+void LogBenchmark::benchStatsCounters() {
+    std::cout << "=== 统计计数器与时延直方图耗时 ===" << std::endl;
+
+    const int iterations = 1000000;
+    const int thread_counts[] = {1, 4, 16};
+    for (int threads : thread_counts) {
+        std::atomic<uint64_t> shared(0);
+        yalgo::log::ShardedCounter sharded;
+        yalgo::log::ShardedLatencyHistogram histogram;
+        double shared_ns = runContended(threads, iterations, [&](uint64_t) {
+            shared.fetch_add(1, std::memory_order_relaxed);
+        });
+        double sharded_ns = runContended(threads, iterations, [&](uint64_t) {
+            sharded.add();
+        });
+        double histogram_ns = runContended(threads, iterations, [&](uint64_t i) {
+            histogram.record(100 + (i & 1023));
+        });
+        std::cout << std::fixed << std::setprecision(2)
+                  << "  " << std::setw(2) << threads << " 线程  共享原子计数 " << std::setw(6) << shared_ns
+                  << " ns/次  分片计数 " << std::setw(6) << sharded_ns
+                  << " ns/次  分片直方图 " << std::setw(6) << histogram_ns << " ns/次"
+                  << "  (合计 " << shared.load() << "/" << sharded.load() << "/"
+                  << histogram.summary().count << ")" << std::endl;
+    }
+
+    std::cout << "\n";
+}
+
+// 对比调用线程耗时
+void LogBenchmark::benchCallerCost() {
+    std::cout << "=== 调用线程单条日志耗时 ===" << std::endl;
+
+    yalgo::log::LogConfig config;
+    config.enable_console = false;
+    config.enable_file = false;
+    config.queue_type = yalgo::log::LogQueueType::LOCKFREE_RING;
+    config.ring_capacity = 1 << 20;
+    yalgo::log::AsyncLogger& logger = yalgo::log::AsyncLogger::getInstance();
+    logger.init(config);
+    logger.resetStats();
+
+    const int iterations = 200000;
+    std::string user = "admin";
+    double latency = 1.25;
+
+    auto t0 = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        YLOG_INFO("request %d user %s latency %.3f ms", i, user.c_str(), latency);
+    }
+    auto t1 = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        YLOG_BIN_INFO("request %d user %s latency %.3f ms", i, user, latency);
+    }
+    auto t2 = Clock::now();
+
+    auto perCall = [&](Clock::duration d) {
+        return std::chrono::duration<double, std::nano>(d).count() / iterations;
+    };
+    std::cout << std::fixed << std::setprecision(1)
+              << "  YLOG_INFO       " << std::setw(8) << perCall(t1 - t0) << " ns/条" << std::endl
+              << "  YLOG_BIN_INFO   " << std::setw(8) << perCall(t2 - t1) << " ns/条" << std::endl;
+    yalgo::log::LogLatencyStats enqueue = logger.getStats().enqueue_latency;
+    std::cout << "  submit耗时分布   p50 " << enqueue.p50 << " ns  p99 " << enqueue.p99
+              << " ns  p999 " << enqueue.p999 << " ns  max " << enqueue.max << " ns" << std::endl;
+
+    std::cout << "\n";
+}
+
+// 对比流式日志的调用线程耗时
+void LogBenchmark::benchStreamLogging() {
+    std::cout << "=== 流式日志调用线程耗时 ===" << std::endl;
+
+    // 沿用benchCallerCost初始化的日志器（无输出目标）
+    const int iterations = 200000;
+    std::string user = "admin";
+    double latency = 1.25;
+    auto t0 = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        LegacyLogStream(yalgo::log::LogLevel::INFO, "INFO", __FILE__, __LINE__, __func__)
+            << "request " << i << " user " << user << " latency " << latency << " ms";
+    }
+    auto t1 = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        YLOG_INFO_STREAM << "request " << i << " user " << user << " latency " << latency << " ms";
+    }
+    auto t2 = Clock::now();
+
+    auto perCall = [&](Clock::duration d) {
+        return std::chrono::duration<double, std::nano>(d).count() / iterations;
+    };
+    std::cout << std::fixed << std::setprecision(1)
+              << "  ostringstream(原实现)   " << std::setw(8) << perCall(t1 - t0) << " ns/条" << std::endl
+              << "  YLOG_INFO_STREAM        " << std::setw(8) << perCall(t2 - t1) << " ns/条" << std::endl;
+
+    std::cout << "\n";
+}
+
+// 对比formatLog与{}格式化
+void LogBenchmark::benchFormatEngine() {
+    std::cout << "=== printf风格与{}风格格式化耗时 ===" << std::endl;
+
+    const int iterations = 200000;
+    std::string user = "admin";
+    std::string host = "10.0.0.1";
+    double latency = 1.25;
+
+    // 纯格式化：三种常见消息轮流，{}版本追加到复用的字符串
+    size_t sink = 0;
+    auto t0 = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        std::string a = yalgo::log::formatLog("request %d user %s latency %g ms", i, user.c_str(), latency);
+        std::string b = yalgo::log::formatLog("connect %s:%u failed, retry %d", host.c_str(), 8080u, i & 7);
+        std::string c = yalgo::log::formatLog("cache flushed");
+        sink += a.size() + b.size() + c.size();
+    }
+    auto t1 = Clock::now();
+    std::string text;
+    for (int i = 0; i < iterations; ++i) {
+        text.clear();
+        YLOG_FORMAT_TO(text, "request {} user {} latency {} ms", i, user, latency);
+        YLOG_FORMAT_TO(text, "connect {}:{} failed, retry {}", host, 8080u, i & 7);
+        YLOG_FORMAT_TO(text, "cache flushed");
+        sink += text.size();
+    }
+    auto t2 = Clock::now();
+
+    // 完整日志宏：沿用benchCallerCost初始化的日志器（无输出目标）
+    for (int i = 0; i < iterations; ++i) {
+        YLOG_INFO("request %d user %s latency %g ms", i, user.c_str(), latency);
+    }
+    auto t3 = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        YLOG_INFO_FMT("request {} user {} latency {} ms", i, user, latency);
+    }
+    auto t4 = Clock::now();
+
+    auto perCall = [&](Clock::duration d, int messages) {
+        return std::chrono::duration<double, std::nano>(d).count() / iterations / messages;
+    };
+    std::cout << std::fixed << std::setprecision(1)
+              << "  formatLog          " << std::setw(8) << perCall(t1 - t0, 3) << " ns/条" << std::endl
+              << "  YLOG_FORMAT_TO     " << std::setw(8) << perCall(t2 - t1, 3) << " ns/条" << std::endl
+              << "  YLOG_INFO          " << std::setw(8) << perCall(t3 - t2, 1) << " ns/条" << std::endl
+              << "  YLOG_INFO_FMT      " << std::setw(8) << perCall(t4 - t3, 1) << " ns/条" << std::endl;
+    if (sink == 0) {
+        std::cout << "  (empty)" << std::endl;
+    }
+
+    std::cout << "\n";
+}
+
+// 对比限频宏被抑制时的耗时
+void LogBenchmark::benchRateLimit() {
+    std::cout << "=== 限频/采样宏调用线程耗时 ===" << std::endl;
+
+    // 沿用benchCallerCost初始化的日志器（无输出目标），被抑制的调用不格式化、不入队
+    const int iterations = 200000;
+    auto t0 = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        YLOG_WARN("retry %d", i);
+    }
+    auto t1 = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        YLOG_WARN_EVERY_N(1000, "retry %d", i);
+    }
+    auto t2 = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        YLOG_WARN_EVERY_MS(1000, "retry %d", i);
+    }
+    auto t3 = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        YLOG_WARN_SAMPLED(0.001, "retry %d", i);
+    }
+    auto t4 = Clock::now();
+
+    auto perCall = [&](Clock::duration d) {
+        return std::chrono::duration<double, std::nano>(d).count() / iterations;
+    };
+    std::cout << std::fixed << std::setprecision(1)
+              << "  YLOG_WARN                " << std::setw(8) << perCall(t1 - t0) << " ns/条" << std::endl
+              << "  YLOG_WARN_EVERY_N(1000)  " << std::setw(8) << perCall(t2 - t1) << " ns/条" << std::endl
+              << "  YLOG_WARN_EVERY_MS(1000) " << std::setw(8) << perCall(t3 - t2) << " ns/条" << std::endl
+              << "  YLOG_WARN_SAMPLED(0.001) " << std::setw(8) << perCall(t4 - t3) << " ns/条" << std::endl;
+
+    std::cout << "\n";
+}
+
+// 测量关闭级别的日志宏耗时
+void LogBenchmark::benchDisabledLevel() {
+    std::cout << "=== 运行时关闭级别的日志宏耗时 ===" << std::endl;
+
+    // 沿用benchCallerCost初始化的日志器，运行时级别为INFO，DEBUG被过滤
+    yalgo::log::AsyncLogger& logger = yalgo::log::AsyncLogger::getInstance();
+    logger.setRuntimeLogLevel(yalgo::log::LogLevel::INFO);
+
+    const int iterations = 1000000;
+    g_argument_evaluations = 0;
+    auto t0 = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        // 复刻原有宏：先拼接前缀并格式化参数，再由log()判断级别
+        std::ostringstream oss;
+        oss << "[" << __FILE__ << ":" << __LINE__ << ":" << __func__ << "] "
+            << yalgo::log::formatLog("item %d value %s", i, expensiveArgument(i).c_str());
+        logger.log(yalgo::log::LogLevel::DEBUG, "DEBUG", oss.str());
+    }
+    auto t1 = Clock::now();
+    int legacy_evaluations = g_argument_evaluations;
+    g_argument_evaluations = 0;
+    for (int i = 0; i < iterations; ++i) {
+        YLOG_DEBUG("item %d value %s", i, expensiveArgument(i).c_str());
+    }
+    auto t2 = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        YLOG_DEBUG_STREAM << "item " << i << " value " << expensiveArgument(i);
+    }
+    auto t3 = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        YLOG_BIN_DEBUG("item %d value %s", i, expensiveArgument(i));
+    }
+    auto t4 = Clock::now();
+    // 模块级别过滤：earth设为WARN后其INFO日志被过滤，多一次模块级别表读取
+    logger.setModuleLogLevel("earth", yalgo::log::LogLevel::WARN);
+    for (int i = 0; i < iterations; ++i) {
+        YLOG_MODULE_INFO("earth", "item %d value %s", i, expensiveArgument(i).c_str());
+    }
+    auto t5 = Clock::now();
+    logger.setModuleLogLevel("earth", yalgo::log::LogLevel::INFO);
+
+    auto perCall = [&](Clock::duration d) {
+        return std::chrono::duration<double, std::nano>(d).count() / iterations;
+    };
+    std::cout << std::fixed << std::setprecision(1)
+              << "  原有宏路径(格式化后判断) " << std::setw(8) << perCall(t1 - t0) << " ns/条" << std::endl
+              << "  YLOG_DEBUG               " << std::setw(8) << perCall(t2 - t1) << " ns/条" << std::endl
+              << "  YLOG_DEBUG_STREAM        " << std::setw(8) << perCall(t3 - t2) << " ns/条" << std::endl
+              << "  YLOG_BIN_DEBUG           " << std::setw(8) << perCall(t4 - t3) << " ns/条" << std::endl
+              << "  YLOG_MODULE_INFO(earth)  " << std::setw(8) << perCall(t5 - t4) << " ns/条" << std::endl
+              << "  参数求值次数: 原有路径 " << legacy_evaluations
+              << ", 新宏 " << g_argument_evaluations << std::endl;
+
+    std::cout << "\n";
+}
+
+// 对比关键词过滤耗时
+void LogBenchmark::benchKeywordFilter() {
+    std::cout << "=== 关键词过滤耗时（排除词均未命中，需扫描全文） ===" << std::endl;
+
+    const int iterations = 200000;
+    std::vector<std::string> messages;
+    for (int i = 0; i < 64; ++i) {
+        messages.push_back("[order_service.cpp:" + std::to_string(100 + i) +
+                           ":handleRequest] order " + std::to_string(i * 7919) +
+                           " created for user_" + std::to_string(i) + ", amount 42.50, latency 1.25 ms");
+    }
+
+    std::cout << "  关键词数    逐个find(ns/条)    自动机(ns/条)" << std::endl;
+    for (size_t count : {1, 10, 100, 500}) {
+        std::vector<std::string> keywords;
+        for (size_t i = 0; i < count; ++i) {
+            keywords.push_back("blocked_" + std::to_string(i * 31 + 7));
+        }
+        yalgo::log::KeywordFilter filter({}, keywords);
+
+        size_t kept = 0;
+        auto t0 = Clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            const std::string& msg = messages[i & 63];
+            bool hit = false;
+            for (const std::string& keyword : keywords) {
+                if (msg.find(keyword) != std::string::npos) {
+                    hit = true;
+                    break;
+                }
+            }
+            kept += hit ? 0 : 1;
+        }
+        auto t1 = Clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            const std::string& msg = messages[i & 63];
+            kept += filter.accept(msg.data(), msg.size()) ? 1 : 0;
+        }
+        auto t2 = Clock::now();
+
+        auto perCall = [&](Clock::duration d) {
+            return std::chrono::duration<double, std::nano>(d).count() / iterations;
+        };
+        std::cout << std::fixed << std::setprecision(1)
+                  << "  " << std::setw(8) << count
+                  << std::setw(18) << perCall(t1 - t0)
+                  << std::setw(17) << perCall(t2 - t1)
+                  << (kept == 2 * static_cast<size_t>(iterations) ? "" : "  (结果不一致)") << std::endl;
+    }
+
+    std::cout << "\n";
+}
+
+// 对比时间戳格式化耗时
+void LogBenchmark::benchTimestampFormat() {
+    std::cout << "=== 时间戳格式化耗时 ===" << std::endl;
+
+    // 模拟每秒约10万条日志的时间戳序列
+    const int iterations = 1000000;
+    const uint64_t base_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    size_t checksum = 0;
+
+    auto t0 = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        checksum += legacyFormattedTime(base_us + i * 10).size();
+    }
+    auto t1 = Clock::now();
+    char time_buf[yalgo::log::AsyncLogger::TIME_BUFFER_SIZE];
+    for (int i = 0; i < iterations; ++i) {
+        checksum += yalgo::log::AsyncLogger::formatTimestamp(base_us + i * 10, time_buf);
+    }
+    auto t2 = Clock::now();
+
+    auto perCall = [&](Clock::duration d) {
+        return std::chrono::duration<double, std::nano>(d).count() / iterations;
+    };
+    std::cout << std::fixed << std::setprecision(1)
+              << "  strftime+ostringstream " << std::setw(8) << perCall(t1 - t0) << " ns/次" << std::endl
+              << "  formatTimestamp        " << std::setw(8) << perCall(t2 - t1) << " ns/次" << std::endl
+              << "  (checksum " << checksum << ")" << std::endl;
+
+    std::cout << "\n";
+}
+
+// 对比结构化日志编码耗时
+void LogBenchmark::benchStructuredEncode() {
+    std::cout << "=== 结构化日志编码耗时 ===" << std::endl;
+
+    // 同样4个字段分别构造为printf风格的二进制调用点与结构化调用点
+    static const yalgo::log::BinaryArgType types[] = {
+        yalgo::log::BinaryArgType::STRING, yalgo::log::BinaryArgType::INT32,
+        yalgo::log::BinaryArgType::DOUBLE, yalgo::log::BinaryArgType::BOOL};
+    static const char* const keys[] = {"user", "id", "lat", "ok"};
+    yalgo::log::BinaryLogSite text_site;
+    text_site.file = "log_benchmark.cpp";
+    text_site.line = 42;
+    text_site.func = "producer";
+    text_site.format = "request done user=%s id=%d lat=%g ok=%d";
+    text_site.arg_types = types;
+    text_site.arg_count = 4;
+    yalgo::log::BinaryLogSite kv_site = text_site;
+    kv_site.format = "request done";
+    kv_site.keys = keys;
+
+    std::string args(4 + 5 + 4 + 8 + 1, '\0');
+    char* cursor = &args[0];
+    yalgo::log::detail::encodeBinaryArg(cursor, "admin");
+    yalgo::log::detail::encodeBinaryArg(cursor, 12345);
+    yalgo::log::detail::encodeBinaryArg(cursor, 1.2345678901234567);
+    yalgo::log::detail::encodeBinaryArg(cursor, true);
+
+    const int iterations = 500000;
+    const uint64_t base_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    std::string out;
+    size_t checksum = 0;
+    auto run = [&](auto&& encode) {
+        auto begin = Clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            out.clear();
+            encode(base_us + i * 10);
+            checksum += out.size();
+        }
+        return std::chrono::duration<double, std::nano>(Clock::now() - begin).count() / iterations;
+    };
+    double text_ns = run([&](uint64_t ts) {
+        char time_buf[yalgo::log::AsyncLogger::TIME_BUFFER_SIZE];
+        out += '[';
+        out.append(time_buf, yalgo::log::AsyncLogger::formatTimestamp(ts, time_buf));
+        out += "] [INFO] ";
+        yalgo::log::formatBinaryRecord(text_site, args.data(), args.size(), out);
+    });
+    double json_ns = run([&](uint64_t ts) {
+        yalgo::log::encodeStructuredRecord(yalgo::log::LogKvFormat::JSON, ts, yalgo::log::LogLevel::INFO,
+                                           kv_site, args.data(), args.size(), out);
+    });
+    double logfmt_ns = run([&](uint64_t ts) {
+        yalgo::log::encodeStructuredRecord(yalgo::log::LogKvFormat::LOGFMT, ts, yalgo::log::LogLevel::INFO,
+                                           kv_site, args.data(), args.size(), out);
+    });
+
+    // 浮点数：%.17g可还原但冗长，to_chars给出可还原的最短表示
+    double value = 0.1;
+    auto t0 = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        char buf[32];
+        checksum += std::snprintf(buf, sizeof(buf), "%.17g", value + i);
+    }
+    auto t1 = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        char buf[32];
+        checksum += std::to_chars(buf, buf + sizeof(buf), value + i).ptr - buf;
+    }
+    auto t2 = Clock::now();
+    auto perCall = [&](Clock::duration d) {
+        return std::chrono::duration<double, std::nano>(d).count() / iterations;
+    };
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "  printf文本正文       " << std::setw(8) << text_ns << " ns/条" << std::endl
+              << "  JSON                 " << std::setw(8) << json_ns << " ns/条" << std::endl
+              << "  logfmt               " << std::setw(8) << logfmt_ns << " ns/条" << std::endl
+              << "  snprintf(\"%.17g\")    " << std::setw(8) << perCall(t1 - t0) << " ns/次" << std::endl
+              << "  to_chars最短表示     " << std::setw(8) << perCall(t2 - t1) << " ns/次" << std::endl
+              << "  (checksum " << checksum << ")" << std::endl;
+
+    std::cout << "\n";
+}
+
+// 对比文件写入方式
+void LogBenchmark::benchFileSink() {
+    std::cout << "=== 文件写入吞吐量 ===" << std::endl;
+
+    const int lines = 1000000;
+    const char* path = "log_benchmark_sink.tmp";
+
+    // flush_bytes为0时每行一次写系统调用，与原先的逐行flush等价
+    auto run = [&](const char* name, yalgo::log::FileSink& sink, size_t flush_bytes) {
+        std::remove(path);
+        if (!sink.open(path)) {
+            std::cout << "  无法创建临时文件: " << path << std::endl;
+            return;
+        }
+        auto begin = Clock::now();
+        for (int i = 0; i < lines; ++i) {
+            sink.appendLine(kSampleMessage);
+            if (sink.pendingBytes() >= flush_bytes) {
+                sink.flush();
+            }
+        }
+        sink.flush();
+        auto end = Clock::now();
+        sink.close();
+        double seconds = std::chrono::duration<double>(end - begin).count();
+        std::cout << "  " << std::left << std::setw(20) << name << std::right
+                  << std::setw(12) << std::fixed << std::setprecision(0) << lines / seconds
+                  << " 行/s" << std::endl;
+    };
+
+    yalgo::log::BufferedFileSink per_line;
+    run("per_line_flush", per_line, 0);
+    yalgo::log::BufferedFileSink group_64k;
+    run("group_commit_64KB", group_64k, 64 * 1024);
+    yalgo::log::BufferedFileSink group_1m;
+    run("group_commit_1MB", group_1m, 1024 * 1024);
+    yalgo::log::MmapFileSink mapped;
+    run("mmap", mapped, 0);
+    std::remove(path);
+
+    std::cout << "\n";
+}
+
+// 测量写入线程的单条处理耗时
+void LogBenchmark::benchConsumerThroughput() {
+    std::cout << "=== 写入线程吞吐量 ===" << std::endl;
+
+#ifndef _WIN32
+    // 沿用benchCallerCost初始化的日志器，临时打开文件输出
+    const char* path = "log_benchmark_consumer.tmp";
+    const uint64_t logs = 200000;
+    const uint64_t chunk = 10000;
+    yalgo::log::AsyncLogger& logger = yalgo::log::AsyncLogger::getInstance();
+    yalgo::log::LogConfig config;
+    config.enable_console = false;
+    config.log_file = path;
+    config.rotate_by_day = false;
+    logger.updateConfig(config);
+
+    // 进程CPU时间减去调用线程CPU时间，即写入线程（及空闲的其他线程）的耗时
+    auto cpuNanos = [](clockid_t clock) {
+        timespec ts;
+        clock_gettime(clock, &ts);
+        return static_cast<double>(ts.tv_sec) * 1e9 + static_cast<double>(ts.tv_nsec);
+    };
+    auto run = [&](const char* name, bool binary) {
+        std::remove(path);
+        logger.resetStats();
+        std::string user = "admin";
+        double latency = 1.25;
+        auto begin = Clock::now();
+        double process_begin = cpuNanos(CLOCK_PROCESS_CPUTIME_ID);
+        double caller_begin = cpuNanos(CLOCK_THREAD_CPUTIME_ID);
+        // 分段提交并等待写完，队列不会因积压而丢弃日志
+        for (uint64_t written = 0; written < logs; written += chunk) {
+            for (uint64_t i = 0; i < chunk; ++i) {
+                if (binary) {
+                    YLOG_BIN_INFO("request %d user %s latency %.3f ms", static_cast<int>(i), user, latency);
+                } else {
+                    YLOG_INFO("request %d user %s latency %.3f ms", static_cast<int>(i), user.c_str(), latency);
+                }
+            }
+            while (logger.getStats().sinks[0].messages < written + chunk) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        }
+        double caller_ns = cpuNanos(CLOCK_THREAD_CPUTIME_ID) - caller_begin;
+        double writer_ns = cpuNanos(CLOCK_PROCESS_CPUTIME_ID) - process_begin - caller_ns;
+        auto end = Clock::now();
+        double seconds = std::chrono::duration<double>(end - begin).count();
+        std::cout << "  " << std::left << std::setw(16) << name << std::right << std::fixed
+                  << std::setprecision(1) << "写入线程 " << std::setw(7) << writer_ns / logs << " ns/条 ("
+                  << std::setprecision(0) << std::setw(9) << 1e9 * logs / writer_ns << " 条/s)  端到端 "
+                  << std::setw(9) << logs / seconds << " 条/s  丢弃 " << logger.getStats().dropped_logs
+                  << std::endl;
+    };
+    // 调用线程临时改为SCHED_FIFO：核数少时写入线程不会每来一条就被唤醒抢占，
+    // 而是在每段提交完后一次写完，测到的是逐条写出的耗时（无权限时保持原调度策略）
+    int old_policy = SCHED_OTHER;
+    sched_param old_param;
+    pthread_getschedparam(pthread_self(), &old_policy, &old_param);
+    sched_param fifo_param;
+    fifo_param.sched_priority = 1;
+    bool fifo = pthread_setschedparam(pthread_self(), SCHED_FIFO, &fifo_param) == 0;
+    std::cout << "  调用线程调度策略: " << (fifo ? "SCHED_FIFO" : "默认（无权限设置SCHED_FIFO）") << std::endl;
+    run("YLOG_INFO", false);
+    run("YLOG_BIN_INFO", true);
+    if (fifo) {
+        pthread_setschedparam(pthread_self(), old_policy, &old_param);
+    }
+
+    config.enable_file = false;
+    logger.updateConfig(config);
+    std::remove(path);
+#else
+    std::cout << "  需要POSIX线程CPU时钟，已跳过" << std::endl;
+#endif
+
+    std::cout << "\n";
+}
+
+// 对比慢速输出目标的两种接入方式
+void LogBenchmark::benchSlowSink() {
+    std::cout << "=== 慢速输出目标对主日志文件的影响 ===" << std::endl;
+
+    // 沿用benchCallerCost初始化的日志器，临时打开文件输出
+    const char* path = "log_benchmark_slow_sink.tmp";
+    const uint64_t logs = 2000;
+    yalgo::log::AsyncLogger& logger = yalgo::log::AsyncLogger::getInstance();
+    yalgo::log::LogConfig config;
+    config.enable_console = false;
+    config.log_file = path;
+    config.rotate_by_day = false;
+    config.sink_queue_capacity = 1024;
+    logger.updateConfig(config);
+
+    auto run = [&](const char* name, bool dedicated_thread) {
+        auto sink = std::make_shared<SlowBenchSink>();
+        logger.addSink(sink, dedicated_thread);
+        logger.resetStats();
+        auto begin = Clock::now();
+        for (uint64_t i = 0; i < logs; ++i) {
+            YLOG_INFO("slow sink message %llu", static_cast<unsigned long long>(i));
+        }
+        // 等待主日志文件写完全部日志
+        while (logger.getStats().sinks[0].messages < logs) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        auto end = Clock::now();
+        yalgo::log::LogStats stats = logger.getStats();
+        logger.removeSink(sink);
+        double ms = std::chrono::duration<double, std::milli>(end - begin).count();
+        std::cout << "  " << std::left << std::setw(18) << name << std::right
+                  << "文件写完 " << std::setw(8) << std::fixed << std::setprecision(1) << ms << " ms"
+                  << "  慢速目标已写出 " << std::setw(5) << stats.sinks.back().messages
+                  << " 条, 丢弃 " << std::setw(5) << stats.sinks.back().dropped << " 条" << std::endl;
+    };
+    run("inline", false);
+    run("dedicated_thread", true);
+
+    config.enable_file = false;
+    config.sink_queue_capacity = yalgo::log::LogConfig().sink_queue_capacity;
+    logger.updateConfig(config);
+    std::remove(path);
+
+    std::cout << "\n";
+}
+
+// 对比审计日志与高频遥测日志共用一个日志器和各用一个命名日志器
+void LogBenchmark::benchLoggerIsolation() {
+    std::cout << "=== 命名日志器隔离高频通道 ===" << std::endl;
+
+    // 遥测日志器输出到慢速目标（约100μs/条），队列容量只有64KB，积压后按默认规则丢弃信息日志
+    yalgo::log::LogConfig config;
+    config.enable_console = false;
+    config.enable_file = false;
+    config.queue_capacity_bytes = 64 * 1024;
+    const int telemetry_logs = 20000;
+    const int audit_every = 100;
+
+    auto run = [&](const char* name, bool separate) {
+        auto telemetry = yalgo::log::AsyncLogger::createLogger("bench_telemetry", config);
+        auto audit = separate ? yalgo::log::AsyncLogger::createLogger("bench_audit", config) : telemetry;
+        auto audit_sink = std::make_shared<MarkerCountSink>("audit ");
+        telemetry->addSink(std::make_shared<SlowBenchSink>(), false);
+        audit->addSink(audit_sink, false);
+
+        for (int i = 0; i < telemetry_logs; ++i) {
+            YLOG_LOGGER_INFO_FMT(*telemetry, "telemetry sample {} value {}", i, i * 0.5);
+            if (i % audit_every == 0) {
+                YLOG_LOGGER_INFO_FMT(*audit, "audit user {} action {}", i, "login");
+            }
+        }
+        uint64_t telemetry_dropped = telemetry->getStats().dropped_logs;
+        // 注销后最后一个引用释放时写完队列
+        telemetry.reset();
+        audit.reset();
+        yalgo::log::AsyncLogger::dropLogger("bench_telemetry");
+        yalgo::log::AsyncLogger::dropLogger("bench_audit");
+
+        std::cout << "  " << std::left << std::setw(16) << name << std::right
+                  << "审计日志写出 " << std::setw(3) << audit_sink->count() << "/" << telemetry_logs / audit_every
+                  << " 条, 最大延迟 " << std::setw(8) << std::fixed << std::setprecision(1)
+                  << audit_sink->maxDelayUs() / 1000.0 << " ms"
+                  << "  遥测丢弃 " << std::setw(5) << telemetry_dropped << " 条" << std::endl;
+    };
+    run("shared_logger", false);
+    run("named_loggers", true);
+
+    std::cout << "\n";
+}
+
+// 对比写入线程等待方式
+void LogBenchmark::benchWaitStrategy() {
+    std::cout << "=== 写入线程等待方式 ===" << std::endl;
+    if (std::thread::hardware_concurrency() < 2) {
+        // 单核上自旋会与生产者争抢同一个CPU，结果没有参考价值
+        std::cout << "  需要至少2个CPU，跳过\n" << std::endl;
+        return;
+    }
+
+    // 每条日志之间间隔约20μs，写入线程每次都会把队列取空后进入等待
+    yalgo::log::LogConfig config;
+    config.enable_console = false;
+    config.enable_file = false;
+    config.queue_type = yalgo::log::LogQueueType::LOCKFREE_RING;
+    const int messages = 20000;
+    const auto gap = std::chrono::microseconds(20);
+
+    auto run = [&](const char* name, yalgo::log::LogWaitStrategy strategy) {
+        config.wait_strategy = strategy;
+        auto logger = yalgo::log::AsyncLogger::createLogger("bench_wait", config);
+        for (int i = 0; i < messages; ++i) {
+            YLOG_LOGGER_INFO_FMT(*logger, "sparse sample {}", i);
+            auto until = Clock::now() + gap;
+            while (Clock::now() < until) {
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        yalgo::log::LogStats stats = logger->getStats();
+        logger.reset();
+        yalgo::log::AsyncLogger::dropLogger("bench_wait");
+
+        std::cout << "  " << std::left << std::setw(16) << name << std::right
+                  << "排队等待 p50/p99 " << std::setw(4) << stats.low_lane.wait_us.p50 << "/"
+                  << std::setw(4) << stats.low_lane.wait_us.p99 << " μs"
+                  << "  提交 p50 " << std::setw(5) << stats.enqueue_latency.p50 << " ns"
+                  << "  自旋命中 " << std::setw(5) << stats.writer_spin_hits
+                  << "  阻塞 " << std::setw(5) << stats.writer_blocks << std::endl;
+    };
+    run("block", yalgo::log::LogWaitStrategy::BLOCK);
+    run("spin_then_block", yalgo::log::LogWaitStrategy::SPIN_THEN_BLOCK);
+
+    std::cout << "\n";
+}
+
+// 对比系统日志发送方式
+void LogBenchmark::benchSyslogSink() {
+    std::cout << "=== 系统日志发送吞吐量 ===" << std::endl;
+#ifndef _WIN32
+    const char* path = "log_benchmark_syslog.sock";
+    const int messages = 50000;
+    const int batch = 256; // 与独立线程每批取出的条数相当
+    unlink(path);
+    sockaddr_un addr = unixAddress(path);
+    int listener = socket(AF_UNIX, SOCK_DGRAM, 0);
+    if (listener < 0 || bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        std::cout << "  无法创建本地syslog套接字: " << path << std::endl;
+        return;
+    }
+    struct timeval timeout = {0, 100 * 1000};
+    setsockopt(listener, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    // 代替syslogd的接收线程
+    std::atomic<bool> running(true);
+    std::atomic<uint64_t> received(0);
+    std::thread receiver([&]() {
+        char buf[1024];
+        while (running.load(std::memory_order_relaxed)) {
+            if (recv(listener, buf, sizeof(buf), 0) > 0) {
+                received.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    auto report = [&](const char* name, Clock::duration elapsed) {
+        double seconds = std::chrono::duration<double>(elapsed).count();
+        std::cout << "  " << std::left << std::setw(28) << name << std::right
+                  << std::setw(12) << std::fixed << std::setprecision(0) << messages / seconds
+                  << " 条/s" << std::endl;
+    };
+
+    // 原实现：每条日志openlog/syslog/closelog，即建立连接、发送、关闭
+    std::string datagram = "<14>Oct 16 12:00:00 yalgo[1]: " + kSampleMessage;
+    auto t0 = Clock::now();
+    for (int i = 0; i < messages; ++i) {
+        int fd = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (fd >= 0) {
+            if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) {
+                send(fd, datagram.data(), datagram.size(), MSG_NOSIGNAL);
+            }
+            close(fd);
+        }
+    }
+    auto t1 = Clock::now();
+    report("open/send/close per message", t1 - t0);
+
+    // SyslogSink：长连接，每批一次sendmmsg
+    {
+        yalgo::log::SyslogSink sink("yalgo", path);
+        yalgo::log::LogSinkMessage message;
+        message.level = yalgo::log::LogLevel::INFO;
+        message.timestamp_us = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        message.text = kSampleMessage;
+        auto t2 = Clock::now();
+        for (int i = 0; i < messages; ++i) {
+            sink.write(message);
+            if ((i + 1) % batch == 0) {
+                sink.flush();
+            }
+        }
+        sink.flush();
+        auto t3 = Clock::now();
+        report("SyslogSink sendmmsg", t3 - t2);
+        std::cout << "  (发送失败 " << sink.sendFailures() << " 条)" << std::endl;
+    }
+
+    running = false;
+    receiver.join();
+    close(listener);
+    unlink(path);
+    std::cout << "  接收方共收到 " << received.load() << " 条" << std::endl;
+#else
+    std::cout << "  本测试仅支持Linux" << std::endl;
+#endif
+
+    std::cout << "\n";
+}
+
+// 运行所有性能测试
+void LogBenchmark::runAllBenchmarks() {
+    std::cout << "====================================================" << std::endl;
+    std::cout << "            yAlgo 日志SDK 性能测试                " << std::endl;
+    std::cout << "====================================================" << std::endl;
+
+    benchQueues();
+    benchStatsCounters();
+    benchCallerCost();
+    benchStreamLogging();
+    benchFormatEngine();
+    benchRateLimit();
+    benchDisabledLevel();
+    benchKeywordFilter();
+    benchTimestampFormat();
+    benchStructuredEncode();
+    benchFileSink();
+    benchConsumerThroughput();
+    benchSlowSink();
+    benchLoggerIsolation();
+    benchWaitStrategy();
+    benchSyslogSink();
+
+    std::cout << "====================================================" << std::endl;
+    std::cout << "                 日志模块性能测试结束                      " << std::endl;
+    std::cout << "====================================================" << std::endl;
+}
+
+} // namespace examples
+} // namespace yalgo
+
+// 日志模块性能测试程序的入口点
+int main() {
+    yalgo::examples::LogBenchmark::runAllBenchmarks();
+    return 0;
+}
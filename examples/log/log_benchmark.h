@@ -0,0 +1,110 @@
+#ifndef YALGO_EXAMPLES_LOG_LOG_BENCHMARK_H
+#define YALGO_EXAMPLES_LOG_LOG_BENCHMARK_H
+
+#include "../../sdk/log/logger.h"
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <chrono>
+
+namespace yalgo {
+namespace examples {
+
+/**
+ * 日志模块性能测试类
+ * 封装日志内部组件的吞吐量与延迟基准测试
+ */
+class LogBenchmark {
+public:
+    /**
+     * 对比互斥锁队列与无锁环形队列的吞吐量和p99入队延迟
+     * 生产者线程数依次为1、4、16、64
+     */
+    static void benchQueues();
+
+    /**
+     * 对比多线程累加同一个原子计数器与按线程分片计数器、记录时延直方图的耗时
+     * 线程数依次为1、4、16
+     */
+    static void benchStatsCounters();
+
+    /**
+     * 对比文本日志宏与二进制延迟格式化日志宏在调用线程上的耗时
+     */
+    static void benchCallerCost();
+
+    /**
+     * 对比原有基于std::ostringstream的流式日志与线程本地复用缓冲的YLOG_INFO_STREAM在调用线程上的耗时
+     */
+    static void benchStreamLogging();
+
+    /**
+     * 对比printf风格formatLog与编译期检查的{}格式化：纯格式化耗时与YLOG_INFO / YLOG_INFO_FMT调用线程耗时
+     */
+    static void benchFormatEngine();
+
+    /**
+     * 对比普通日志宏与限频/采样宏在被抑制时的调用线程耗时
+     */
+    static void benchRateLimit();
+
+    /**
+     * 测量运行时关闭级别的日志宏耗时，并与先格式化再判断级别的原有宏路径对比
+     */
+    static void benchDisabledLevel();
+
+    /**
+     * 对比逐个关键词std::string::find与Aho-Corasick自动机的过滤耗时，关键词数依次为1、10、100、500
+     */
+    static void benchKeywordFilter();
+
+    /**
+     * 对比逐条localtime_r/strftime/ostringstream与按秒缓存的时间戳格式化耗时
+     */
+    static void benchTimestampFormat();
+
+    /**
+     * 对比printf风格文本正文与结构化日志JSON/logfmt编码的耗时，以及浮点数snprintf("%.17g")与to_chars最短表示
+     */
+    static void benchStructuredEncode();
+
+    /**
+     * 对比逐行写出、批量提交（writev）与内存映射三种文件写入方式的吞吐量
+     */
+    static void benchFileSink();
+
+    /**
+     * 测量写入线程把文本日志、二进制延迟格式化日志写入主日志文件的单条CPU耗时与吞吐量
+     */
+    static void benchConsumerThroughput();
+
+    /**
+     * 对比慢速输出目标在写入线程上直接调用与使用独立线程时，主日志文件写完一批日志的耗时
+     */
+    static void benchSlowSink();
+
+    /**
+     * 对比审计日志与高频遥测日志共用一个日志器和各用一个命名日志器时审计日志的丢弃与延迟
+     */
+    static void benchLoggerIsolation();
+
+    /**
+     * 对比写入线程阻塞等待与先自旋再阻塞时，稀疏日志的排队等待分布与生产者提交耗时（需至少2个CPU）
+     */
+    static void benchWaitStrategy();
+
+    /**
+     * 对比每条日志重新建立syslog连接与SyslogSink长连接+sendmmsg批量发送的吞吐量（本地Unix套接字代替syslogd）
+     */
+    static void benchSyslogSink();
+
+    /**
+     * 运行所有性能测试
+     */
+    static void runAllBenchmarks();
+};
+
+} // namespace examples
+} // namespace yalgo
+
+#endif // YALGO_EXAMPLES_LOG_LOG_BENCHMARK_H
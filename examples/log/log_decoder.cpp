@@ -0,0 +1,415 @@
+/**
+ * @file log_decoder.cpp
+ * @brief 二进制日志离线解码工具
+ * @author yAlgo Team
+ * @date 2026-10-16
+ * @version 1.0.0
+ *
+ * 将LogFileFormat::BINARY格式的日志文件解码为文本布局：
+ * [time] [LEVEL] [module] [file:line:func] msg
+ * 也可直接读取后台压缩的历史文件（.ylz，文本或二进制内容），文本内容按时间索引跳过无关的块。
+ *
+ * 用法：log_decoder [选项] 文件...
+ *   --level LEVEL      只输出不低于该严重程度的日志（ERROR/WARN/INFO/DEBUG）
+ *   --module NAME      只输出指定模块的日志（可重复）
+ *   --from TIME        起始时间（"YYYY-mm-dd HH:MM:SS" 或 "YYYY-mm-dd"，本地时间）
+ *   --to TIME          截止时间（不含）
+ *   --kv FORMAT        结构化日志（YLOG_*_KV）整行输出为json或logfmt（默认按文本布局输出）
+ *   -o FILE            输出到文件（默认标准输出）
+ */
+
+#include "../../sdk/log/logger.h"
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+using yalgo::log::BinaryLogDecoder;
+using yalgo::log::BinaryLogEntry;
+using yalgo::log::CompressedSegmentReader;
+using yalgo::log::LogLevel;
+using yalgo::log::SegmentContentType;
+
+// 解码过滤条件与输出选项
+struct DecodeFilter {
+    LogLevel max_level = LogLevel::DEBUG;
+    std::vector<std::string> modules;
+    uint64_t from_us = 0;
+    uint64_t to_us = std::numeric_limits<uint64_t>::max();
+    bool kv_encode = false;
+    yalgo::log::LogKvFormat kv_format = yalgo::log::LogKvFormat::JSON;
+};
+
+// 只读内存映射文件
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (data_) UnmapViewOfFile(data_);
+        if (mapping_) CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+#else
+        if (data_) munmap(const_cast<char*>(data_), size_);
+        if (fd_ >= 0) close(fd_);
+#endif
+    }
+
+    bool open(const std::string& path) {
+#ifdef _WIN32
+        file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                            NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        if (file_ == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file_, &size)) return false;
+        size_ = static_cast<size_t>(size.QuadPart);
+        if (size_ == 0) return true;
+        mapping_ = CreateFileMappingA(file_, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (!mapping_) return false;
+        data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        return data_ != nullptr;
+#else
+        fd_ = ::open(path.c_str(), O_RDONLY);
+        if (fd_ < 0) return false;
+        struct stat st;
+        if (fstat(fd_, &st) != 0) return false;
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ == 0) return true;
+        void* addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (addr == MAP_FAILED) return false;
+        data_ = static_cast<const char*>(addr);
+        madvise(addr, size_, MADV_SEQUENTIAL);
+        return true;
+#endif
+    }
+
+    // 告知内核已处理完的区域可以回收，扫描超大文件时保持常驻内存有界
+    void release(size_t begin, size_t end) {
+#ifndef _WIN32
+        const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        begin = begin / page * page;
+        end = end / page * page;
+        if (data_ && end > begin) {
+            madvise(const_cast<char*>(data_) + begin, end - begin, MADV_DONTNEED);
+        }
+#else
+        (void)begin;
+        (void)end;
+#endif
+    }
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = NULL;
+#else
+    int fd_ = -1;
+#endif
+};
+
+bool parseLevel(const std::string& value, LogLevel& level) {
+    if (value == "ERROR") level = LogLevel::LOG_ERROR;
+    else if (value == "WARN") level = LogLevel::WARN;
+    else if (value == "INFO") level = LogLevel::INFO;
+    else if (value == "DEBUG") level = LogLevel::DEBUG;
+    else return false;
+    return true;
+}
+
+// 解析本地时间 "YYYY-mm-dd HH:MM:SS" 或 "YYYY-mm-dd"
+bool parseTime(const std::string& value, uint64_t& timestamp_us) {
+    struct tm local_tm;
+    std::memset(&local_tm, 0, sizeof(local_tm));
+    int fields = sscanf(value.c_str(), "%d-%d-%d %d:%d:%d",
+                        &local_tm.tm_year, &local_tm.tm_mon, &local_tm.tm_mday,
+                        &local_tm.tm_hour, &local_tm.tm_min, &local_tm.tm_sec);
+    if (fields != 3 && fields != 6) {
+        return false;
+    }
+    local_tm.tm_year -= 1900;
+    local_tm.tm_mon -= 1;
+    local_tm.tm_isdst = -1;
+    time_t seconds = mktime(&local_tm);
+    if (seconds == static_cast<time_t>(-1)) {
+        return false;
+    }
+    timestamp_us = static_cast<uint64_t>(seconds) * 1000000;
+    return true;
+}
+
+bool matches(const DecodeFilter& filter, const BinaryLogEntry& entry) {
+    if (entry.level > filter.max_level || entry.timestamp_us < filter.from_us ||
+        entry.timestamp_us >= filter.to_us) {
+        return false;
+    }
+    if (filter.modules.empty()) {
+        return true;
+    }
+    std::string_view module = BinaryLogDecoder::entryModule(entry);
+    for (const std::string& wanted : filter.modules) {
+        if (module == wanted) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// 输出一条日志：结构化日志按--kv选项整行编码，其余按文本布局
+void formatEntry(const DecodeFilter& filter, const BinaryLogEntry& entry, std::string& out) {
+    if (filter.kv_encode && entry.site && entry.site->keys) {
+        yalgo::log::encodeStructuredRecord(filter.kv_format, entry.timestamp_us, entry.level,
+                                           *entry.site, entry.data, entry.size, out);
+    } else {
+        BinaryLogDecoder::formatEntry(entry, out);
+    }
+}
+
+// 把文本日志行解析为条目，以便复用过滤条件："[time] [LEVEL] 正文"
+bool parseTextLine(const char* line, size_t size, BinaryLogEntry& entry) {
+    uint64_t timestamp = 0;
+    if (!yalgo::log::parseTextLogTimestamp(line, size, timestamp) || size < 31 ||
+        line[28] != ' ' || line[29] != '[') {
+        return false;
+    }
+    const char* level_end = static_cast<const char*>(std::memchr(line + 30, ']', size - 30));
+    if (!level_end || !parseLevel(std::string(line + 30, level_end), entry.level)) {
+        return false;
+    }
+    const char* body = level_end + 1;
+    const char* end = line + size;
+    if (body < end && *body == ' ') {
+        ++body;
+    }
+    entry.timestamp_us = timestamp;
+    entry.site = nullptr;
+    entry.data = body;
+    entry.size = static_cast<size_t>(end - body);
+    return true;
+}
+
+// 解码压缩的历史文件
+bool decodeCompressedFile(const std::string& path, const DecodeFilter& filter, FILE* out) {
+    CompressedSegmentReader reader;
+    if (!reader.open(path)) {
+        std::cerr << "log_decoder: 压缩文件索引损坏: " << path << std::endl;
+        return false;
+    }
+
+    std::string block;
+    std::string text;
+    BinaryLogEntry entry;
+
+    if (reader.contentType() == SegmentContentType::TEXT) {
+        // 文本内容：按索引定位起始块，块首时间超过截止时间即可停止
+        bool keep = false;
+        for (size_t i = reader.findBlock(filter.from_us); i < reader.blockCount(); ++i) {
+            if (reader.block(i).first_timestamp_us >= filter.to_us) {
+                break;
+            }
+            if (!reader.readBlock(i, block)) {
+                std::cerr << "log_decoder: " << path << " 第 " << i << " 块解压失败" << std::endl;
+                return false;
+            }
+            size_t pos = 0;
+            while (pos < block.size()) {
+                size_t end = block.find('\n', pos);
+                size_t line_end = (end == std::string::npos) ? block.size() : end;
+                // 没有时间前缀的续行跟随上一行的过滤结果
+                if (parseTextLine(block.data() + pos, line_end - pos, entry)) {
+                    keep = matches(filter, entry);
+                }
+                if (keep) {
+                    text.append(block, pos, line_end - pos);
+                    text += '\n';
+                }
+                pos = line_end + 1;
+            }
+            fwrite(text.data(), 1, text.size(), out);
+            text.clear();
+        }
+        return true;
+    }
+
+    // 二进制内容：格式串定义可能在更早的块中，需要从头顺序解码
+    BinaryLogDecoder decoder;
+    std::string data;
+    size_t offset = 0;
+    for (size_t i = 0; i < reader.blockCount(); ++i) {
+        if (!reader.readBlock(i, block)) {
+            std::cerr << "log_decoder: " << path << " 第 " << i << " 块解压失败" << std::endl;
+            return false;
+        }
+        data.erase(0, offset);
+        data += block;
+        offset = 0;
+        if (i == 0 && !BinaryLogDecoder::checkHeader(data.data(), data.size(), offset)) {
+            std::cerr << "log_decoder: 不是二进制日志文件: " << path << std::endl;
+            return false;
+        }
+        while (decoder.next(data.data(), data.size(), offset, entry)) {
+            if (matches(filter, entry)) {
+                formatEntry(filter, entry, text);
+                text += '\n';
+            }
+        }
+        fwrite(text.data(), 1, text.size(), out);
+        text.clear();
+    }
+    if (offset != data.size() && !BinaryLogDecoder::isPadding(data.data(), data.size(), offset)) {
+        std::cerr << "log_decoder: " << path << " 末尾截断或损坏，已停止解码" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// 解码单个文件，返回是否完整解码
+bool decodeFile(const std::string& path, const DecodeFilter& filter, FILE* out) {
+    MappedFile file;
+    if (!file.open(path)) {
+        std::cerr << "log_decoder: 无法打开文件: " << path << std::endl;
+        return false;
+    }
+
+    if (file.size() >= sizeof(yalgo::log::COMPRESSED_SEGMENT_MAGIC) &&
+        std::memcmp(file.data(), yalgo::log::COMPRESSED_SEGMENT_MAGIC,
+                    sizeof(yalgo::log::COMPRESSED_SEGMENT_MAGIC)) == 0) {
+        return decodeCompressedFile(path, filter, out);
+    }
+
+    size_t offset = 0;
+    if (!BinaryLogDecoder::checkHeader(file.data(), file.size(), offset)) {
+        std::cerr << "log_decoder: 不是二进制日志文件: " << path << std::endl;
+        return false;
+    }
+
+    const size_t flush_threshold = 1 << 20;
+    const size_t release_window = 64 << 20;
+    BinaryLogDecoder decoder;
+    BinaryLogEntry entry;
+    std::string text;
+    text.reserve(flush_threshold + 4096);
+    size_t released = 0;
+
+    while (decoder.next(file.data(), file.size(), offset, entry)) {
+        if (matches(filter, entry)) {
+            formatEntry(filter, entry, text);
+            text += '\n';
+            if (text.size() >= flush_threshold) {
+                fwrite(text.data(), 1, text.size(), out);
+                text.clear();
+            }
+        }
+        if (offset - released >= release_window) {
+            file.release(released, offset);
+            released = offset;
+        }
+    }
+    fwrite(text.data(), 1, text.size(), out);
+
+    // 内存映射输出在进程崩溃后会遗留预分配的零填充尾部，属于正常结束
+    if (offset != file.size() && !BinaryLogDecoder::isPadding(file.data(), file.size(), offset)) {
+        std::cerr << "log_decoder: " << path << " 在偏移 " << offset
+                  << " 处截断或损坏，已停止解码" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void printUsage() {
+    std::cerr << "用法: log_decoder [--level LEVEL] [--module NAME]... "
+                 "[--from TIME] [--to TIME] [--kv json|logfmt] [-o FILE] 文件..." << std::endl;
+}
+
+} // namespace
+
+// 二进制日志解码工具的入口点
+int main(int argc, char* argv[]) {
+    DecodeFilter filter;
+    std::vector<std::string> files;
+    std::string output;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--level" && has_value) {
+            if (!parseLevel(argv[++i], filter.max_level)) {
+                std::cerr << "log_decoder: 无效的日志级别: " << argv[i] << std::endl;
+                return 2;
+            }
+        } else if (arg == "--module" && has_value) {
+            filter.modules.push_back(argv[++i]);
+        } else if ((arg == "--from" || arg == "--to") && has_value) {
+            uint64_t& target = (arg == "--from") ? filter.from_us : filter.to_us;
+            if (!parseTime(argv[++i], target)) {
+                std::cerr << "log_decoder: 无效的时间: " << argv[i] << std::endl;
+                return 2;
+            }
+        } else if (arg == "--kv" && has_value) {
+            std::string format = argv[++i];
+            if (format != "json" && format != "logfmt") {
+                std::cerr << "log_decoder: 无效的结构化日志格式: " << format << std::endl;
+                return 2;
+            }
+            filter.kv_encode = true;
+            filter.kv_format = (format == "json") ? yalgo::log::LogKvFormat::JSON
+                                                  : yalgo::log::LogKvFormat::LOGFMT;
+        } else if (arg == "-o" && has_value) {
+            output = argv[++i];
+        } else if (arg == "-h" || arg == "--help") {
+            printUsage();
+            return 0;
+        } else if (!arg.empty() && arg[0] == '-') {
+            printUsage();
+            return 2;
+        } else {
+            files.push_back(arg);
+        }
+    }
+
+    if (files.empty()) {
+        printUsage();
+        return 2;
+    }
+
+    FILE* out = stdout;
+    if (!output.empty()) {
+        out = fopen(output.c_str(), "wb");
+        if (!out) {
+            std::cerr << "log_decoder: 无法创建输出文件: " << output << std::endl;
+            return 1;
+        }
+    }
+
+    bool ok = true;
+    for (const std::string& path : files) {
+        ok = decodeFile(path, filter, out) && ok;
+    }
+
+    if (out != stdout) {
+        fclose(out);
+    }
+    return ok ? 0 : 1;
+}
@@ -1,8 +1,181 @@
 #include "log_test.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
 namespace yalgo {
 namespace examples {
 
+namespace {
+
+// 每条日志耗时1ms的慢速输出目标，用于演示独立线程与队列满丢弃
+class SlowSink : public yalgo::log::LogSink {
+public:
+    std::string name() const override { return "slow-demo"; }
+    void write(const yalgo::log::LogSinkMessage&) override {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+};
+
+// 按"线程 t 序号 n"检查每个线程的日志是否按提交顺序写出
+class OrderCheckSink : public yalgo::log::LogSink {
+public:
+    std::string name() const override { return "order-check"; }
+    void write(const yalgo::log::LogSinkMessage& message) override {
+        size_t pos = message.text.find("线程 ");
+        int thread = 0;
+        int seq = 0;
+        if (pos == std::string_view::npos ||
+            std::sscanf(std::string(message.text.substr(pos)).c_str(), "线程 %d 序号 %d", &thread,
+                        &seq) != 2) {
+            return;
+        }
+        // 写入线程稍慢于生产者，使普通通道形成积压
+        std::this_thread::sleep_for(std::chrono::microseconds(2));
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (last_.size() <= static_cast<size_t>(thread)) {
+            last_.resize(thread + 1, -1);
+        }
+        if (seq <= last_[thread]) {
+            ++out_of_order_;
+        }
+        last_[thread] = seq;
+        ++received_;
+    }
+    int received() const { std::lock_guard<std::mutex> lock(mutex_); return received_; }
+    int outOfOrder() const { std::lock_guard<std::mutex> lock(mutex_); return out_of_order_; }
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<int> last_;
+    int received_ = 0;
+    int out_of_order_ = 0;
+};
+
+// 输出时延分布的p50/p99/p999
+std::string formatLatency(const yalgo::log::LogLatencyStats& latency, const char* unit) {
+    std::ostringstream oss;
+    oss << "p50/p99/p999 " << latency.p50 << "/" << latency.p99 << "/" << latency.p999 << " " << unit;
+    return oss.str();
+}
+
+// 打印单个输出目标的统计
+void printSinkStats(const yalgo::log::LogSinkStats& sink) {
+    uint64_t avg = sink.messages ? sink.total_write_ns / sink.messages : 0;
+    std::cout << "  - " << sink.name << (sink.dedicated_thread ? " [独立线程]" : "") << ": "
+              << sink.messages << " 条, " << sink.bytes_written << " 字节, 丢弃 " << sink.dropped
+              << " 条, 平均写入 " << avg << " ns, 最大写入 " << sink.max_write_ns << " ns, 写入耗时 "
+              << formatLatency(sink.write_latency, "ns") << std::endl;
+}
+
+#ifndef _WIN32
+// 在path上绑定数据报套接字，代替syslogd接收报文
+int bindSyslogListener(const char* path) {
+    unlink(path);
+    int fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+    struct sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+    if (fd < 0 || bind(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+    struct timeval timeout = {0, 200 * 1000};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    return fd;
+}
+
+// 打印监听套接字收到的全部报文
+void printSyslogDatagrams(int fd) {
+    char buf[2048];
+    ssize_t n;
+    while ((n = recv(fd, buf, sizeof(buf), 0)) > 0) {
+        std::cout << "  syslogd收到: " << std::string(buf, static_cast<size_t>(n)) << std::endl;
+    }
+}
+
+// 在子进程中写入日志后崩溃，返回子进程的等待状态（二进制文件写入调用点日志）
+int runCrashingChild(const char* path, int logs, bool uncaught_exception, bool binary) {
+    unlink(path);
+    pid_t pid = fork();
+    if (pid < 0) {
+        return -1;
+    }
+    if (pid == 0) {
+        // 子进程：调用栈打印到标准错误，演示中不显示
+        int null_fd = open("/dev/null", O_WRONLY);
+        if (null_fd >= 0) {
+            dup2(null_fd, 2);
+        }
+        // 文件缓冲攒到1MB或1分钟才写出，崩溃时日志都还在缓冲或队列中
+        yalgo::log::LogConfig config;
+        config.enable_console = false;
+        config.log_file = path;
+        config.queue_type = yalgo::log::LogQueueType::LOCKFREE_RING;
+        config.file_format = binary ? yalgo::log::LogFileFormat::BINARY : yalgo::log::LogFileFormat::TEXT;
+        config.file_flush_bytes = 1024 * 1024;
+        config.file_flush_interval_ms = 60000;
+        config.crash_handler = true;
+        auto logger = yalgo::log::AsyncLogger::createLogger("crash_demo", config);
+        static const yalgo::log::BinaryArgType arg_types[] = {yalgo::log::BinaryArgType::INT32};
+        yalgo::log::BinaryLogSite desc;
+        desc.level = yalgo::log::LogLevel::INFO;
+        desc.file = __FILE__;
+        desc.line = __LINE__;
+        desc.func = __func__;
+        desc.format = "崩溃前的第 %d 条日志";
+        desc.arg_types = arg_types;
+        desc.arg_count = 1;
+        const yalgo::log::BinaryLogSite* site = yalgo::log::registerBinaryLogSite(desc);
+        for (int i = 0; i < logs; ++i) {
+            if (binary) {
+                // 与YLOG_BIN_*相同的记录，提交到命名日志器
+                yalgo::log::LogRecord record;
+                record.level = yalgo::log::LogLevel::INFO;
+                record.site = site;
+                int32_t value = i;
+                record.args.assign(reinterpret_cast<const char*>(&value), sizeof(value));
+                logger->submit(std::move(record));
+            } else if (i % 1000 == 999) {
+                // 错误日志走高优先级队列，崩溃写出时与普通日志按时间归并
+                YLOG_LOGGER_ERROR_FMT(*logger, "崩溃前的第 {} 条日志", i);
+            } else {
+                YLOG_LOGGER_INFO_FMT(*logger, "崩溃前的第 {} 条日志", i);
+            }
+        }
+        if (uncaught_exception) {
+            throw std::runtime_error("未捕获的异常");
+        }
+        volatile int* invalid = nullptr;
+        *invalid = 1;
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return status;
+}
+#endif
+
+} // namespace
+
 // 初始化日志系统
 void LogTest::initLogger() {
     std::cout << "初始化日志系统..." << std::endl;
@@ -60,6 +233,77 @@ void LogTest::demoStreamingLogging() {
     std::cout << "\n";
 }
 
+// 示例函数：演示{}风格格式化日志
+void LogTest::demoFormattedLogging() {
+    std::cout << "=== {}风格格式化日志演示 ===" << std::endl;
+    
+    // 占位符个数与参数个数在编译期核对，std::string可直接作为参数
+    std::string user = "admin";
+    YLOG_INFO_FMT("用户登录: {}, 会话数: {}, 耗时: {} ms", user, 3, 1.75);
+    YLOG_MODULE_WARN_FMT("Network", "重连第{}次, 目标: {}:{}", 2, "10.0.0.1", 8080u);
+    YLOG_ERROR_FMT("配置项 {{timeout}} 非法: {}", -5);
+    
+    // 格式化到字符串
+    std::string text;
+    YLOG_FORMAT_TO(text, "就绪: {}, 队列: {}", true, 128);
+    std::cout << text << std::endl;
+    
+    std::cout << "\n";
+}
+
+// 示例函数：演示二进制延迟格式化日志
+void LogTest::demoBinaryLogging() {
+    std::cout << "=== 二进制延迟格式化日志演示 ===" << std::endl;
+    
+    // 调用线程只拷贝参数原始字节，格式化在后台线程完成
+    std::string user = "admin";
+    YLOG_BIN_INFO("用户登录: %s, 会话数: %d, 耗时: %.2f ms", user, 3, 1.75);
+    YLOG_BIN_MODULE_WARN("Network", "重连第%d次, 目标: %s:%u", 2, "10.0.0.1", 8080u);
+    YLOG_BIN_ERROR("写入失败, 错误码: %d", -5);
+    
+    std::cout << "\n";
+}
+
+// 示例函数：演示结构化键值日志
+void LogTest::demoStructuredLogging() {
+    std::cout << "=== 结构化键值日志演示 ===" << std::endl;
+
+    // 字段按类型打包入队，写入线程直接编码为一行JSON，下游无需正则解析
+    std::string user = "admin";
+    YLOG_INFO_KV("用户登录", "user", user, "sessions", 3, "latency_ms", 1.75, "ok", true);
+    YLOG_MODULE_WARN_KV("Network", "重连", "attempt", 2, "target", "10.0.0.1:8080");
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // 切换为logfmt
+    auto& logger = yalgo::log::AsyncLogger::getInstance();
+    yalgo::log::LogConfig config;
+    config.log_file = "log_example.log";
+    config.max_file_size = 10 * 1024 * 1024;
+    config.max_backup_files = 5;
+    config.kv_format = yalgo::log::LogKvFormat::LOGFMT;
+    logger.updateConfig(config);
+    YLOG_INFO_KV("下单完成", "order_id", 10086ull, "amount", 0.1 + 0.2, "note", "含 空格");
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    config.kv_format = yalgo::log::LogKvFormat::JSON;
+    logger.updateConfig(config);
+
+    std::cout << "\n";
+}
+
+// 示例函数：演示按调用点限频与采样
+void LogTest::demoRateLimitedLogging() {
+    std::cout << "=== 限频与采样日志演示 ===" << std::endl;
+
+    // 热循环中的重复告警：每1000次输出1次，其余只累计次数，后台线程定期输出汇总行
+    for (int i = 0; i < 5000; ++i) {
+        YLOG_WARN_EVERY_N(1000, "连接池已满，第%d次重试", i);
+        YLOG_INFO_EVERY_MS(200, "心跳包已发送, 序号: %d", i);
+        YLOG_DEBUG_SAMPLED(0.01, "采样的调试日志, 序号: %d", i);
+    }
+
+    std::cout << "\n";
+}
+
 // 示例函数：演示动态日志级别调整
 void LogTest::demoRuntimeLevelAdjustment() {
     std::cout << "=== 动态日志级别调整演示 ===" << std::endl;
@@ -80,6 +324,27 @@ void LogTest::demoRuntimeLevelAdjustment() {
     std::cout << "\n";
 }
 
+// 示例函数：演示按模块设置运行时级别
+void LogTest::demoModuleLevels() {
+    std::cout << "=== 模块级别演示 ===" << std::endl;
+
+    // 全局级别INFO，earth模块放开到DEBUG，log模块收紧到WARN
+    yalgo::log::AsyncLogger& logger = yalgo::log::AsyncLogger::getInstance();
+    logger.setModuleLogLevel("earth", yalgo::log::LogLevel::DEBUG);
+    logger.setModuleLogLevel("log", yalgo::log::LogLevel::WARN);
+    YLOG_MODULE_DEBUG("earth", "这条earth调试日志会显示");
+    YLOG_MODULE_INFO("log", "这条log信息日志不会显示");
+    YLOG_MODULE_WARN("log", "这条log警告日志会显示");
+    YLOG_MODULE_DEBUG("Parser", "未设置级别的模块沿用全局级别，这条不会显示");
+    YLOG_MODULE_INFO_STREAM("earth") << "流式模块日志同样按模块级别过滤";
+
+    // 恢复为与全局级别一致
+    logger.setModuleLogLevel("earth", yalgo::log::LogLevel::INFO);
+    logger.setModuleLogLevel("log", yalgo::log::LogLevel::INFO);
+
+    std::cout << "\n";
+}
+
 // 示例函数：演示多线程日志
 void LogTest::demoMultiThreadLogging() {
     std::cout << "=== 多线程日志功能演示 ===" << std::endl;
@@ -110,8 +375,24 @@ void LogTest::demoPerformanceStats() {
     std::cout << "日志统计信息:" << std::endl;
     std::cout << "  - 总日志数: " << stats.total_logs << std::endl;
     std::cout << "  - 丢弃的日志数: " << stats.dropped_logs << std::endl;
+    std::cout << "  - 阻塞等待的日志数: " << stats.blocked_logs << std::endl;
+    std::cout << "  - 关键词过滤的日志数: " << stats.filtered_logs << std::endl;
     std::cout << "  - 最大队列长度: " << stats.max_queue_size << std::endl;
     std::cout << "  - 总写入时间(μs): " << stats.total_write_time << std::endl;
+    std::cout << "  - 提交耗时: " << formatLatency(stats.enqueue_latency, "ns")
+              << ", 最大 " << stats.enqueue_latency.max << " ns" << std::endl;
+    const yalgo::log::LogLaneStats* lanes[2] = {&stats.high_lane, &stats.low_lane};
+    const char* lane_names[2] = {"高优先级通道(ERROR/WARN)", "普通通道(INFO/DEBUG)"};
+    for (int i = 0; i < 2; ++i) {
+        uint64_t avg = lanes[i]->logs ? lanes[i]->total_wait_us / lanes[i]->logs : 0;
+        std::cout << "  - " << lane_names[i] << ": " << lanes[i]->logs << " 条, 平均排队 "
+                  << avg << " μs, 最大排队 " << lanes[i]->max_wait_us << " μs, 排队 "
+                  << formatLatency(lanes[i]->wait_us, "μs") << std::endl;
+    }
+    std::cout << "输出目标统计:" << std::endl;
+    for (const yalgo::log::LogSinkStats& sink : stats.sinks) {
+        printSinkStats(sink);
+    }
     
     std::cout << "\n";
 }
@@ -133,6 +414,313 @@ void LogTest::demoConfigUpdate() {
     std::cout << "\n";
 }
 
+// 示例函数：演示关键词过滤
+void LogTest::demoKeywordFilter() {
+    std::cout << "=== 关键词过滤演示 ===" << std::endl;
+
+    yalgo::log::LogConfig config;
+    config.enable_file = false;
+    config.filter_keywords = {"heartbeat", "password"};
+    yalgo::log::AsyncLogger::getInstance().updateConfig(config);
+    YLOG_INFO("heartbeat ok，这条日志不会显示");
+    YLOG_INFO("user login, password=***，这条日志不会显示");
+    YLOG_INFO("订单已创建，这条日志会显示");
+
+    // 过滤在写入线程执行，等待上面的日志写出后再恢复
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    config.filter_keywords.clear();
+    yalgo::log::AsyncLogger::getInstance().updateConfig(config);
+
+    std::cout << "\n";
+}
+
+// 示例函数：演示自定义输出目标
+void LogTest::demoCustomSink() {
+    std::cout << "=== 自定义输出目标演示 ===" << std::endl;
+
+    auto& logger = yalgo::log::AsyncLogger::getInstance();
+    yalgo::log::LogConfig config;
+    config.enable_console = false;
+    config.enable_file = false;
+    config.sink_queue_capacity = 16; // 之后注册的输出目标使用该队列容量
+    logger.updateConfig(config);
+
+    // 慢速目标跟不上时只丢弃它自己队列中的日志；写入很快的内存映射文件直接在写入线程上输出，不受影响
+    auto slow = std::make_shared<SlowSink>();
+    auto extra = std::make_shared<yalgo::log::FileLogSink>(
+        "log_example_extra.log", yalgo::log::LogFileSinkType::MMAP);
+    logger.addSink(slow);
+    logger.addSink(extra, false);
+    for (int i = 0; i < 200; ++i) {
+        YLOG_INFO("自定义输出目标日志 %d", i);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    for (const yalgo::log::LogSinkStats& sink : logger.getStats().sinks) {
+        printSinkStats(sink);
+    }
+    logger.removeSink(slow);
+    logger.removeSink(extra);
+
+    config.enable_console = true;
+    config.sink_queue_capacity = yalgo::log::LogConfig().sink_queue_capacity;
+    logger.updateConfig(config);
+
+    std::cout << "\n";
+}
+
+// 示例函数：演示系统日志输出
+void LogTest::demoSyslogSink() {
+    std::cout << "=== 系统日志输出演示 ===" << std::endl;
+#ifndef _WIN32
+    const char* path = "log_example_syslog.sock";
+    int listener = bindSyslogListener(path);
+    if (listener < 0) {
+        std::cout << "无法创建本地syslog套接字: " << path << std::endl;
+        return;
+    }
+
+    // 同一个连接批量发送，不再每条日志openlog/closelog
+    auto& logger = yalgo::log::AsyncLogger::getInstance();
+    auto sink = std::make_shared<yalgo::log::SyslogSink>("log_example", path);
+    logger.addSink(sink);
+    YLOG_INFO("syslog 第一条");
+    YLOG_ERROR("syslog 第二条");
+    printSyslogDatagrams(listener);
+
+    // 模拟syslogd重启：旧连接失效，下一批发送时重新连接
+    close(listener);
+    listener = bindSyslogListener(path);
+    YLOG_WARN("syslogd重启后的日志");
+    printSyslogDatagrams(listener);
+
+    logger.removeSink(sink);
+    std::cout << "  发送失败丢弃: " << sink->sendFailures() << " 条" << std::endl;
+    close(listener);
+    unlink(path);
+#else
+    std::cout << "本演示仅支持Linux" << std::endl;
+#endif
+
+    std::cout << "\n";
+}
+
+// 示例函数：演示命名日志器
+void LogTest::demoNamedLoggers() {
+    std::cout << "=== 命名日志器演示 ===" << std::endl;
+    
+    // 审计日志单独一个文件、逐条写出；遥测日志只保留警告以上，各自拥有队列与写入线程
+    yalgo::log::LogConfig audit_config;
+    audit_config.enable_console = false;
+    audit_config.log_file = "log_example_audit.log";
+    audit_config.runtime_level = yalgo::log::LogLevel::INFO;
+    audit_config.file_flush_bytes = 0;
+    auto audit = yalgo::log::AsyncLogger::createLogger("audit", audit_config);
+    
+    yalgo::log::LogConfig telemetry_config;
+    telemetry_config.enable_console = false;
+    telemetry_config.log_file = "log_example_telemetry.log";
+    telemetry_config.runtime_level = yalgo::log::LogLevel::WARN;
+    telemetry_config.queue_type = yalgo::log::LogQueueType::LOCKFREE_RING;
+    auto telemetry = yalgo::log::AsyncLogger::createLogger("telemetry", telemetry_config);
+    
+    YLOG_LOGGER_INFO(*audit, "用户 %s 修改了权限: %s", "admin", "read-write");
+    YLOG_LOGGER_INFO_FMT(*audit, "用户 {} 登出, 会话时长 {} s", "admin", 125);
+    YLOG_LOGGER_INFO_STREAM(*telemetry) << "该条低于遥测日志器的级别，不会被记录";
+    YLOG_LOGGER_WARN_STREAM(*telemetry) << "CPU温度: " << 86.5 << "°C";
+    
+    // logger表达式只求值一次
+    int evaluations = 0;
+    auto pick = [&]() -> yalgo::log::AsyncLogger& { ++evaluations; return *telemetry; };
+    YLOG_LOGGER_WARN_STREAM(pick()) << "风扇转速: " << 3200 << " rpm";
+    std::cout << "流式宏的logger表达式求值 " << evaluations << " 次" << std::endl;
+    
+    yalgo::log::LogStats stats = yalgo::log::AsyncLogger::getLogger("audit")->getStats();
+    std::cout << "audit 日志器已提交 " << stats.total_logs << " 条, 写入 " << audit_config.log_file << std::endl;
+    
+    // 注销后最后一个引用释放时写完队列并停止写入线程
+    audit.reset();
+    telemetry.reset();
+    yalgo::log::AsyncLogger::dropLogger("audit");
+    yalgo::log::AsyncLogger::dropLogger("telemetry");
+    
+    std::cout << "\n";
+}
+
+// 高优先级通道与同一线程普通日志的先后顺序演示
+void LogTest::demoLaneOrdering() {
+    std::cout << "=== 高优先级通道顺序演示 ===" << std::endl;
+    
+    // 错误日志越过其他线程积压的普通日志先写出，但不越过本线程更早提交的普通日志
+    struct Mode {
+        const char* name;
+        yalgo::log::LogQueueType queue_type;
+        bool staging;
+    };
+    const Mode modes[] = {
+        {"互斥锁队列", yalgo::log::LogQueueType::MUTEX_QUEUE, false},
+        {"无锁环形队列", yalgo::log::LogQueueType::LOCKFREE_RING, false},
+        {"线程本地暂存", yalgo::log::LogQueueType::MUTEX_QUEUE, true},
+    };
+    const int threads = 4;
+    const int logs = 2000;
+    for (const Mode& mode : modes) {
+        yalgo::log::LogConfig config;
+        config.enable_console = false;
+        config.enable_file = false;
+        config.runtime_level = yalgo::log::LogLevel::INFO;
+        config.queue_type = mode.queue_type;
+        config.enable_staging = mode.staging;
+        auto logger = yalgo::log::AsyncLogger::createLogger("lane_order", config);
+        auto sink = std::make_shared<OrderCheckSink>();
+        logger->addSink(sink, false);
+        
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&logger, t, logs]() {
+                for (int i = 0; i < logs; ++i) {
+                    if (i % 5 == 4) {
+                        YLOG_LOGGER_ERROR(*logger, "线程 %d 序号 %d", t, i);
+                    } else {
+                        YLOG_LOGGER_INFO(*logger, "线程 %d 序号 %d", t, i);
+                    }
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        // 注销后最后一个引用释放时写完队列
+        logger.reset();
+        yalgo::log::AsyncLogger::dropLogger("lane_order");
+        
+        bool ok = sink->received() == threads * logs && sink->outOfOrder() == 0;
+        std::cout << (ok ? "✓ " : "✗ ") << mode.name << ": 写出 " << sink->received() << " 条, 线程内乱序 "
+                  << sink->outOfOrder() << " 条" << std::endl;
+    }
+    
+    std::cout << "\n";
+}
+
+// 写入线程调优演示
+void LogTest::demoWriterThreadTuning() {
+    std::cout << "=== 写入线程调优演示 ===" << std::endl;
+    
+    // 写入线程绑定到最后一个CPU并降低优先级，把其余核心留给业务线程；
+    // 环形队列由写入线程绑核后创建，内存位于它所在的NUMA节点
+    yalgo::log::LogConfig config;
+    config.enable_console = false;
+    config.log_file = "log_example_tuned.log";
+    config.queue_type = yalgo::log::LogQueueType::LOCKFREE_RING;
+    config.writer_cpus = {static_cast<int>(std::max(1u, std::thread::hardware_concurrency())) - 1};
+    config.writer_nice = 5;
+    config.numa_local_queue = true;
+    // 突发日志之间的短暂空闲期间写入线程自旋等待，生产者不必加锁唤醒
+    config.wait_strategy = yalgo::log::LogWaitStrategy::SPIN_THEN_BLOCK;
+    config.spin_wait_us = 50;
+    auto tuned = yalgo::log::AsyncLogger::createLogger("tuned", config);
+    
+    for (int burst = 0; burst < 5; ++burst) {
+        for (int i = 0; i < 100; ++i) {
+            YLOG_LOGGER_INFO_FMT(*tuned, "行情 {} 序号 {}", burst, i);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    
+    yalgo::log::LogStats stats = tuned->getStats();
+    std::cout << "写入线程绑定到CPU " << config.writer_cpus[0] << ", 自旋命中 " << stats.writer_spin_hits
+              << " 次, 阻塞等待 " << stats.writer_blocks << " 次" << std::endl;
+    
+    tuned.reset();
+    yalgo::log::AsyncLogger::dropLogger("tuned");
+    
+    std::cout << "\n";
+}
+
+// 崩溃写出演示
+void LogTest::demoCrashFlush() {
+    std::cout << "=== 崩溃时写出待处理日志演示 ===" << std::endl;
+#ifndef _WIN32
+    const int logs = 20000;
+    struct Case {
+        const char* name;
+        const char* path;
+        bool uncaught_exception;
+        bool binary;
+        int expected_signal;
+        const char* expected_reason;
+    };
+    const Case cases[] = {
+        {"空指针写入", "log_example_crash_segv.log", false, false, SIGSEGV, "fatal SIGSEGV"},
+        {"未捕获异常", "log_example_crash_terminate.log", true, false, SIGABRT, "fatal std::terminate"},
+        {"二进制文件", "log_example_crash_binary.ylog", false, true, SIGSEGV, "fatal SIGSEGV"},
+    };
+    for (const Case& c : cases) {
+        int status = runCrashingChild(c.path, logs, c.uncaught_exception, c.binary);
+        bool signaled = status >= 0 && WIFSIGNALED(status) && WTERMSIG(status) == c.expected_signal;
+
+        // 逐条取出日志序号与文件末尾的崩溃原因、调用栈：文本逐行读取，二进制用解码器
+        std::vector<std::string> entries;
+        std::ifstream file(c.path, std::ios::binary);
+        if (c.binary) {
+            std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            size_t offset = 0;
+            yalgo::log::BinaryLogDecoder decoder;
+            yalgo::log::BinaryLogEntry entry;
+            if (yalgo::log::BinaryLogDecoder::checkHeader(data.data(), data.size(), offset)) {
+                while (decoder.next(data.data(), data.size(), offset, entry)) {
+                    std::string text;
+                    yalgo::log::BinaryLogDecoder::formatEntry(entry, text);
+                    // 崩溃条目是一条多行TEXT，按行拆开与文本文件一致
+                    size_t begin = 0;
+                    size_t end;
+                    while ((end = text.find('\n', begin)) != std::string::npos) {
+                        entries.push_back(text.substr(begin, end - begin));
+                        begin = end + 1;
+                    }
+                    entries.push_back(text.substr(begin));
+                }
+            }
+        } else {
+            std::string line;
+            while (std::getline(file, line)) {
+                entries.push_back(line);
+            }
+        }
+
+        // 日志须一条不缺、按序号递增、不重复
+        std::string last_log;
+        bool has_reason = false;
+        bool ordered = true;
+        int written = 0;
+        int previous = -1;
+        int frames = 0;
+        for (const std::string& line : entries) {
+            if (line.find(c.expected_reason) != std::string::npos) {
+                has_reason = true;
+            } else if (has_reason) {
+                ++frames;
+            } else {
+                size_t pos = line.find("崩溃前的第 ");
+                int seq = pos == std::string::npos ? -1 : std::atoi(line.c_str() + pos + std::strlen("崩溃前的第 "));
+                ordered = ordered && seq > previous;
+                previous = seq;
+                ++written;
+                last_log = line;
+            }
+        }
+        bool ok = signaled && has_reason && frames > 0 && ordered && written == logs;
+        std::cout << (ok ? "✓ " : "✗ ") << c.name << ": 子进程" << (signaled ? "按预期信号终止" : "未按预期终止")
+                  << ", 日志 " << written << " 条（缺少 " << logs - written << " 条）, "
+                  << (ordered ? "按序无重复" : "顺序错误或重复") << ", 调用栈 " << frames << " 层" << std::endl;
+        std::cout << "  最后一条日志: " << last_log << std::endl;
+    }
+#else
+    std::cout << "本演示仅支持Linux" << std::endl;
+#endif
+
+    std::cout << "\n";
+}
+
 // 运行所有测试
 void LogTest::runAllTests() {
     std::cout << "====================================================" << std::endl;
@@ -143,9 +731,21 @@ void LogTest::runAllTests() {
     demoBasicLogging();
     demoModuleLogging();
     demoStreamingLogging();
+    demoFormattedLogging();
+    demoBinaryLogging();
+    demoStructuredLogging();
+    demoRateLimitedLogging();
     demoRuntimeLevelAdjustment();
+    demoModuleLevels();
     demoMultiThreadLogging();
     demoConfigUpdate();
+    demoKeywordFilter();
+    demoCustomSink();
+    demoSyslogSink();
+    demoNamedLoggers();
+    demoLaneOrdering();
+    demoWriterThreadTuning();
+    demoCrashFlush();
     
     // 等待日志队列处理完成
     std::this_thread::sleep_for(std::chrono::seconds(1));
@@ -36,11 +36,36 @@ public:
      */
     static void demoStreamingLogging();
     
+    /**
+     * 演示编译期检查的{}风格格式化日志
+     */
+    static void demoFormattedLogging();
+    
+    /**
+     * 演示二进制延迟格式化日志
+     */
+    static void demoBinaryLogging();
+    
+    /**
+     * 演示结构化键值日志（JSON / logfmt）
+     */
+    static void demoStructuredLogging();
+    
+    /**
+     * 演示按调用点限频与采样
+     */
+    static void demoRateLimitedLogging();
+    
     /**
      * 演示动态日志级别调整
      */
     static void demoRuntimeLevelAdjustment();
     
+    /**
+     * 演示按模块设置运行时日志级别
+     */
+    static void demoModuleLevels();
+    
     /**
      * 演示多线程日志
      */
@@ -56,6 +81,41 @@ public:
      */
     static void demoConfigUpdate();
     
+    /**
+     * 演示关键词包含/排除过滤
+     */
+    static void demoKeywordFilter();
+    
+    /**
+     * 演示注册自定义输出目标与各目标统计
+     */
+    static void demoCustomSink();
+    
+    /**
+     * 演示系统日志输出：本地Unix套接字代替syslogd接收报文，并演示断线重连
+     */
+    static void demoSyslogSink();
+    
+    /**
+     * 演示命名日志器（独立的队列、输出目标与配置）
+     */
+    static void demoNamedLoggers();
+    
+    /**
+     * 演示错误日志走高优先级通道时仍保持同一线程内的先后顺序（三种队列模式）
+     */
+    static void demoLaneOrdering();
+    
+    /**
+     * 演示写入线程绑核、降低优先级、NUMA本地队列与先自旋再阻塞的等待方式
+     */
+    static void demoWriterThreadTuning();
+    
+    /**
+     * 演示崩溃处理：子进程写入日志后崩溃，检查文本与二进制文件末尾的日志与调用栈
+     */
+    static void demoCrashFlush();
+    
     /**
      * 运行所有测试
      */
@@ -7,6 +7,11 @@
  */
 
 #include "async_logger.h"
+#include "binary_log.h"
+#include "segment_compressor.h"
+#include "rate_limit.h"
+#include "keyword_filter.h"
+#include "structured_log.h"
 #include <iostream>
 #include <sstream>
 #include <ctime>
@@ -14,23 +19,305 @@
 #include <cstring>
 #include <stdexcept>
 #include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdlib>
 #include <chrono>
+#include <filesystem>
 #include <limits>
 #include <cstdio>
+#include <cerrno>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <unordered_map>
+
+// TSC读取
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 
 // 跨平台系统日志头文件
 #ifdef _WIN32
 #include <windows.h>
 #include <winbase.h>
 #else
-#include <syslog.h>
-#include <usleep.h>
 #include <sys/stat.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#endif
 #endif
 
 namespace yalgo {
 namespace log {
 
+/**
+ * @brief 线程本地暂存缓冲
+ *
+ * @details 由所属线程追加日志，后台线程仅在清扫超时缓冲时访问，互斥锁基本无竞争
+ */
+struct StagingBuffer {
+    std::mutex mutex;                ///< 所属线程与后台清扫之间的互斥锁
+    std::vector<LogRecord> records;  ///< 尚未提交的日志
+    uint64_t owner_id = 0;           ///< 所属线程序号
+    bool alive = true;               ///< 所属线程是否仍在运行
+    std::atomic<bool> detached{false}; ///< 所属日志器是否已析构
+};
+
+namespace {
+
+// 当前时间（Unix纪元微秒）
+uint64_t nowMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+    ).count();
+}
+
+// 单调时钟纳秒数
+inline uint64_t steadyNanos() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// 原始时间计数：x86上为TSC，其他平台退化为steady_clock纳秒
+inline uint64_t readTicks() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+// 两位数字表，微秒数按两位一组查表输出
+const char digit_pairs[] =
+    "0001020304050607080910111213141516171819202122232425262728293031323334353637383940414243444546474849"
+    "5051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+// 无分支写入6位微秒数
+inline void writeMicros(char* out, uint32_t micros) {
+    uint32_t high = micros / 10000;
+    uint32_t mid = micros / 100 - high * 100;
+    uint32_t low = micros - (micros / 100) * 100;
+    std::memcpy(out, digit_pairs + high * 2, 2);
+    std::memcpy(out + 2, digit_pairs + mid * 2, 2);
+    std::memcpy(out + 4, digit_pairs + low * 2, 2);
+}
+
+// 时间格式化缓存，"YYYY-mm-dd HH:MM:SS."前缀只在秒变化时重新生成
+struct TimeFormatCache {
+    int64_t second = -1;
+    char text[40] = {0};
+    size_t length = 0;
+};
+
+thread_local TimeFormatCache time_cache;
+
+// 当前线程在各日志器中的暂存缓冲（按日志器实例序号区分），线程退出时标记失效，剩余日志由后台线程清扫提交
+struct StagingHandle {
+    std::vector<std::pair<uint64_t, std::shared_ptr<StagingBuffer>>> buffers;
+
+    ~StagingHandle() {
+        for (auto& entry : buffers) {
+            std::lock_guard<std::mutex> lock(entry.second->mutex);
+            entry.second->alive = false;
+        }
+    }
+
+    // 查找指定日志器的暂存缓冲，未登记时返回nullptr；途经所属日志器已析构的登记项时移除
+    StagingBuffer* find(uint64_t logger_id) {
+        for (size_t i = 0; i < buffers.size();) {
+            if (buffers[i].second->detached.load(std::memory_order_relaxed)) {
+                buffers[i] = std::move(buffers.back());
+                buffers.pop_back();
+                continue;
+            }
+            if (buffers[i].first == logger_id) {
+                return buffers[i].second.get();
+            }
+            ++i;
+        }
+        return nullptr;
+    }
+};
+
+thread_local StagingHandle tls_staging;
+std::atomic<uint64_t> next_staging_owner(1);
+
+// 当前线程的提交序号，写入线程据此保持同一线程在两个通道之间的先后顺序
+struct SubmitOrder {
+    uint32_t tag = 0;
+    uint32_t seq = 0;
+};
+
+thread_local SubmitOrder submit_order;
+std::atomic<uint32_t> next_thread_tag(1);
+
+// 当前线程是否为写入线程：写入线程自己提交的日志（限频汇总）不能等待自己腾出队列空间
+thread_local bool tls_writer_thread = false;
+
+// 线程内序号a是否早于b（按32位回绕比较）
+inline bool seqBefore(uint32_t a, uint32_t b) {
+    return static_cast<int32_t>(a - b) < 0;
+}
+std::atomic<uint64_t> next_logger_id(1);
+
+// 命名日志器登记表
+struct LoggerRegistry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<AsyncLogger>> loggers;
+};
+
+LoggerRegistry& loggerRegistry() {
+    static LoggerRegistry registry;
+    return registry;
+}
+
+// 日志记录占用的队列字节数（入队预留与出队释放使用同一算法）
+size_t recordBytes(const LogRecord& record) {
+    return sizeof(LogRecord) + record.text.size() + record.args.size();
+}
+
+// 解析容量不足处理规则："drop_newest" | "drop_oldest" | "block[:毫秒]" | "sample[:N]"
+void parseOverflowRule(const std::string& value, LogOverflowRule& rule) {
+    size_t colon = value.find(':');
+    std::string name = value.substr(0, colon);
+    uint32_t arg = 0;
+    if (colon != std::string::npos) {
+        try {
+            arg = static_cast<uint32_t>(std::stoul(value.substr(colon + 1)));
+        } catch (...) {
+            // 忽略解析错误，沿用原参数
+        }
+    }
+
+    if (name == "drop_newest") {
+        rule.policy = LogOverflowPolicy::DROP_NEWEST;
+    } else if (name == "drop_oldest") {
+        rule.policy = LogOverflowPolicy::DROP_OLDEST;
+    } else if (name == "block") {
+        rule.policy = LogOverflowPolicy::BLOCK;
+        if (arg > 0) {
+            rule.block_timeout_ms = arg;
+        }
+    } else if (name == "sample") {
+        rule.policy = LogOverflowPolicy::SAMPLE;
+        if (arg > 0) {
+            rule.sample_rate = arg;
+        }
+    }
+}
+
+// 按逗号拆分列表并去除首尾空白，忽略空项
+std::vector<std::string> splitList(const std::string& value) {
+    std::vector<std::string> items;
+    std::stringstream ss(value);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        item.erase(0, item.find_first_not_of(" \t"));
+        item.erase(item.find_last_not_of(" \t") + 1);
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+// 解析CPU列表，如"2,3"或"4-7"，忽略无法解析的项
+std::vector<int> parseCpuList(const std::string& value) {
+    std::vector<int> cpus;
+    for (const std::string& item : splitList(value)) {
+        try {
+            size_t dash = item.find('-');
+            if (dash == std::string::npos) {
+                cpus.push_back(std::stoi(item));
+                continue;
+            }
+            int first = std::stoi(item.substr(0, dash));
+            int last = std::stoi(item.substr(dash + 1));
+            for (int cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        } catch (...) {
+            // 忽略解析错误
+        }
+    }
+    return cpus;
+}
+
+/**
+ * @brief 崩溃时的行缓冲：在栈上攒满一块再写入文件（异步信号安全）
+ */
+class CrashLineWriter {
+public:
+    explicit CrashLineWriter(FileSink& file) : file_(file), length_(0) {}
+
+    ~CrashLineWriter() { flush(); }
+
+    // 追加数据，缓冲满时写出
+    void append(const char* data, size_t size) {
+        if (length_ + size > sizeof(buffer_)) {
+            flush();
+            if (size > sizeof(buffer_)) {
+                file_.appendOnCrash(data, size);
+                return;
+            }
+        }
+        std::memcpy(buffer_ + length_, data, size);
+        length_ += size;
+    }
+
+    void append(const char* text) { append(text, std::strlen(text)); }
+
+    // 二进制条目写出函数
+    static void write(void* context, const char* data, size_t size) {
+        static_cast<CrashLineWriter*>(context)->append(data, size);
+    }
+
+    // 写出缓冲
+    void flush() {
+        if (length_ > 0) {
+            file_.appendOnCrash(buffer_, length_);
+            length_ = 0;
+        }
+    }
+
+private:
+    FileSink& file_;
+    char buffer_[4096];
+    size_t length_;
+};
+
+// 当前线程的本机句柄（异步信号安全，崩溃处理中与写入线程比较）
+uintptr_t currentThreadHandle() {
+#ifdef _WIN32
+    return static_cast<uintptr_t>(GetCurrentThreadId());
+#else
+    pthread_t self = pthread_self();
+    uintptr_t handle = 0;
+    std::memcpy(&handle, &self, std::min(sizeof(handle), sizeof(self)));
+    return handle;
+#endif
+}
+
+// 自旋等待时让出流水线资源
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#else
+    std::this_thread::yield();
+#endif
+}
+
+} // namespace
+
 // 格式化字符串实现
 std::string formatLog(const char* format, ...) {
     va_list args;
@@ -56,55 +343,280 @@ std::string formatLog(const char* format, ...) {
     return std::string(buf.data());
 }
 
-// LogStream构造函数
-LogStream::LogStream(LogLevel level, const std::string& level_str,
-                  const char* file, int line, const char* func,
-                  const std::string& module)
-    : level_(level), level_str_(level_str),
-      file_(file), line_(line), func_(func), module_(module) {}
+namespace {
+
+// 追加到std::string的输出缓冲，流式日志回退到std::ostream时使用
+class StringAppendBuf : public std::streambuf {
+public:
+    explicit StringAppendBuf(std::string& target) : target_(target) {}
+
+protected:
+    int_type overflow(int_type ch) override {
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            target_.push_back(traits_type::to_char_type(ch));
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    std::streamsize xsputn(const char* data, std::streamsize size) override {
+        target_.append(data, static_cast<size_t>(size));
+        return size;
+    }
+
+private:
+    std::string& target_;
+};
+
+// 流式日志的线程本地状态：复用的格式化缓冲与绑定它的std::ostream
+struct LogStreamContext {
+    std::string buffer;
+    StringAppendBuf streambuf{buffer};
+    std::ostream stream{&streambuf};
+
+    LogStreamContext() {
+        buffer.reserve(512);
+    }
+};
+
+LogStreamContext& logStreamContext() {
+    thread_local LogStreamContext context;
+    return context;
+}
+
+} // namespace
+
+// LogStream构造函数：先写入模块与调用点前缀
+LogStream::LogStream(LogLevel level, const char* /*level_str*/,
+                     const char* file, int line, const char* func,
+                     const char* module)
+    : level_(level), module_(module) {
+    beginRecord(file, line, func);
+}
+
+// LogStream构造函数：写入指定日志器
+LogStream::LogStream(AsyncLogger& logger, LogLevel level, const char* file, int line, const char* func)
+    : logger_(&logger), level_(level), module_("") {
+    beginRecord(file, line, func);
+}
+
+// 记下起点并写入前缀
+void LogStream::beginRecord(const char* file, int line, const char* func) {
+    std::string& buffer = logStreamContext().buffer;
+    buffer_ = &buffer;
+    begin_ = buffer.size();
+    if (module_[0] != '\0') {
+        buffer += '[';
+        buffer += module_;
+        buffer += "] ";
+    }
+    buffer += '[';
+    buffer += file;
+    buffer += ':';
+    char line_buf[16];
+    buffer.append(line_buf, static_cast<size_t>(std::to_chars(line_buf, line_buf + sizeof(line_buf), line).ptr - line_buf));
+    buffer += ':';
+    buffer += func;
+    buffer += "] ";
+}
 
-// LogStream析构函数
+// LogStream析构函数：提交缓冲中本条日志的正文并截回起点
 LogStream::~LogStream() {
-    std::ostringstream oss;
-    if (!module_.empty()) {
-        oss << "[" << module_ << "] ";
+    bool enabled = logger_ ? logger_->isEnabled(level_)
+                           : AsyncLogger::moduleLevelEnabled(moduleId(module_), level_);
+    if (enabled) {
+        LogRecord record;
+        record.level = level_;
+        record.text.assign(buffer_->data() + begin_, buffer_->size() - begin_);
+        AsyncLogger& logger = logger_ ? *logger_ : AsyncLogger::getInstance();
+        logger.submit(std::move(record));
+    }
+    buffer_->resize(begin_);
+}
+
+// 回退到std::ostream
+std::ostream& LogStream::fallbackStream() {
+    if (!stream_) {
+        std::ostream& stream = logStreamContext().stream;
+        stream.clear();
+        stream.flags(std::ios_base::skipws | std::ios_base::dec);
+        stream.precision(6);
+        stream.width(0);
+        stream.fill(' ');
+        stream_ = &stream;
     }
-    oss << "[" << file_ << ":" << line_ << ":" << func_ << "] " << stream_.str();
-    AsyncLogger::getInstance().log(level_, level_str_, oss.str());
+    return *stream_;
 }
 
-// 单例实例获取
+// 默认日志器，构造前为nullptr（宏全部过滤）
+std::atomic<AsyncLogger*> AsyncLogger::default_logger_(nullptr);
+
+// 默认日志器获取
 AsyncLogger& AsyncLogger::getInstance() {
-    static AsyncLogger instance;
+    static AsyncLogger instance("default", true);
     return instance;
 }
 
+// 创建命名日志器
+std::shared_ptr<AsyncLogger> AsyncLogger::createLogger(const std::string& name, const LogConfig& config) {
+    if (name.empty()) {
+        return nullptr;
+    }
+    std::shared_ptr<AsyncLogger> logger;
+    {
+        LoggerRegistry& registry = loggerRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (const std::shared_ptr<AsyncLogger>& existing : registry.loggers) {
+            if (existing->name() == name) {
+                return nullptr;
+            }
+        }
+        logger.reset(new AsyncLogger(name, false));
+        registry.loggers.push_back(logger);
+    }
+    logger->init(config);
+    return logger;
+}
+
+// 按名称查找命名日志器
+std::shared_ptr<AsyncLogger> AsyncLogger::getLogger(const std::string& name) {
+    LoggerRegistry& registry = loggerRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (const std::shared_ptr<AsyncLogger>& logger : registry.loggers) {
+        if (logger->name() == name) {
+            return logger;
+        }
+    }
+    return nullptr;
+}
+
+// 注销命名日志器
+void AsyncLogger::dropLogger(const std::string& name) {
+    std::shared_ptr<AsyncLogger> dropped;
+    {
+        LoggerRegistry& registry = loggerRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto it = std::find_if(registry.loggers.begin(), registry.loggers.end(),
+                               [&](const std::shared_ptr<AsyncLogger>& logger) { return logger->name() == name; });
+        if (it == registry.loggers.end()) {
+            return;
+        }
+        dropped = std::move(*it);
+        registry.loggers.erase(it);
+    }
+    // 若这是最后一个引用，在登记表锁外析构（等待写入线程写完）
+}
+
 // 私有构造函数
-AsyncLogger::AsyncLogger()
-    : running_(false),
+AsyncLogger::AsyncLogger(const std::string& name, bool is_default)
+    : name_(name),
+      is_default_(is_default),
+      instance_id_(next_logger_id.fetch_add(1, std::memory_order_relaxed)),
+      running_(false),
       runtime_level_(LogLevel::OFF),
       config_(),
-      stats_(),
-      current_queue_size_(0),
-      last_rotate_date_(),
-      log_queue_(),
+      config_mutex_(),
       queue_mutex_(),
       queue_cv_(),
-      config_mutex_(),
-      stats_mutex_(),
-      log_file_() {}
+      log_queue_(),
+      ring_queue_(),
+      high_queue_(),
+      high_queue_size_(0),
+      high_ring_(),
+      staging_mutex_(),
+      staging_buffers_(),
+      staged_blocks_(),
+      consumer_waiting_(false),
+      spin_hits_(0),
+      writer_blocks_(0),
+      log_file_(),
+      crash_stop_(false),
+      writer_parked_(false),
+      writer_thread_(0),
+      total_logs_(),
+      dropped_logs_(),
+      enqueue_histogram_(),
+      total_write_time_(0),
+      max_queue_size_(0),
+      current_queue_size_(0),
+      blocked_logs_(),
+      filtered_logs_(0),
+      file_messages_(0),
+      file_bytes_(0),
+      file_write_ns_(0),
+      file_max_write_ns_(0),
+      file_write_histogram_(),
+      lane_logs_(),
+      lane_wait_us_(),
+      lane_max_wait_us_(),
+      lane_wait_histogram_(),
+      queue_capacity_bytes_(0),
+      queued_bytes_(0),
+      evict_bytes_(0),
+      space_waiters_(0),
+      enabled_level_(-1),
+      module_default_level_(MODULE_LEVEL_GLOBAL) {
+    for (std::atomic<uint64_t>& slot : module_levels_) {
+        slot.store(0, std::memory_order_relaxed);
+    }
+    if (is_default_) {
+        default_logger_.store(this, std::memory_order_release);
+    }
+}
 
 // 析构函数
 AsyncLogger::~AsyncLogger() {
+    if (crash_registered_) {
+        unregisterCrashCallback(this);
+    }
     running_ = false;
-    queue_cv_.notify_one(); // 唤醒后台线程
+    publishLevel();
+    {
+        // 持锁通知，避免后台线程检查条件后、阻塞前错过唤醒
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        queue_cv_.notify_one(); // 唤醒后台线程
+    }
+    {
+        // 唤醒等待队列空间的调用线程
+        std::lock_guard<std::mutex> lock(space_mutex_);
+        space_cv_.notify_all();
+    }
 
     if (log_thread_.joinable()) {
         log_thread_.join();
     }
 
-    if (log_file_.is_open()) {
-        log_file_.close();
+    // 各线程的暂存缓冲登记项由所属线程下次查找时移除
+    {
+        std::lock_guard<std::mutex> lock(staging_mutex_);
+        for (const std::shared_ptr<StagingBuffer>& buffer : staging_buffers_) {
+            buffer->detached.store(true, std::memory_order_relaxed);
+        }
+        staging_buffers_.clear();
+    }
+    if (is_default_) {
+        default_logger_.store(nullptr, std::memory_order_release);
+    }
+
+    if (log_file_) {
+        log_file_->close();
+    }
+
+    // 写完各输出通道队列中的日志
+    std::shared_ptr<const std::vector<std::shared_ptr<SinkChannel>>> channels = std::atomic_load(&sinks_);
+    if (channels) {
+        for (const std::shared_ptr<SinkChannel>& channel : *channels) {
+            channel->stop();
+        }
+    }
+
+    // 等待维护线程完成剩余任务
+    {
+        std::lock_guard<std::mutex> lock(maintenance_mutex_);
+        maintenance_stop_ = true;
+        maintenance_cv_.notify_one();
+    }
+    if (maintenance_thread_.joinable()) {
+        maintenance_thread_.join();
     }
 }
 
@@ -113,6 +625,12 @@ void AsyncLogger::init(const LogConfig& config) {
     std::lock_guard<std::mutex> lock(config_mutex_);
     config_ = config;
     runtime_level_.store(config.runtime_level);
+    publishLevel();
+    applyOverflowConfig(config_);
+    applyModuleConfig(config_);
+    applyKeywordConfig(config_);
+    applySinkConfig(config_);
+    publishConfig();
 
     // Windows启用虚拟终端支持颜色和设置UTF-8编码
 #ifdef _WIN32
@@ -132,31 +650,144 @@ void AsyncLogger::init(const LogConfig& config) {
     }
 #endif
 
-    // 初始化日志文件
-    if (config_.enable_file) {
-        log_file_.open(config_.log_file, std::ios::out | std::ios::app);
-        if (!log_file_.is_open()) {
+    // 初始化日志文件（后台线程已运行时由它按新快照重新打开）
+    if (config_.enable_file && !running_) {
+        openLogFile(config_);
+        if (!log_file_ || !log_file_->isOpen()) {
             std::cerr << "AsyncLogger: Failed to open log file: " << config_.log_file << std::endl;
         }
     }
 
-    // 初始化轮转日期
-    time_t now = time(nullptr);
-    struct tm local_tm;
-#ifdef _WIN32
-    localtime_s(&local_tm, &now);
-#else
-    localtime_r(&now, &local_tm);
-#endif
-    char date_buf[16];
-    strftime(date_buf, sizeof(date_buf), "%Y%m%d", &local_tm);
-    last_rotate_date_ = date_buf;
-
     // 启动后台线程
-    if (!running_) {
-        running_ = true;
-        log_thread_ = std::thread(&AsyncLogger::processLogs, this);
+    startWorker();
+}
+
+// 创建日志队列并启动后台线程
+void AsyncLogger::startWorker() {
+    if (running_) {
+        return;
+    }
+
+    // 队列类型只在后台线程启动前确定，运行期间不切换。
+    // numa_local_queue时环形队列由写入线程绑核后创建：构造时逐个初始化槽位，
+    // 按首次访问分配策略，内存落在写入线程所在的NUMA节点
+    bool local_queues = config_.numa_local_queue && config_.queue_type == LogQueueType::LOCKFREE_RING;
+    if (local_queues) {
+        ring_queue_.reset();
+        high_ring_.reset();
+    } else {
+        createQueues();
+    }
+    spin_wait_ = config_.wait_strategy == LogWaitStrategy::SPIN_THEN_BLOCK &&
+                 config_.queue_type == LogQueueType::LOCKFREE_RING && !config_.enable_staging;
+    spin_limit_ns_ = static_cast<uint64_t>(config_.spin_wait_us) * 1000;
+    spin_budget_ns_ = spin_limit_ns_;
+
+    // 暂存缓冲模式优先于queue_type，日志以块为单位提交
+    staging_enabled_ = config_.enable_staging;
+    staging_batch_size_ = std::max<size_t>(1, config_.staging_batch_size);
+    staging_flush_us_ = static_cast<uint64_t>(config_.staging_flush_ms) * 1000;
+    // 限频调用点登记表是进程级的，只由默认日志器汇报
+    suppressed_report_us_ = is_default_ ? static_cast<uint64_t>(config_.suppressed_report_ms) * 1000 : 0;
+    last_report_us_ = nowMicros();
+
+    // TSC模式：启动前校准一次，此后由后台线程周期性重新锚定
+    tsc_timestamps_ = (config_.timestamp_source == LogTimestampSource::TSC);
+    staging_flush_span_ = staging_flush_us_;
+    if (tsc_timestamps_) {
+        calibrateTicks(true);
+        staging_flush_span_ = static_cast<uint64_t>(staging_flush_us_ * ticks_per_us_);
+    }
+
+    running_ = true;
+    std::promise<void> queues_ready;
+    std::future<void> ready = queues_ready.get_future();
+    log_thread_ = std::thread([this, local_queues, &queues_ready]() {
+        applyWriterThreadConfig();
+        if (local_queues) {
+            createQueues();
+        }
+        queues_ready.set_value();
+        processLogs();
+    });
+    ready.wait();
+    publishLevel();
+
+    // 崩溃处理：进程收到致命信号时由信号处理函数写出本日志器队列中的日志
+    if (config_.crash_handler && !crash_registered_) {
+        if (!installCrashHandler()) {
+            std::cerr << "AsyncLogger: Failed to install crash handler for some signals" << std::endl;
+        }
+        crash_registered_ = registerCrashCallback(&AsyncLogger::onCrash, this);
+        if (!crash_registered_) {
+            std::cerr << "AsyncLogger: Too many loggers registered for crash flushing" << std::endl;
+        }
+    }
+}
+
+// 按配置创建环形队列
+void AsyncLogger::createQueues() {
+    if (config_.queue_type == LogQueueType::LOCKFREE_RING) {
+        ring_queue_.reset(new MpscRingBuffer<LogRecord>(config_.ring_capacity));
+        // 暂存模式下高优先级日志走带锁队列，以便直接唤醒后台线程
+        if (!config_.enable_staging) {
+            high_ring_.reset(new MpscRingBuffer<LogRecord>(
+                std::max<size_t>(config_.ring_capacity / 4, 1024)));
+        } else {
+            high_ring_.reset();
+        }
+    } else {
+        ring_queue_.reset();
+        high_ring_.reset();
+    }
+}
+
+// 设置写入线程的CPU亲和性与优先级
+void AsyncLogger::applyWriterThreadConfig() {
+#ifdef _WIN32
+    if (!config_.writer_cpus.empty()) {
+        DWORD_PTR mask = 0;
+        for (int cpu : config_.writer_cpus) {
+            if (cpu >= 0 && cpu < static_cast<int>(sizeof(DWORD_PTR) * 8)) {
+                mask |= DWORD_PTR(1) << cpu;
+            }
+        }
+        if (mask == 0 || SetThreadAffinityMask(GetCurrentThread(), mask) == 0) {
+            std::cerr << "AsyncLogger: Failed to set writer thread affinity" << std::endl;
+        }
+    }
+    if (config_.writer_nice != 0) {
+        // nice值映射到最接近的线程优先级档位
+        int priority = config_.writer_nice >= 10 ? THREAD_PRIORITY_LOWEST
+                     : config_.writer_nice > 0  ? THREAD_PRIORITY_BELOW_NORMAL
+                                                : THREAD_PRIORITY_ABOVE_NORMAL;
+        if (!SetThreadPriority(GetCurrentThread(), priority)) {
+            std::cerr << "AsyncLogger: Failed to set writer thread priority" << std::endl;
+        }
     }
+#elif defined(__linux__)
+    if (!config_.writer_cpus.empty()) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        for (int cpu : config_.writer_cpus) {
+            if (cpu >= 0 && cpu < CPU_SETSIZE) {
+                CPU_SET(cpu, &cpus);
+            }
+        }
+        int rc = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+        if (rc != 0) {
+            std::cerr << "AsyncLogger: Failed to set writer thread affinity: "
+                      << std::strerror(rc) << std::endl;
+        }
+    }
+    if (config_.writer_nice != 0) {
+        // Linux上nice值按线程生效
+        if (setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), config_.writer_nice) != 0) {
+            std::cerr << "AsyncLogger: Failed to set writer thread nice value: "
+                      << std::strerror(errno) << std::endl;
+        }
+    }
+#endif
 }
 
 // 从配置文件加载配置
@@ -207,6 +838,7 @@ bool AsyncLogger::loadConfigFromFile(const std::string& config_file) {
             if (key == "level") {
                 config_.runtime_level = parseLogLevel(value);
                 runtime_level_.store(config_.runtime_level);
+                publishLevel();
             } else if (key == "enable_console") {
                 config_.enable_console = (value == "true" || value == "1" || value == "yes");
             } else if (key == "enable_file") {
@@ -227,15 +859,127 @@ bool AsyncLogger::loadConfigFromFile(const std::string& config_file) {
                 } catch (...) {
                     // 忽略解析错误
                 }
+            } else if (key == "queue_type") {
+                config_.queue_type = (value == "ring" || value == "lockfree")
+                    ? LogQueueType::LOCKFREE_RING : LogQueueType::MUTEX_QUEUE;
+            } else if (key == "ring_capacity") {
+                try {
+                    config_.ring_capacity = std::stoul(value);
+                } catch (...) {
+                    // 忽略解析错误
+                }
+            } else if (key == "enable_staging") {
+                config_.enable_staging = (value == "true" || value == "1" || value == "yes");
+            } else if (key == "staging_batch_size") {
+                try {
+                    config_.staging_batch_size = std::stoul(value);
+                } catch (...) {
+                    // 忽略解析错误
+                }
+            } else if (key == "file_format") {
+                config_.file_format = (value == "binary")
+                    ? LogFileFormat::BINARY : LogFileFormat::TEXT;
+            } else if (key == "file_flush_bytes") {
+                try {
+                    config_.file_flush_bytes = std::stoul(value);
+                } catch (...) {
+                    // 忽略解析错误
+                }
+            } else if (key == "file_flush_interval_ms") {
+                try {
+                    config_.file_flush_interval_ms = static_cast<uint32_t>(std::stoul(value));
+                } catch (...) {
+                    // 忽略解析错误
+                }
+            } else if (key == "file_flush_on_error") {
+                config_.file_flush_on_error = (value == "true" || value == "1" || value == "yes");
+            } else if (key == "file_sink") {
+                config_.file_sink_type = (value == "mmap")
+                    ? LogFileSinkType::MMAP : LogFileSinkType::BUFFERED;
+            } else if (key == "mmap_segment_size") {
+                try {
+                    config_.mmap_segment_size = std::stoul(value) * 1024 * 1024; // MB转字节
+                } catch (...) {
+                    // 忽略解析错误
+                }
+            } else if (key == "queue_capacity") {
+                try {
+                    config_.queue_capacity_bytes = std::stoul(value) * 1024 * 1024; // MB转字节
+                } catch (...) {
+                    // 忽略解析错误
+                }
+            } else if (key == "overflow_warn") {
+                parseOverflowRule(value, config_.overflow_warn);
+            } else if (key == "overflow_info") {
+                parseOverflowRule(value, config_.overflow_info);
+            } else if (key == "overflow_debug") {
+                parseOverflowRule(value, config_.overflow_debug);
+            } else if (key == "suppressed_report_ms") {
+                try {
+                    config_.suppressed_report_ms = static_cast<uint32_t>(std::stoul(value));
+                } catch (...) {
+                    // 忽略解析错误
+                }
+            } else if (key == "sink_queue_capacity") {
+                try {
+                    config_.sink_queue_capacity = std::stoul(value);
+                } catch (...) {
+                    // 忽略解析错误
+                }
+            } else if (key == "kv_format") {
+                config_.kv_format = (value == "logfmt") ? LogKvFormat::LOGFMT : LogKvFormat::JSON;
+            } else if (key == "enable_modules") {
+                config_.enable_modules = splitList(value);
+            } else if (key == "module_levels") {
+                config_.module_levels = parseModuleLevels(value);
+            } else if (key == "filter_keywords") {
+                config_.filter_keywords = splitList(value);
+            } else if (key == "include_keywords") {
+                config_.include_keywords = splitList(value);
+            } else if (key == "compress_rotated") {
+                config_.compress_rotated = (value == "true" || value == "1" || value == "yes");
+            } else if (key == "timestamp_source") {
+                config_.timestamp_source = (value == "tsc")
+                    ? LogTimestampSource::TSC : LogTimestampSource::SYSTEM_CLOCK;
+            } else if (key == "staging_flush_ms") {
+                try {
+                    config_.staging_flush_ms = static_cast<uint32_t>(std::stoul(value));
+                } catch (...) {
+                    // 忽略解析错误
+                }
+            } else if (key == "writer_cpus") {
+                config_.writer_cpus = parseCpuList(value);
+            } else if (key == "writer_nice") {
+                try {
+                    config_.writer_nice = std::stoi(value);
+                } catch (...) {
+                    // 忽略解析错误
+                }
+            } else if (key == "numa_local_queue") {
+                config_.numa_local_queue = (value == "true" || value == "1" || value == "yes");
+            } else if (key == "wait_strategy") {
+                config_.wait_strategy = (value == "spin")
+                    ? LogWaitStrategy::SPIN_THEN_BLOCK : LogWaitStrategy::BLOCK;
+            } else if (key == "spin_wait_us") {
+                try {
+                    config_.spin_wait_us = static_cast<uint32_t>(std::stoul(value));
+                } catch (...) {
+                    // 忽略解析错误
+                }
+            } else if (key == "crash_handler") {
+                config_.crash_handler = (value == "true" || value == "1" || value == "yes");
             }
         }
     }
 
+    applyOverflowConfig(config_);
+    applyModuleConfig(config_);
+    applyKeywordConfig(config_);
+    applySinkConfig(config_);
+    publishConfig();
+
     // 启动后台线程
-    if (!running_) {
-        running_ = true;
-        log_thread_ = std::thread(&AsyncLogger::processLogs, this);
-    }
+    startWorker();
 
     return true;
 }
@@ -244,23 +988,102 @@ bool AsyncLogger::loadConfigFromFile(const std::string& config_file) {
 void AsyncLogger::setRuntimeLogLevel(LogLevel level) {
     if (level >= LogLevel::OFF && level <= LogLevel::DEBUG) {
         runtime_level_.store(level);
+        publishLevel();
     }
 }
 
-// 动态更新配置
-void AsyncLogger::updateConfig(const LogConfig& config) {
+// 发布级别检查读取的级别
+void AsyncLogger::publishLevel() {
+    int level = running_.load() ? static_cast<int>(runtime_level_.load()) : -1;
+    enabled_level_.store(level, std::memory_order_relaxed);
+}
+
+// 动态设置单个模块的运行时级别
+void AsyncLogger::setModuleLogLevel(const std::string& module, LogLevel level) {
+    if (module.empty() || level < LogLevel::OFF || level > LogLevel::DEBUG) {
+        return;
+    }
     std::lock_guard<std::mutex> lock(config_mutex_);
+    auto it = std::find_if(config_.module_levels.begin(), config_.module_levels.end(),
+                           [&](const LogModuleLevel& item) { return item.module == module; });
+    if (it != config_.module_levels.end()) {
+        it->level = level;
+    } else {
+        config_.module_levels.push_back({module, level});
+    }
+    applyModuleConfig(config_);
+    publishConfig();
+}
+
+// 重建模块级别表
+void AsyncLogger::applyModuleConfig(const LogConfig& config) {
+    // 先在本地按线性探测排好，再逐槽发布；更新期间个别日志可能按旧级别或默认级别判断
+    uint64_t table[MODULE_TABLE_SIZE] = {0};
+    auto insert = [&](const std::string& module, int level, bool overwrite) {
+        uint32_t id = moduleId(module.c_str());
+        if (id == 0) {
+            return;
+        }
+        for (size_t i = 0; i < MODULE_TABLE_SIZE; ++i) {
+            uint64_t& slot = table[(id + i) & (MODULE_TABLE_SIZE - 1)];
+            if (slot == 0 || static_cast<uint32_t>(slot >> 32) == id) {
+                if (slot == 0 || overwrite) {
+                    slot = (static_cast<uint64_t>(id) << 32) | static_cast<uint64_t>(level);
+                }
+                return;
+            }
+        }
+        // 表已满，该模块沿用默认级别
+    };
+    for (const LogModuleLevel& item : config.module_levels) {
+        insert(item.module, static_cast<int>(item.level), true);
+    }
+    for (const std::string& module : config.enable_modules) {
+        insert(module, MODULE_LEVEL_GLOBAL, false);
+    }
+
+    for (size_t i = 0; i < MODULE_TABLE_SIZE; ++i) {
+        module_levels_[i].store(table[i], std::memory_order_relaxed);
+    }
+    module_default_level_.store(config.enable_modules.empty() ? MODULE_LEVEL_GLOBAL
+                                                              : static_cast<int>(LogLevel::OFF),
+                                std::memory_order_relaxed);
+}
 
-    // 更新文件输出（如果路径变化）
-    if (config.enable_file && config.log_file != config_.log_file) {
-        if (log_file_.is_open()) {
-            log_file_.close();
+// 沿线性探测序列查找模块级别
+int AsyncLogger::findModuleLevel(uint32_t module_id) const {
+    for (size_t i = 1; i < MODULE_TABLE_SIZE; ++i) {
+        uint64_t entry = module_levels_[(module_id + i) & (MODULE_TABLE_SIZE - 1)].load(std::memory_order_relaxed);
+        if (static_cast<uint32_t>(entry >> 32) == module_id) {
+            return static_cast<int>(entry & 0xFF);
+        }
+        if (entry == 0) {
+            break;
         }
-        log_file_.open(config.log_file, std::ios::out | std::ios::app);
     }
+    return module_default_level_.load(std::memory_order_relaxed);
+}
+
+// 动态更新配置
+void AsyncLogger::updateConfig(const LogConfig& config) {
+    std::lock_guard<std::mutex> lock(config_mutex_);
 
+    // 后台线程运行时，文件路径、格式或输出方式的变化由它在取到新快照后处理；
+    // 这里只与上一份配置比较，不读取写入线程维护的file_format_等成员
+    bool reopen = config.log_file != config_.log_file || config.file_format != config_.file_format ||
+                  config.file_sink_type != config_.file_sink_type;
     config_ = config;
+    if (config.enable_file && reopen && !running_) {
+        openLogFile(config);
+    }
+    applyOverflowConfig(config);
+    applyModuleConfig(config);
+    applyKeywordConfig(config);
+    applySinkConfig(config);
+    publishConfig();
+
     runtime_level_.store(config.runtime_level);
+    publishLevel();
 }
 
 // 解析日志级别字符串
@@ -272,6 +1095,27 @@ LogLevel AsyncLogger::parseLogLevel(const std::string& level_str) {
     else return LogLevel::OFF;
 }
 
+// 解析模块级别列表
+std::vector<LogModuleLevel> AsyncLogger::parseModuleLevels(const std::string& value) {
+    std::vector<LogModuleLevel> levels;
+    for (const std::string& item : splitList(value)) {
+        size_t eq_pos = item.find('=');
+        if (eq_pos == std::string::npos) {
+            continue;
+        }
+        LogModuleLevel entry;
+        entry.module = item.substr(0, eq_pos);
+        entry.module.erase(entry.module.find_last_not_of(" \t") + 1);
+        std::string level = item.substr(eq_pos + 1);
+        level.erase(0, level.find_first_not_of(" \t"));
+        entry.level = parseLogLevel(level);
+        if (!entry.module.empty()) {
+            levels.push_back(entry);
+        }
+    }
+    return levels;
+}
+
 // 从环境变量加载配置
 void AsyncLogger::loadConfigFromEnv() {
     std::lock_guard<std::mutex> lock(config_mutex_);
@@ -281,6 +1125,7 @@ void AsyncLogger::loadConfigFromEnv() {
     if (level_env) {
         LogLevel level = parseLogLevel(level_env);
         runtime_level_.store(level);
+        publishLevel();
         config_.runtime_level = level;
     }
 
@@ -288,105 +1133,92 @@ void AsyncLogger::loadConfigFromEnv() {
     const char* color_env = getenv("YALGO_LOG_COLOR");
     if (color_env) {
         config_.enable_color = (std::string(color_env) == "1" || std::string(color_env) == "true");
+        applySinkConfig(config_);
     }
+
+    // 3. 加载模块级别，如 "earth=DEBUG,log=WARN"
+    const char* modules_env = getenv("YALGO_LOG_MODULES");
+    if (modules_env) {
+        config_.module_levels = parseModuleLevels(modules_env);
+        applyModuleConfig(config_);
+    }
+    publishConfig();
 }
 
 // 获取格式化时间
-std::string AsyncLogger::getFormattedTime() {
-    try {
-        auto now = std::chrono::system_clock::now();
-        auto time_t_now = std::chrono::system_clock::to_time_t(now);
-        auto micros = std::chrono::duration_cast<std::chrono::microseconds>(
-            now.time_since_epoch()
-        ) % 1000000;
-
-        char time_buf[64] = {0};
+std::string AsyncLogger::getFormattedTime(uint64_t timestamp_us) {
+    char time_buf[TIME_BUFFER_SIZE];
+    return std::string(time_buf, formatTimestamp(timestamp_us, time_buf));
+}
+
+// 格式化时间戳到缓冲区
+size_t AsyncLogger::formatTimestamp(uint64_t timestamp_us, char* buf) {
+    int64_t second = static_cast<int64_t>(timestamp_us / 1000000);
+    uint32_t micros = static_cast<uint32_t>(timestamp_us % 1000000);
+
+    // 同一秒内只改写微秒部分，跨秒时才重新做本地时间转换
+    TimeFormatCache& cache = time_cache;
+    if (second != cache.second) {
+        time_t time_t_now = static_cast<time_t>(second);
         struct tm local_tm;
 
         // 线程安全的本地时间转换
         #ifdef _WIN32
             if (localtime_s(&local_tm, &time_t_now) != 0) {
-                snprintf(time_buf, sizeof(time_buf), "TimeError[%d]", errno);
-                return time_buf;
+                cache.second = -1;
+                return snprintf(buf, TIME_BUFFER_SIZE, "TimeError[%d]", errno);
             }
         #else
             if (localtime_r(&time_t_now, &local_tm) == nullptr) {
-                snprintf(time_buf, sizeof(time_buf), "TimeError[%d]", errno);
-                return time_buf;
+                cache.second = -1;
+                return snprintf(buf, TIME_BUFFER_SIZE, "TimeError[%d]", errno);
             }
         #endif
 
-        std::ostringstream oss;
-        std::strftime(time_buf, sizeof(time_buf), "%Y-%m-%d %H:%M:%S", &local_tm);
-        oss << time_buf << "." << std::setfill('0') << std::setw(6) << micros.count();
-
-        return oss.str();
-    }
-    catch (const std::exception& e) {
-        return "TimeError[" + std::string(e.what()) + "]";
+        size_t len = std::strftime(cache.text, sizeof(cache.text), "%Y-%m-%d %H:%M:%S", &local_tm);
+        cache.text[len] = '.';
+        cache.length = len + 7;
+        cache.second = second;
     }
-    catch (...) {
-        return "TimeError[Unknown]";
-    }
-}
 
-// 获取控制台颜色码
-std::string AsyncLogger::getColorCode(LogLevel level) const {
-    std::lock_guard<std::mutex> lock(config_mutex_);
-    if (!config_.enable_color) {
-        return "";
-    }
+    writeMicros(cache.text + cache.length - 6, micros);
+    std::memcpy(buf, cache.text, cache.length);
+    return cache.length;
+}
 
-    // ANSI颜色转义序列
+// 获取日志级别字符串
+const char* AsyncLogger::levelToString(LogLevel level) {
     switch (level) {
-        case LogLevel::LOG_ERROR: return "\033[31m"; // 红色
-        case LogLevel::WARN:  return "\033[33m"; // 黄色
-        case LogLevel::INFO:  return "\033[32m"; // 绿色
-        case LogLevel::DEBUG: return "\033[36m"; // 青色
-        default:              return "\033[0m";  // 默认颜色
+        case LogLevel::LOG_ERROR: return "ERROR";
+        case LogLevel::WARN:  return "WARN";
+        case LogLevel::INFO:  return "INFO";
+        case LogLevel::DEBUG: return "DEBUG";
+        default:              return "OFF";
     }
 }
 
 // 检查日志文件轮转
-void AsyncLogger::checkLogRotation() {
-    std::lock_guard<std::mutex> lock(config_mutex_);
-    if (!config_.enable_file || !log_file_.is_open()) {
-        return;
-    }
-
-    // 1. 按天轮转（优先级更高）
-    if (config_.rotate_by_day) {
-        time_t now = time(nullptr);
-        struct tm local_tm;
-#ifdef _WIN32
-        localtime_s(&local_tm, &now);
-#else
-        localtime_r(&now, &local_tm);
-#endif
-        char date_buf[16];
-        strftime(date_buf, sizeof(date_buf), "%Y%m%d", &local_tm);
-        std::string current_date = date_buf;
-
-        if (current_date != last_rotate_date_) {
-            rotateLogFile();
-            last_rotate_date_ = current_date;
+void AsyncLogger::checkLogRotation(const LogConfig& config, uint64_t now_us) {
+    // 1. 按天轮转（优先级更高）：只与预先算好的下一个零点比较
+    if (config.rotate_by_day) {
+        if (next_rotate_us_ == 0) {
+            next_rotate_us_ = nextMidnightMicros(now_us);
+        } else if (now_us >= next_rotate_us_) {
+            rotateLogFile(config);
+            next_rotate_us_ = nextMidnightMicros(now_us);
             return;
         }
     }
 
-    // 2. 按大小轮转
-    log_file_.seekp(0, std::ios::end);
-    size_t current_size = log_file_.tellp();
-    if (current_size >= config_.max_file_size) {
-        rotateLogFile();
+    // 2. 按大小轮转：文件输出自行累计字节数
+    if (log_file_->size() >= config.max_file_size) {
+        rotateLogFile(config);
     }
 }
 
 // 执行日志文件轮转
-void AsyncLogger::rotateLogFile() {
-    log_file_.close();
-
-    // 生成新文件名（原文件名+时间戳）
+void AsyncLogger::rotateLogFile(const LogConfig& config) {
+    // 生成新文件名（原文件名+时间戳），同一秒内多次轮转时追加序号
     time_t now = time(nullptr);
     struct tm local_tm;
 #ifdef _WIN32
@@ -397,192 +1229,1664 @@ void AsyncLogger::rotateLogFile() {
     char time_buf[32];
     strftime(time_buf, sizeof(time_buf), "%Y%m%d_%H%M%S", &local_tm);
 
-    std::string new_filename = config_.log_file + "_" + time_buf;
+    const std::string& path = log_file_->path();
+    std::string new_filename = path + "_" + time_buf;
+    std::error_code ec;
+    for (int seq = 1; std::filesystem::exists(new_filename, ec); ++seq) {
+        new_filename = path + "_" + time_buf + "_" + std::to_string(seq);
+    }
+
+    // 改名并在原路径上继续写入；内存映射输出直接切换到预分配好的备用段
+    log_file_->rotate(new_filename);
+    startLogFile();
+
+    // 历史文件压缩与清理放到维护线程，不阻塞日志写入
+    bool compress = config.compress_rotated;
+    int max_backup_files = config.max_backup_files;
+    if (compress || max_backup_files > 0) {
+        scheduleMaintenance([path, new_filename, compress, max_backup_files]() {
+            if (compress) {
+                compressLogSegment(new_filename, new_filename + COMPRESSED_SEGMENT_SUFFIX);
+            }
+            if (max_backup_files > 0) {
+                pruneBackupFiles(path, max_backup_files);
+            }
+        });
+    }
+}
+
+// 计算下一个本地零点
+uint64_t AsyncLogger::nextMidnightMicros(uint64_t now_us) {
+    time_t now = static_cast<time_t>(now_us / 1000000);
+    struct tm local_tm;
 #ifdef _WIN32
-    MoveFileA(config_.log_file.c_str(), new_filename.c_str());
+    localtime_s(&local_tm, &now);
 #else
-    rename(config_.log_file.c_str(), new_filename.c_str());
+    localtime_r(&now, &local_tm);
 #endif
+    local_tm.tm_hour = 0;
+    local_tm.tm_min = 0;
+    local_tm.tm_sec = 0;
+    local_tm.tm_mday += 1;
+    local_tm.tm_isdst = -1;
+    time_t midnight = mktime(&local_tm);
+    if (midnight == static_cast<time_t>(-1) || midnight <= now) {
+        return now_us + 24ULL * 3600 * 1000000;
+    }
+    return static_cast<uint64_t>(midnight) * 1000000;
+}
+
+// 清理超出数量的历史日志文件
+void AsyncLogger::pruneBackupFiles(const std::string& log_path, int max_backup_files) {
+    namespace fs = std::filesystem;
+    fs::path base(log_path);
+    fs::path dir = base.has_parent_path() ? base.parent_path() : fs::path(".");
+    std::string prefix = base.filename().string() + "_";
+
+    // 历史文件名为"<日志文件名>_YYYYmmdd_HHMMSS[_序号]"，按(时间, 序号)排序
+    const size_t stamp_len = 15;
+    struct Backup {
+        std::string stamp;
+        unsigned long seq;
+        std::string name;
+    };
+    std::vector<Backup> backups;
+    std::error_code ec;
+    for (fs::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+        std::string name = it->path().filename().string();
+        if (name.size() < prefix.size() + stamp_len || name.compare(0, prefix.size(), prefix) != 0 ||
+            !std::isdigit(static_cast<unsigned char>(name[prefix.size()]))) {
+            continue;
+        }
+        Backup backup;
+        backup.stamp = name.substr(prefix.size(), stamp_len);
+        backup.seq = std::strtoul(name.c_str() + prefix.size() + stamp_len +
+                                  (name.size() > prefix.size() + stamp_len), nullptr, 10);
+        backup.name = name;
+        backups.push_back(std::move(backup));
+    }
+    if (backups.size() <= static_cast<size_t>(max_backup_files)) {
+        return;
+    }
+
+    std::sort(backups.begin(), backups.end(), [](const Backup& a, const Backup& b) {
+        return a.stamp != b.stamp ? a.stamp < b.stamp : a.seq < b.seq;
+    });
+    size_t excess = backups.size() - static_cast<size_t>(max_backup_files);
+    for (size_t i = 0; i < excess; ++i) {
+        fs::remove(dir / backups[i].name, ec);
+    }
+}
 
-    // 重新打开新日志文件
-    log_file_.open(config_.log_file, std::ios::out | std::ios::app);
+// 提交维护任务
+void AsyncLogger::scheduleMaintenance(std::function<void()> task) {
+    std::lock_guard<std::mutex> lock(maintenance_mutex_);
+    maintenance_tasks_.push_back(std::move(task));
+    if (!maintenance_thread_.joinable()) {
+        maintenance_stop_ = false;
+        maintenance_thread_ = std::thread(&AsyncLogger::runMaintenance, this);
+    }
+    maintenance_cv_.notify_one();
+}
+
+// 维护线程主循环
+void AsyncLogger::runMaintenance() {
+    // 压缩等维护工作让位于业务线程和日志写入线程
+#ifdef _WIN32
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+#elif defined(__linux__)
+    setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 19);
+#endif
+
+    std::unique_lock<std::mutex> lock(maintenance_mutex_);
+    while (true) {
+        maintenance_cv_.wait(lock, [this]() {
+            return !maintenance_tasks_.empty() || maintenance_stop_;
+        });
+        if (maintenance_tasks_.empty()) {
+            return;
+        }
+        std::function<void()> task = std::move(maintenance_tasks_.front());
+        maintenance_tasks_.pop_front();
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
+
+// 打开日志文件
+void AsyncLogger::openLogFile(const LogConfig& config) {
+    file_format_ = config.file_format;
+
+    // 输出方式变化时重建文件输出
+    if (!log_file_ || file_sink_type_ != config.file_sink_type) {
+        if (log_file_) {
+            log_file_->close();
+        }
+        file_sink_type_ = config.file_sink_type;
+        if (file_sink_type_ == LogFileSinkType::MMAP) {
+            log_file_.reset(new MmapFileSink(config.mmap_segment_size));
+        } else {
+            log_file_.reset(new BufferedFileSink());
+        }
+    }
+
+    log_file_->open(config.log_file);
+    startLogFile();
+}
+
+// 发布配置快照
+void AsyncLogger::publishConfig() {
+    std::shared_ptr<const LogConfig> snapshot = std::make_shared<const LogConfig>(config_);
+    std::atomic_store(&config_snapshot_, snapshot);
+}
+
+// 写入线程刷新配置快照
+void AsyncLogger::refreshWriterConfig() {
+    std::shared_ptr<const LogConfig> config = std::atomic_load(&config_snapshot_);
+    if (config == writer_config_) {
+        return;
+    }
+    writer_config_ = std::move(config);
+    const LogConfig& current = *writer_config_;
+    if (current.enable_file &&
+        (!log_file_ || !log_file_->isOpen() || log_file_->path() != current.log_file ||
+         file_format_ != current.file_format || file_sink_type_ != current.file_sink_type)) {
+        if (log_file_ && log_file_->pendingBytes() > 0) {
+            flushLogFile();
+        }
+        openLogFile(current);
+        if (!log_file_->isOpen()) {
+            std::cerr << "AsyncLogger: Failed to open log file: " << current.log_file << std::endl;
+        }
+    }
+    file_flush_interval_us_ = static_cast<uint64_t>(current.file_flush_interval_ms) * 1000;
+}
+
+// 准备新打开的日志文件
+void AsyncLogger::startLogFile() {
+    written_sites_.clear();
+    if (!log_file_->isOpen() || file_format_ != LogFileFormat::BINARY) {
+        return;
+    }
+
+    // 内存映射文件崩溃后遗留零填充尾部，按零字节定位可能截掉最后一个条目，按条目重新定位
+    if (file_sink_type_ == LogFileSinkType::MMAP && log_file_->size() > 0) {
+        MmapFileSink* mapped = static_cast<MmapFileSink*>(log_file_.get());
+        size_t valid = BinaryLogDecoder::validLength(mapped->data(), mapped->capacity());
+        if (valid > 0) {
+            mapped->setCursor(valid);
+        }
+    }
+
+    // 二进制新文件写入文件头；追加到已有文件时格式串定义会在首次使用前重新写入
+    if (log_file_->size() == 0) {
+        std::string header;
+        encodeBinaryFileHeader(header);
+        log_file_->append(header.data(), header.size());
+        log_file_->flush();
+    }
 }
 
 // 提交日志消息
-void AsyncLogger::log(LogLevel level, const std::string& level_str, const std::string& message) {
+void AsyncLogger::log(LogLevel level, const std::string& /*level_str*/, const std::string& message) {
     // 运行时级别检查
-    if (!running_ || level > runtime_level_.load()) {
+    if (!isEnabled(level)) {
+        return;
+    }
+
+    LogRecord record;
+    record.level = level;
+    record.text = message;
+    submit(std::move(record));
+}
+
+// 提交模块日志
+void AsyncLogger::logModule(uint32_t module_id, LogLevel level, const std::string& message) {
+    // 模块级别检查（宏已检查过一次，这里兼顾直接调用）
+    if (!isModuleEnabled(module_id, level)) {
+        return;
+    }
+
+    LogRecord record;
+    record.level = level;
+    record.text = message;
+    submit(std::move(record));
+}
+
+// 提交日志记录，按间隔采样提交耗时
+void AsyncLogger::submit(LogRecord&& record) {
+    // 读一次时钟约数十纳秒：每个调用线程每ENQUEUE_SAMPLE_INTERVAL条只计时一条
+    thread_local uint32_t countdown = 0;
+    if (countdown != 0) {
+        --countdown;
+        enqueueRecord(std::move(record));
         return;
     }
+    countdown = ENQUEUE_SAMPLE_INTERVAL - 1;
+    uint64_t start = steadyNanos();
+    enqueueRecord(std::move(record));
+    enqueue_histogram_.record(steadyNanos() - start);
+}
 
+// 按级别与队列模式入队
+void AsyncLogger::enqueueRecord(LogRecord&& record) {
     // 性能统计：总日志数
-    {
-        std::lock_guard<std::mutex> lock(stats_mutex_);
-        stats_.total_logs++;
+    total_logs_.add();
+
+    // 调用线程只采集时间戳，时间和级别前缀由后台线程格式化
+    record.timestamp_us = captureTimestamp();
+
+    // 按字节预留队列容量，不足时按级别策略处理
+    size_t bytes = recordBytes(record);
+    if (!admitRecord(record.level, bytes)) {
+        dropped_logs_.add();
+        return;
     }
 
-    // 格式化最终日志消息（添加时间戳）
-    std::string time_str = getFormattedTime();
-    std::ostringstream oss;
-    oss << "[" << time_str << "] [" << level_str << "] " << message;
-    std::string final_msg = oss.str();
+    // 标记提交线程与线程内序号，写入线程据此把同一线程更早的普通日志写在高优先级日志之前
+    SubmitOrder& order = submit_order;
+    if (order.tag == 0) {
+        order.tag = next_thread_tag.fetch_add(1, std::memory_order_relaxed);
+    }
+    record.thread_tag = order.tag;
+    record.thread_seq = ++order.seq;
 
-    // 入队（加锁保护）
-    std::lock_guard<std::mutex> lock(queue_mutex_);
-    // 队列满时丢弃日志
-    if (log_queue_.size() >= MAX_QUEUE_SIZE) {
-        std::lock_guard<std::mutex> s_lock(stats_mutex_);
-        stats_.dropped_logs++;
+    // 错误、警告日志走高优先级通道，不排在大量信息、调试日志之后
+    if (record.level <= LogLevel::WARN) {
+        enqueueHighLane(std::move(record), bytes);
+        return;
+    }
+
+    // 暂存缓冲模式：先写入线程本地缓冲，按块提交
+    if (staging_enabled_) {
+        stageRecord(std::move(record));
         return;
     }
-    log_queue_.push(final_msg);
+
+    // 无锁环形队列：仅在后台线程准备休眠时才加锁唤醒
+    if (ring_queue_) {
+        if (!pushRing(*ring_queue_, std::move(record))) {
+            releaseQueueBytes(bytes);
+            dropped_logs_.add();
+            return;
+        }
+        updateMaxQueueSize(ring_queue_->sizeApprox());
+        wakeConsumer();
+        return;
+    }
+
+    // 入队（加锁保护，容量已在admitRecord中预留）
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    log_queue_.push_back(std::move(record));
     current_queue_size_ = log_queue_.size();
     // 更新最大队列长度
-    {
-        std::lock_guard<std::mutex> s_lock(stats_mutex_);
-        if (current_queue_size_ > stats_.max_queue_size) {
-            stats_.max_queue_size = current_queue_size_;
+    updateMaxQueueSize(current_queue_size_);
+    queue_cv_.notify_one();
+}
+
+// 写入无锁环形队列
+bool AsyncLogger::pushRing(MpscRingBuffer<LogRecord>& ring, LogRecord&& record) {
+    if (ring.tryPush(std::move(record))) {
+        return true;
+    }
+    // 槽位耗尽：错误日志在容量条件变量上等待后台线程取出一批日志，其余级别与写入线程自己的日志丢弃
+    if (record.level != LogLevel::LOG_ERROR || tls_writer_thread) {
+        return false;
+    }
+    blocked_logs_.add();
+    bool pushed = false;
+    std::unique_lock<std::mutex> lock(space_mutex_);
+    space_waiters_.fetch_add(1);
+    // 后台线程每取出一批在releaseQueueBytes中唤醒；槽位与字节数是两个原子量，限时等待兜底
+    while (!(pushed = ring.tryPush(std::move(record))) && running_) {
+        space_cv_.wait_for(lock, std::chrono::milliseconds(1));
+    }
+    space_waiters_.fetch_sub(1);
+    return pushed;
+}
+
+// 唤醒后台线程
+void AsyncLogger::wakeConsumer() {
+    // 与dequeueLogs中的栅栏配对，保证入队与consumer_waiting_的检查不会同时错过
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (consumer_waiting_.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        queue_cv_.notify_one();
+    }
+}
+
+// 写入高优先级通道
+void AsyncLogger::enqueueHighLane(LogRecord&& record, size_t bytes) {
+    if (high_ring_) {
+        if (!pushRing(*high_ring_, std::move(record))) {
+            releaseQueueBytes(bytes);
+            dropped_logs_.add();
+            return;
         }
+        wakeConsumer();
+        return;
     }
+
+    // 暂存模式下先提交本线程已暂存的日志，使其不必等到攒满或超时
+    StagingBuffer* staged = staging_enabled_ ? tls_staging.find(instance_id_) : nullptr;
+    if (staged) {
+        StagingBuffer& buffer = *staged;
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        if (!buffer.records.empty()) {
+            std::vector<LogRecord> block;
+            block.reserve(staging_batch_size_);
+            block.swap(buffer.records);
+            publishBlock(buffer, std::move(block));
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    high_queue_.push_back(std::move(record));
+    high_queue_size_.store(high_queue_.size(), std::memory_order_release);
     queue_cv_.notify_one();
 }
 
+// 追加到线程本地暂存缓冲
+void AsyncLogger::stageRecord(LogRecord&& record) {
+    StagingBuffer* staged = tls_staging.find(instance_id_);
+    if (!staged) {
+        auto buffer = std::make_shared<StagingBuffer>();
+        buffer->owner_id = next_staging_owner.fetch_add(1, std::memory_order_relaxed);
+        buffer->records.reserve(staging_batch_size_);
+        {
+            std::lock_guard<std::mutex> lock(staging_mutex_);
+            staging_buffers_.push_back(buffer);
+        }
+        staged = buffer.get();
+        tls_staging.buffers.emplace_back(instance_id_, std::move(buffer));
+    }
+
+    StagingBuffer& buffer = *staged;
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.records.push_back(std::move(record));
+    if (buffer.records.size() >= staging_batch_size_) {
+        std::vector<LogRecord> block;
+        block.reserve(staging_batch_size_);
+        block.swap(buffer.records);
+        publishBlock(buffer, std::move(block));
+    }
+}
+
+// 提交暂存块
+void AsyncLogger::publishBlock(StagingBuffer& buffer, std::vector<LogRecord>&& block) {
+    // 块内每条日志暂存前已预留队列容量
+    size_t count = block.size();
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    staged_blocks_.emplace_back(buffer.owner_id, std::move(block));
+    current_queue_size_ += count;
+    updateMaxQueueSize(current_queue_size_);
+    queue_cv_.notify_one();
+}
+
+// 清扫超时或失效的暂存缓冲
+void AsyncLogger::sweepStagingBuffers(bool force) {
+    uint64_t now = captureTimestamp();
+    std::lock_guard<std::mutex> registry_lock(staging_mutex_);
+    for (auto it = staging_buffers_.begin(); it != staging_buffers_.end();) {
+        bool dead = false;
+        {
+            StagingBuffer& buffer = **it;
+            std::lock_guard<std::mutex> lock(buffer.mutex);
+            dead = !buffer.alive;
+            bool expired = !buffer.records.empty() && (force || dead ||
+                now >= buffer.records.front().timestamp_us + staging_flush_span_);
+            if (expired) {
+                std::vector<LogRecord> block;
+                if (!dead) {
+                    block.reserve(staging_batch_size_);
+                }
+                block.swap(buffer.records);
+                publishBlock(buffer, std::move(block));
+            }
+        }
+        // 线程已退出的缓冲在释放锁之后再移出登记表
+        it = dead ? staging_buffers_.erase(it) : std::next(it);
+    }
+}
+
+// 取出并归并暂存块
+bool AsyncLogger::collectStagedBlocks(std::vector<LogRecord>& batch, bool wait) {
+    // 先清扫再取块：同一线程先提交的块一定排在清扫出的剩余日志之前
+    sweepStagingBuffers(!running_);
+
+    std::vector<std::pair<uint64_t, std::vector<LogRecord>>> blocks;
+    {
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+        if (wait && staged_blocks_.empty()) {
+            // 超时醒来以便清扫未攒满的暂存缓冲
+            auto timeout = std::chrono::microseconds(std::max<uint64_t>(staging_flush_us_, 1000));
+            writer_parked_.store(true);
+            queue_cv_.wait_for(lock, timeout, [this]() {
+                return !staged_blocks_.empty() || highLanePending() || !running_;
+            });
+            writer_parked_.store(false);
+            if (crash_stop_.load()) {
+                lock.unlock();
+                parkWriter();
+            }
+        }
+        blocks.swap(staged_blocks_);
+        current_queue_size_ = 0;
+    }
+    if (blocks.empty()) {
+        return false;
+    }
+
+    // 同一线程的块按提交顺序拼接为一个有序序列
+    std::vector<std::vector<LogRecord>> runs;
+    std::unordered_map<uint64_t, size_t> run_index;
+    for (auto& block : blocks) {
+        auto found = run_index.find(block.first);
+        if (found == run_index.end()) {
+            run_index.emplace(block.first, runs.size());
+            runs.push_back(std::move(block.second));
+        } else {
+            std::vector<LogRecord>& run = runs[found->second];
+            run.insert(run.end(), std::make_move_iterator(block.second.begin()),
+                       std::make_move_iterator(block.second.end()));
+        }
+    }
+
+    if (runs.size() == 1) {
+        batch.insert(batch.end(), std::make_move_iterator(runs[0].begin()),
+                     std::make_move_iterator(runs[0].end()));
+        return true;
+    }
+
+    // 多路归并：每次取各序列队首中时间戳最小者，线程内顺序保持不变
+    using Head = std::pair<uint64_t, size_t>;
+    std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heads;
+    std::vector<size_t> positions(runs.size(), 0);
+    for (size_t i = 0; i < runs.size(); ++i) {
+        heads.emplace(runs[i].front().timestamp_us, i);
+    }
+    while (!heads.empty()) {
+        size_t run = heads.top().second;
+        heads.pop();
+        batch.push_back(std::move(runs[run][positions[run]]));
+        if (++positions[run] < runs[run].size()) {
+            heads.emplace(runs[run][positions[run]].timestamp_us, run);
+        }
+    }
+    return true;
+}
+
+// 更新队列容量与容量不足处理规则
+void AsyncLogger::applyOverflowConfig(const LogConfig& config) {
+    queue_capacity_bytes_.store(std::max<size_t>(config.queue_capacity_bytes, 1),
+                                std::memory_order_relaxed);
+    const std::pair<LogLevel, const LogOverflowRule*> rules[] = {
+        {LogLevel::WARN, &config.overflow_warn},
+        {LogLevel::INFO, &config.overflow_info},
+        {LogLevel::DEBUG, &config.overflow_debug},
+    };
+    for (const auto& entry : rules) {
+        OverflowState& state = overflow_states_[static_cast<int>(entry.first)];
+        state.policy.store(static_cast<int>(entry.second->policy), std::memory_order_relaxed);
+        state.block_timeout_ms.store(entry.second->block_timeout_ms, std::memory_order_relaxed);
+        state.sample_rate.store(std::max<uint32_t>(entry.second->sample_rate, 1),
+                                std::memory_order_relaxed);
+    }
+}
+
+// 预留队列容量
+bool AsyncLogger::admitRecord(LogLevel level, size_t bytes) {
+    // 错误日志不丢弃：容量不足时一直等待
+    if (level == LogLevel::LOG_ERROR) {
+        return tryReserveQueueBytes(bytes) || waitQueueSpace(bytes, 0, true);
+    }
+
+    OverflowState& state = overflow_states_[static_cast<int>(level)];
+    LogOverflowPolicy policy = static_cast<LogOverflowPolicy>(
+        state.policy.load(std::memory_order_relaxed));
+
+    // 采样：超过高水位后每N条只保留1条
+    if (policy == LogOverflowPolicy::SAMPLE) {
+        size_t capacity = queue_capacity_bytes_.load(std::memory_order_relaxed);
+        if (queued_bytes_.load(std::memory_order_relaxed) >= capacity / 4 * 3) {
+            uint32_t rate = state.sample_rate.load(std::memory_order_relaxed);
+            if (state.sample_counter.fetch_add(1, std::memory_order_relaxed) % rate != 0) {
+                return false;
+            }
+        }
+    }
+
+    if (tryReserveQueueBytes(bytes)) {
+        return true;
+    }
+
+    switch (policy) {
+    case LogOverflowPolicy::DROP_OLDEST:
+        // 只有确实腾出了空间才入队；环形队列与暂存日志只能由后台线程丢弃，
+        // 本条按丢弃最新处理，欠下的字节数由后续批次抵扣，容量上限始终有效
+        evictOldest(bytes);
+        return tryReserveQueueBytes(bytes);
+    case LogOverflowPolicy::BLOCK:
+        return waitQueueSpace(bytes, state.block_timeout_ms.load(std::memory_order_relaxed), false);
+    default:
+        return false;
+    }
+}
+
+// 容量足够时预留字节数
+bool AsyncLogger::tryReserveQueueBytes(size_t bytes) {
+    size_t capacity = queue_capacity_bytes_.load(std::memory_order_relaxed);
+    size_t used = queued_bytes_.load();
+    // 队列为空时总是允许，单条超过容量的日志不会永远等待
+    while (used == 0 || used + bytes <= capacity) {
+        if (queued_bytes_.compare_exchange_weak(used, used + bytes)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// 等待队列空间
+bool AsyncLogger::waitQueueSpace(size_t bytes, uint32_t timeout_ms, bool forever) {
+    // 写入线程：运行中直接丢弃，退出时照常入队
+    if (tls_writer_thread) {
+        if (running_) {
+            return false;
+        }
+        queued_bytes_.fetch_add(bytes);
+        return true;
+    }
+    blocked_logs_.add();
+
+    // 先登记等待者再复查容量，与releaseQueueBytes中先释放再检查等待者配对，不会错过唤醒
+    bool reserved = false;
+    auto ready = [&]() {
+        reserved = tryReserveQueueBytes(bytes);
+        return reserved || !running_;
+    };
+    std::unique_lock<std::mutex> lock(space_mutex_);
+    space_waiters_.fetch_add(1);
+    bool woke = true;
+    if (forever) {
+        space_cv_.wait(lock, ready);
+    } else {
+        woke = space_cv_.wait_for(lock, std::chrono::milliseconds(timeout_ms), ready);
+    }
+    space_waiters_.fetch_sub(1);
+
+    // 日志器正在退出：不再等待，直接入队由后台线程在退出前写出
+    if (woke && !reserved) {
+        queued_bytes_.fetch_add(bytes);
+        return true;
+    }
+    return reserved;
+}
+
+// 丢弃最旧的非错误日志
+void AsyncLogger::evictOldest(size_t bytes) {
+    size_t freed = 0;
+    size_t evicted = 0;
+    if (!ring_queue_) {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        if (staging_enabled_) {
+            for (auto& block : staged_blocks_) {
+                std::vector<LogRecord>& records = block.second;
+                size_t kept = 0;
+                for (size_t i = 0; i < records.size(); ++i) {
+                    if (freed < bytes && records[i].level != LogLevel::LOG_ERROR) {
+                        freed += recordBytes(records[i]);
+                        ++evicted;
+                    } else {
+                        if (kept != i) {
+                            records[kept] = std::move(records[i]);
+                        }
+                        ++kept;
+                    }
+                }
+                records.resize(kept);
+                if (freed >= bytes) {
+                    break;
+                }
+            }
+            // 归并时每个块至少要有一条日志
+            staged_blocks_.erase(
+                std::remove_if(staged_blocks_.begin(), staged_blocks_.end(),
+                               [](const std::pair<uint64_t, std::vector<LogRecord>>& block) {
+                                   return block.second.empty();
+                               }),
+                staged_blocks_.end());
+            current_queue_size_ -= std::min(current_queue_size_, evicted);
+        } else {
+            for (auto it = log_queue_.begin(); it != log_queue_.end() && freed < bytes;) {
+                if (it->level == LogLevel::LOG_ERROR) {
+                    ++it;
+                    continue;
+                }
+                freed += recordBytes(*it);
+                ++evicted;
+                it = log_queue_.erase(it);
+            }
+            current_queue_size_ = log_queue_.size();
+        }
+    }
+
+    if (evicted > 0) {
+        dropped_logs_.add(evicted);
+        releaseQueueBytes(freed);
+    }
+    // 环形队列只能由后台线程出队，线程暂存缓冲中的日志尚未提交，交给后台线程取出后丢弃
+    if (freed < bytes) {
+        addEvictDebt(bytes - freed);
+    }
+}
+
+// 登记待后台线程丢弃的字节数
+void AsyncLogger::addEvictDebt(size_t bytes) {
+    // 总数不超过队列中的字节数与容量的1/4：持续过载时后台线程每批最多丢弃这么多最旧日志，
+    // 其余照常写出，不会因欠账累积而整批丢弃
+    size_t limit = std::min(queued_bytes_.load(), queue_capacity_bytes_.load(std::memory_order_relaxed) / 4);
+    size_t debt = evict_bytes_.load(std::memory_order_relaxed);
+    size_t target;
+    do {
+        target = std::min(debt + bytes, std::max(debt, limit));
+    } while (target != debt &&
+             !evict_bytes_.compare_exchange_weak(debt, target, std::memory_order_relaxed));
+}
+
+// 释放队列容量
+void AsyncLogger::releaseQueueBytes(size_t bytes) {
+    queued_bytes_.fetch_sub(bytes);
+    if (space_waiters_.load() > 0) {
+        std::lock_guard<std::mutex> lock(space_mutex_);
+        space_cv_.notify_all();
+    }
+}
+
+// 释放一批日志占用的队列容量并处理待丢弃的最旧日志
+void AsyncLogger::releaseBatch(std::vector<LogRecord>& batch, bool evict) {
+    size_t bytes = 0;
+    for (const LogRecord& record : batch) {
+        bytes += recordBytes(record);
+    }
+
+    size_t want = evict ? evict_bytes_.exchange(0, std::memory_order_relaxed) : 0;
+    if (want > 0) {
+        // 本批按时间顺序排列，从头丢弃非错误日志；本批不足以抵扣的部分顺延到下一批
+        size_t freed = 0;
+        size_t kept = 0;
+        for (size_t i = 0; i < batch.size(); ++i) {
+            if (freed < want && batch[i].level != LogLevel::LOG_ERROR) {
+                freed += recordBytes(batch[i]);
+                dropped_logs_.add();
+            } else {
+                if (kept != i) {
+                    batch[kept] = std::move(batch[i]);
+                }
+                ++kept;
+            }
+        }
+        batch.resize(kept);
+        releaseQueueBytes(bytes);
+        if (freed < want) {
+            addEvictDebt(want - freed);
+        }
+        return;
+    }
+
+    releaseQueueBytes(bytes);
+}
+
+// 更新队列最大长度统计
+void AsyncLogger::updateMaxQueueSize(size_t size) {
+    size_t prev = max_queue_size_.load(std::memory_order_relaxed);
+    while (size > prev &&
+           !max_queue_size_.compare_exchange_weak(prev, size, std::memory_order_relaxed)) {
+    }
+}
+
 // 获取性能统计
 LogStats AsyncLogger::getStats() const {
-    std::lock_guard<std::mutex> lock(stats_mutex_);
-    return stats_;
+    LogStats stats;
+    stats.total_logs = total_logs_.load();
+    stats.dropped_logs = dropped_logs_.load();
+    stats.blocked_logs = blocked_logs_.load();
+    stats.filtered_logs = filtered_logs_.load(std::memory_order_relaxed);
+    stats.total_write_time = total_write_time_.load(std::memory_order_relaxed);
+    stats.max_queue_size = max_queue_size_.load(std::memory_order_relaxed);
+    stats.enqueue_latency = enqueue_histogram_.summary();
+    stats.writer_spin_hits = spin_hits_.load(std::memory_order_relaxed);
+    stats.writer_blocks = writer_blocks_.load(std::memory_order_relaxed);
+    LogLaneStats* lanes[2] = {&stats.high_lane, &stats.low_lane};
+    for (int i = 0; i < 2; ++i) {
+        lanes[i]->logs = lane_logs_[i].load(std::memory_order_relaxed);
+        lanes[i]->total_wait_us = lane_wait_us_[i].load(std::memory_order_relaxed);
+        lanes[i]->max_wait_us = lane_max_wait_us_[i].load(std::memory_order_relaxed);
+        lanes[i]->wait_us = lane_wait_histogram_[i].summary();
+    }
+
+    // 主日志文件在写入线程上直接写出，其余输出目标各自统计
+    LogSinkStats file;
+    std::shared_ptr<const LogConfig> config = std::atomic_load(&config_snapshot_);
+    file.name = "file:" + (config ? config->log_file : std::string());
+    file.messages = file_messages_.load(std::memory_order_relaxed);
+    file.bytes_written = file_bytes_.load(std::memory_order_relaxed);
+    file.total_write_ns = file_write_ns_.load(std::memory_order_relaxed);
+    file.max_write_ns = file_max_write_ns_.load(std::memory_order_relaxed);
+    file.write_latency = file_write_histogram_.summary();
+    stats.sinks.push_back(file);
+    std::shared_ptr<const std::vector<std::shared_ptr<SinkChannel>>> channels = std::atomic_load(&sinks_);
+    if (channels) {
+        for (const std::shared_ptr<SinkChannel>& channel : *channels) {
+            stats.sinks.push_back(channel->stats());
+        }
+    }
+    return stats;
 }
 
 // 重置性能统计
 void AsyncLogger::resetStats() {
-    std::lock_guard<std::mutex> lock(stats_mutex_);
-    stats_ = LogStats();
+    total_logs_.reset();
+    dropped_logs_.reset();
+    blocked_logs_.reset();
+    filtered_logs_.store(0, std::memory_order_relaxed);
+    total_write_time_.store(0, std::memory_order_relaxed);
+    max_queue_size_.store(0, std::memory_order_relaxed);
+    enqueue_histogram_.reset();
+    spin_hits_.store(0, std::memory_order_relaxed);
+    writer_blocks_.store(0, std::memory_order_relaxed);
+    for (int i = 0; i < 2; ++i) {
+        lane_logs_[i].store(0, std::memory_order_relaxed);
+        lane_wait_us_[i].store(0, std::memory_order_relaxed);
+        lane_max_wait_us_[i].store(0, std::memory_order_relaxed);
+        lane_wait_histogram_[i].reset();
+    }
+    file_messages_.store(0, std::memory_order_relaxed);
+    file_bytes_.store(0, std::memory_order_relaxed);
+    file_write_ns_.store(0, std::memory_order_relaxed);
+    file_max_write_ns_.store(0, std::memory_order_relaxed);
+    file_write_histogram_.reset();
+    std::shared_ptr<const std::vector<std::shared_ptr<SinkChannel>>> channels = std::atomic_load(&sinks_);
+    if (channels) {
+        for (const std::shared_ptr<SinkChannel>& channel : *channels) {
+            channel->resetStats();
+        }
+    }
 }
 
-// 后台处理日志队列
-void AsyncLogger::processLogs() {
-    const std::string reset_color = "\033[0m"; // 重置颜色
+// 从当前队列批量取出日志
+bool AsyncLogger::dequeueLogs(std::vector<LogRecord>& batch, bool wait) {
+    if (staging_enabled_) {
+        return collectStagedBlocks(batch, wait);
+    }
 
-    while (running_) {
-        std::string log_msg;
+    if (ring_queue_) {
+        // 崩溃处理请求停止后不再从环形队列取出，留给崩溃处理直接写出
+        size_t before = batch.size();
+        LogRecord record;
+        while (!crash_stop_.load(std::memory_order_relaxed) && ring_queue_->tryPop(record)) {
+            batch.push_back(std::move(record));
+        }
+        if (batch.size() > before || !wait) {
+            return batch.size() > before;
+        }
+        if (spin_wait_ && spinForLogs()) {
+            while (!crash_stop_.load(std::memory_order_relaxed) && ring_queue_->tryPop(record)) {
+                batch.push_back(std::move(record));
+            }
+            return batch.size() > before;
+        }
+        writer_blocks_.fetch_add(1, std::memory_order_relaxed);
+
+        // 先声明即将休眠再复查队列，生产者据此决定是否需要加锁唤醒
         {
             std::unique_lock<std::mutex> lock(queue_mutex_);
-            queue_cv_.wait(lock, [this]() {
-                return !log_queue_.empty() || !running_;
-            });
+            consumer_waiting_.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            auto ready = [this]() {
+                return !ring_queue_->empty() || highLanePending() || !running_;
+            };
+            // 需要定期汇报限频抑制次数时限时等待；阻塞期间不触碰文件与积压，崩溃处理不必等它醒来
+            writer_parked_.store(true);
+            if (suppressed_report_us_ > 0) {
+                queue_cv_.wait_for(lock, std::chrono::microseconds(suppressed_report_us_), ready);
+            } else {
+                queue_cv_.wait(lock, ready);
+            }
+            writer_parked_.store(false);
+            consumer_waiting_.store(false, std::memory_order_relaxed);
+            if (crash_stop_.load()) {
+                lock.unlock();
+                parkWriter();
+            }
+        }
+        while (!crash_stop_.load(std::memory_order_relaxed) && ring_queue_->tryPop(record)) {
+            batch.push_back(std::move(record));
+        }
+        return batch.size() > before;
+    }
 
-            if (!running_ && log_queue_.empty()) {
-                break;
+    std::deque<LogRecord> pending;
+    {
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+        if (wait) {
+            auto ready = [this]() {
+                return !log_queue_.empty() || highLanePending() || !running_;
+            };
+            // 需要定期汇报限频抑制次数时限时等待
+            writer_parked_.store(true);
+            if (suppressed_report_us_ > 0) {
+                queue_cv_.wait_for(lock, std::chrono::microseconds(suppressed_report_us_), ready);
+            } else {
+                queue_cv_.wait(lock, ready);
             }
+            writer_parked_.store(false);
+            if (crash_stop_.load()) {
+                lock.unlock();
+                parkWriter();
+            }
+        }
+        pending.swap(log_queue_);
+        current_queue_size_ = 0;
+    }
+    if (pending.empty()) {
+        return false;
+    }
+    batch.insert(batch.end(), std::make_move_iterator(pending.begin()),
+                 std::make_move_iterator(pending.end()));
+    return true;
+}
+
+// 阻塞前自旋等待环形队列出现日志
+bool AsyncLogger::spinForLogs() {
+    // 自旋期间consumer_waiting_保持false，生产者入队后不必加锁唤醒
+    uint64_t deadline = steadyNanos() + spin_budget_ns_;
+    for (uint32_t i = 1;; ++i) {
+        if (!ring_queue_->empty() || highLanePending() || !running_) {
+            spin_hits_.fetch_add(1, std::memory_order_relaxed);
+            spin_budget_ns_ = std::min(spin_budget_ns_ * 2, spin_limit_ns_);
+            return true;
+        }
+        cpuRelax();
+        // 每64轮读一次时钟，减少计时开销
+        if ((i & 63) == 0 && steadyNanos() >= deadline) {
+            break;
+        }
+    }
+    // 落空说明日志稀疏，缩短下次自旋，减少空转
+    spin_budget_ns_ = std::max(spin_budget_ns_ / 2, spin_limit_ns_ / 8);
+    return false;
+}
 
-            if (!log_queue_.empty()) {
-                log_msg = log_queue_.front();
-                log_queue_.pop();
-                current_queue_size_ = log_queue_.size();
+// 崩溃写出回调
+void AsyncLogger::onCrash(void* context, const CrashInfo& crash) {
+    static_cast<AsyncLogger*>(context)->writePendingOnCrash(crash);
+}
+
+// 停住写入线程（崩溃处理期间）
+void AsyncLogger::parkWriter() {
+    writer_parked_.store(true);
+    for (;;) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+}
+
+// 崩溃时写出待处理日志
+void AsyncLogger::writePendingOnCrash(const CrashInfo& crash) {
+    // 崩溃发生在其他线程时写入线程仍在运行：请它在写完当前一段日志后停下，
+    // 等它停住或确认它正阻塞等待后再碰文件（它可能正在扩充分块、writev或重新映射）。
+    // 先请求再读取线程句柄：尚未进入处理循环的写入线程登记句柄后会看到请求，立即停住
+    crash_stop_.store(true);
+    uintptr_t writer_thread = writer_thread_.load();
+    bool crashed_elsewhere = writer_thread != currentThreadHandle();
+    if (crashed_elsewhere && writer_thread != 0) {
+        for (int i = 0; i < 1000 && !writer_parked_.load(); ++i) {
+#ifdef _WIN32
+            Sleep(1);
+#else
+            struct timespec interval = {0, 1000000};
+            nanosleep(&interval, nullptr);
+#endif
+        }
+        // 1秒内没有停下（如阻塞在磁盘写入上）：与它并发写文件可能写坏或再次崩溃，不写出
+        if (!writer_parked_.load()) {
+            return;
+        }
+    }
+
+    FileSink* file = log_file_.get();
+    if (!file || !file->isOpen()) {
+        return;
+    }
+    // 已编码但尚未写出的数据在前，保持文件中的先后顺序
+    file->flushOnCrash();
+
+    bool binary_file = file_format_ == LogFileFormat::BINARY;
+    CrashLineWriter writer(*file);
+    char time_buf[TIME_BUFFER_SIZE];
+    // 本次写出中已写过定义的调用点；表满后每条都重写定义，解码器以后写的为准
+    const BinaryLogSite* defined_sites[64];
+    size_t defined_count = 0;
+    // 队列中的TSC时间戳尚未换算，按最近一次校准的锚点换算；积压中的已换算
+    auto wall_time = [&](const LogRecord& record, bool raw_ticks) {
+        uint64_t timestamp_us = record.timestamp_us;
+        if (raw_ticks && tsc_timestamps_ && ticks_per_us_ > 0) {
+            double offset = static_cast<double>(
+                static_cast<int64_t>(record.timestamp_us - tick_anchor_)) / ticks_per_us_;
+            timestamp_us = static_cast<uint64_t>(
+                static_cast<int64_t>(wall_anchor_us_) + static_cast<int64_t>(offset));
+        }
+        return timestamp_us;
+    };
+    auto write_record = [&](const LogRecord& record, bool raw_ticks) {
+        uint64_t timestamp_us = wall_time(record, raw_ticks);
+        if (binary_file) {
+            if (record.site) {
+                bool defined = false;
+                for (size_t i = 0; i < defined_count && !defined; ++i) {
+                    defined = defined_sites[i] == record.site;
+                }
+                if (!defined) {
+                    writeBinarySiteEntry(*record.site, &CrashLineWriter::write, &writer);
+                    if (defined_count < sizeof(defined_sites) / sizeof(defined_sites[0])) {
+                        defined_sites[defined_count++] = record.site;
+                    }
+                }
+                writeBinaryLogEntry(timestamp_us, record.level, record.site, record.args.data(),
+                                    record.args.size(), &CrashLineWriter::write, &writer);
+            } else {
+                writeBinaryLogEntry(timestamp_us, record.level, nullptr, record.text.data(),
+                                    record.text.size(), &CrashLineWriter::write, &writer);
             }
+            return;
+        }
+        writer.append("[");
+        writer.append(time_buf, formatCrashTimestamp(timestamp_us, time_buf));
+        writer.append("] [");
+        writer.append(levelToString(record.level));
+        writer.append("] ");
+        // 二进制与结构化日志的参数需要分配内存才能格式化，只写出格式串
+        if (record.site) {
+            writer.append(record.site->format);
+        } else {
+            writer.append(record.text.data(), record.text.size());
         }
+        writer.append("\n");
+    };
+
+    // 写入线程停住或尚未启动时，它已取出、尚未写出的普通日志都在积压中，排在普通通道环形队列之前；
+    // 崩溃发生在写入线程自身时积压可能正被修改，不写出
+    const LogRecord* backlog_next = nullptr;
+    const LogRecord* backlog_end = nullptr;
+    if (crashed_elsewhere && backlog_position_ < backlog_.size()) {
+        backlog_next = backlog_.data() + backlog_position_;
+        backlog_end = backlog_.data() + backlog_.size();
+    }
 
-        if (log_msg.empty()) {
-            continue;
+    // 积压之后只读取两个无锁环形队列（槽位预分配，只做原子读取），按时间戳归并，
+    // 同一线程的日志按提交序号，与写入线程的先后一致；尚未写入完成的槽位跳过
+    MpscRingBuffer<LogRecord>* low_ring = ring_queue_.get();
+    MpscRingBuffer<LogRecord>* high_ring = high_ring_.get();
+    size_t low_pos = low_ring ? low_ring->dequeuedCount() : 0;
+    size_t low_end = low_ring ? std::min(low_ring->enqueuedCount(), low_pos + low_ring->capacity()) : 0;
+    size_t high_pos = high_ring ? high_ring->dequeuedCount() : 0;
+    size_t high_end = high_ring ? std::min(high_ring->enqueuedCount(), high_pos + high_ring->capacity()) : 0;
+    const LogRecord* low = nullptr;
+    const LogRecord* high = nullptr;
+    bool low_raw = false;
+    for (;;) {
+        if (!low && backlog_next < backlog_end) {
+            low = backlog_next++;
+            low_raw = false;
+        }
+        while (!low && low_pos < low_end) {
+            low = low_ring->pendingAt(low_pos++);
+            low_raw = true;
+        }
+        while (!high && high_pos < high_end) {
+            high = high_ring->pendingAt(high_pos++);
+        }
+        if (!low && !high) {
+            break;
         }
+        bool take_low = low && (!high || (low->thread_tag == high->thread_tag
+                                              ? seqBefore(low->thread_seq, high->thread_seq)
+                                              : wall_time(*low, low_raw) <= wall_time(*high, true)));
+        if (take_low) {
+            write_record(*low, low_raw);
+            low = nullptr;
+        } else {
+            write_record(*high, true);
+            high = nullptr;
+        }
+    }
 
-        // 读取当前配置（加锁保护）
-        LogConfig current_config;
-        {
-            std::lock_guard<std::mutex> lock(config_mutex_);
-            current_config = config_;
+    if (binary_file) {
+        // 崩溃原因与调用栈地址作为一条TEXT条目写出，log_decoder照常解码
+        char text[2048];
+        size_t length = 0;
+        auto append_text = [&](const char* data, size_t size) {
+            size = std::min(size, sizeof(text) - length);
+            std::memcpy(text + length, data, size);
+            length += size;
+        };
+        append_text("fatal ", 6);
+        append_text(crash.reason, std::strlen(crash.reason));
+        append_text(", stack trace:", 14);
+        char line[32];
+        for (int i = 0; i < crash.frame_count; ++i) {
+            append_text("\n", 1);
+            size_t size = formatCrashFrame(i, crash.frames[i], line);
+            append_text(line, size - 1);
         }
+        writeBinaryLogEntry(crash.timestamp_us, LogLevel::LOG_ERROR, nullptr, text, length,
+                            &CrashLineWriter::write, &writer);
+        return;
+    }
 
-        // 提取日志级别（用于颜色/系统日志）
-        size_t level_start = log_msg.find("[", log_msg.find("[") + 1) + 1;
-        size_t level_end = log_msg.find("]", level_start);
-        std::string level_str = log_msg.substr(level_start, level_end - level_start);
-        LogLevel level = LogLevel::OFF;
-        if (level_str == "ERROR") level = LogLevel::LOG_ERROR;
-        else if (level_str == "WARN")  level = LogLevel::WARN;
-        else if (level_str == "INFO")  level = LogLevel::INFO;
-        else if (level_str == "DEBUG") level = LogLevel::DEBUG;
+    // 崩溃原因与调用栈
+    writer.append("[");
+    writer.append(time_buf, formatCrashTimestamp(crash.timestamp_us, time_buf));
+    writer.append("] [ERROR] fatal ");
+    writer.append(crash.reason);
+    writer.append(", stack trace:\n");
+    if (file_sink_type_ == LogFileSinkType::BUFFERED) {
+        writer.flush();
+        writeCrashBacktrace(static_cast<BufferedFileSink*>(file)->fd(), crash.frames, crash.frame_count);
+    } else {
+        char line[32];
+        for (int i = 0; i < crash.frame_count; ++i) {
+            writer.append(line, formatCrashFrame(i, crash.frames[i], line));
+        }
+    }
+}
 
-        // 记录写入开始时间
-        auto write_start = std::chrono::high_resolution_clock::now();
+// 采集时间戳
+uint64_t AsyncLogger::captureTimestamp() const {
+    return tsc_timestamps_ ? readTicks() : nowMicros();
+}
 
-        // 1. 控制台输出（支持颜色）
-        if (current_config.enable_console) {
-            std::cout << getColorCode(level) << log_msg << reset_color << std::endl;
+// 校准TSC
+void AsyncLogger::calibrateTicks(bool initial) {
+    // 前后两次读取计数取中点，减小系统时钟读取耗时带来的误差
+    uint64_t ticks_before = readTicks();
+    uint64_t wall_us = nowMicros();
+    uint64_t ticks = ticks_before + (readTicks() - ticks_before) / 2;
+
+    if (initial) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        uint64_t end_before = readTicks();
+        uint64_t end_wall_us = nowMicros();
+        uint64_t end_ticks = end_before + (readTicks() - end_before) / 2;
+        if (end_wall_us > wall_us && end_ticks > ticks) {
+            ticks_per_us_ = static_cast<double>(end_ticks - ticks) / (end_wall_us - wall_us);
         }
+        ticks = end_ticks;
+        wall_us = end_wall_us;
+    } else if (wall_us > wall_anchor_us_ && ticks > tick_anchor_) {
+        // 用相邻两个锚点之间的长区间修正频率，同时跟随系统时钟调整
+        ticks_per_us_ = static_cast<double>(ticks - tick_anchor_) / (wall_us - wall_anchor_us_);
+    }
 
-        // 2. 文件输出（先检查轮转）
-        if (current_config.enable_file && log_file_.is_open()) {
-            checkLogRotation();
-            log_file_ << log_msg << std::endl;
-            log_file_.flush();
+    tick_anchor_ = ticks;
+    wall_anchor_us_ = wall_us;
+    next_calibrate_us_ = wall_us + 1000000;
+}
+
+// 换算TSC时间戳
+void AsyncLogger::convertTimestamps(std::vector<LogRecord>& batch, size_t begin) {
+    if (!tsc_timestamps_) {
+        return;
+    }
+    if (nowMicros() >= next_calibrate_us_) {
+        calibrateTicks(false);
+    }
+    for (size_t i = begin; i < batch.size(); ++i) {
+        LogRecord& record = batch[i];
+        // 锚点之前采集的计数差为负，按有符号数换算
+        double offset = static_cast<double>(
+            static_cast<int64_t>(record.timestamp_us - tick_anchor_)) / ticks_per_us_;
+        record.timestamp_us = static_cast<uint64_t>(
+            static_cast<int64_t>(wall_anchor_us_) + static_cast<int64_t>(offset));
+    }
+}
+
+// 后台处理日志队列
+void AsyncLogger::processLogs() {
+    std::vector<LogRecord> urgent;  // 高优先级通道工作缓冲
+    // 普通通道已取出、尚未写完的日志放在成员中，写入线程停住后崩溃处理从backlog_position_起写出
+    std::vector<LogRecord>& backlog = backlog_;
+    size_t& position = backlog_position_;
+    writer_thread_.store(currentThreadHandle());
+    tls_writer_thread = true;
+    // 与崩溃处理先请求、后读取句柄的顺序配对：它没看到句柄时这里一定看到请求
+    if (crash_stop_.load()) {
+        parkWriter();
+    }
+
+    while (running_) {
+        // 崩溃处理正在写出队列：停在一段日志之间，此时已取出未写出的日志都在积压中
+        if (crash_stop_.load(std::memory_order_relaxed)) {
+            parkWriter();
+        }
+        if (suppressed_report_us_ > 0) {
+            uint64_t now = nowMicros();
+            if (now >= last_report_us_ + suppressed_report_us_) {
+                reportSuppressed(now);
+            }
         }
 
-        // 3. 系统日志输出
-        if (current_config.enable_syslog) {
-#ifdef _WIN32
-            // Windows Event Log（简化实现）
-            HANDLE hEventSource = RegisterEventSource(NULL, current_config.syslog_ident.c_str());
-            if (hEventSource != NULL) {
-                WORD type = EVENTLOG_INFORMATION_TYPE;
-                if (level == LogLevel::LOG_ERROR) type = EVENTLOG_ERROR_TYPE;
-                else if (level == LogLevel::WARN) type = EVENTLOG_WARNING_TYPE;
+        // 普通通道按段写出，每段之前先写完高优先级通道，错误日志的等待不随积压量增长
+        drainHighLane(urgent);
+        if (position < backlog.size()) {
+            size_t end = std::min(backlog.size(), position + LANE_SLICE);
+            writeRecords(backlog, position, end, LOW_LANE);
+            position = end;
+            commitLogFile(false);
+            continue;
+        }
 
-                LPCTSTR strings[1] = {TEXT(log_msg.c_str())};
-                ReportEvent(hEventSource, type, 0, 0, NULL, 1, 0, strings, NULL);
-                DeregisterEventSource(hEventSource);
+        resetBacklog();
+        // 文件缓冲中有未写出的日志时不阻塞：队列一旦取空就立即写出
+        bool pending = log_file_ && log_file_->pendingBytes() > 0;
+        if (!dequeueLogs(backlog, !pending)) {
+            if (pending && !highLanePending()) {
+                commitLogFile(true);
             }
-#else
-            // Linux syslog
-            int syslog_priority = LOG_INFO;
-            if (level == LogLevel::LOG_ERROR) syslog_priority = LOG_ERR;
-            else if (level == LogLevel::WARN) syslog_priority = LOG_WARNING;
-            else if (level == LogLevel::DEBUG) syslog_priority = LOG_DEBUG;
-
-            openlog(current_config.syslog_ident.c_str(), LOG_PID, LOG_USER);
-            syslog(syslog_priority, "%s", log_msg.c_str());
-            closelog();
-#endif
+            continue;
         }
+        releaseBatch(backlog, true);
+        convertTimestamps(backlog);
+    }
 
-        // 性能统计：写入耗时
-        auto write_end = std::chrono::high_resolution_clock::now();
-        uint64_t write_cost = std::chrono::duration_cast<std::chrono::microseconds>(
-            write_end - write_start
-        ).count();
-        {
-            std::lock_guard<std::mutex> lock(stats_mutex_);
-            stats_.total_write_time += write_cost;
+    // 处理剩余日志：最后一次限频汇总先入队，与其余日志一起写出
+    if (suppressed_report_us_ > 0) {
+        reportSuppressed(nowMicros());
+    }
+    drainHighLane(urgent);
+    writeRecords(backlog, position, backlog.size(), LOW_LANE);
+    resetBacklog();
+    while (dequeueLogs(backlog, false)) {
+        releaseBatch(backlog, true);
+        convertTimestamps(backlog);
+        drainHighLane(urgent);
+        writeRecords(backlog, position, backlog.size(), LOW_LANE);
+        resetBacklog();
+    }
+    drainHighLane(urgent);
+    commitLogFile(true);
+    writer_thread_.store(0);
+}
+
+// 汇报限频抑制次数
+void AsyncLogger::reportSuppressed(uint64_t now_us) {
+    std::vector<SuppressedSummary> summaries;
+    collectSuppressed(summaries);
+    uint64_t elapsed_ms = (now_us - std::min(now_us, last_report_us_)) / 1000;
+    last_report_us_ = now_us;
+
+    // 汇总日志按调用点的级别像普通日志一样入队：经过关键词过滤、计入统计并按时间顺序写出
+    for (const SuppressedSummary& summary : summaries) {
+        // 退出时running_已清除，这里只按运行时级别判断（限频宏不带模块，沿用全局级别）
+        if (summary.level > runtime_level_.load(std::memory_order_relaxed)) {
+            continue;
         }
+        LogRecord record;
+        record.level = summary.level;
+        record.text = formatLog("[%s:%d:%s] suppressed %llu similar messages in the last %llu ms",
+                                summary.file, summary.line, summary.func,
+                                static_cast<unsigned long long>(summary.count),
+                                static_cast<unsigned long long>(elapsed_ms));
+        submit(std::move(record));
     }
+}
 
-    // 处理剩余日志
-    while (true) {
-        std::string msg;
-        {
-            std::lock_guard<std::mutex> lock(queue_mutex_);
-            if (log_queue_.empty()) {
+// 高优先级通道是否有日志
+bool AsyncLogger::highLanePending() const {
+    return high_ring_ ? !high_ring_->empty()
+                      : high_queue_size_.load(std::memory_order_acquire) > 0;
+}
+
+// 写出高优先级通道
+bool AsyncLogger::drainHighLane(std::vector<LogRecord>& batch) {
+    // 取出普通日志期间可能又有高优先级日志入队，它们可能早于刚取出的同一线程普通日志；
+    // 反复取到通道为空，积压中的普通日志之前不会留有同一线程尚未写出的高优先级日志
+    bool wrote = false;
+    while (takeHighLane(batch)) {
+        releaseBatch(batch, false);
+        convertTimestamps(batch);
+        pullLowLane();
+        writeHighLane(batch);
+        commitLogFile(false);
+        wrote = true;
+    }
+    return wrote;
+}
+
+// 非阻塞取出高优先级通道
+bool AsyncLogger::takeHighLane(std::vector<LogRecord>& batch) {
+    batch.clear();
+    if (high_ring_) {
+        LogRecord record;
+        while (!crash_stop_.load(std::memory_order_relaxed) && high_ring_->tryPop(record)) {
+            batch.push_back(std::move(record));
+        }
+    } else if (highLanePending()) {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        batch.insert(batch.end(), std::make_move_iterator(high_queue_.begin()),
+                     std::make_move_iterator(high_queue_.end()));
+        high_queue_.clear();
+        high_queue_size_.store(0, std::memory_order_relaxed);
+    }
+    return !batch.empty();
+}
+
+// 把普通通道中已入队的日志追加到积压
+void AsyncLogger::pullLowLane() {
+    std::vector<LogRecord>& backlog = backlog_;
+    bool fresh = backlog_position_ >= backlog.size();
+    if (fresh) {
+        resetBacklog();
+    }
+    size_t before = backlog.size();
+    if (!staging_enabled_ && ring_queue_) {
+        // 高优先级日志已取出，同一线程更早写入的普通日志所在槽位一定已被占用
+        size_t mark = ring_queue_->enqueuedCount();
+        LogRecord record;
+        while (static_cast<intptr_t>(ring_queue_->dequeuedCount() - mark) < 0) {
+            if (ring_queue_->tryPop(record)) {
+                backlog.push_back(std::move(record));
+            } else if (crash_stop_.load(std::memory_order_relaxed)) {
+                // 崩溃处理请求停止后不再等待（写入中的槽位可能属于崩溃的线程），余下的留给它写出；
+                // 已取出的高优先级日志照常写完，写入线程随后在提交时停住
                 break;
+            } else {
+                std::this_thread::yield();  // 其他生产者已占用槽位、尚未写完
             }
-            msg = log_queue_.front();
-            log_queue_.pop();
         }
+    } else {
+        dequeueLogs(backlog, false);
+    }
+    if (backlog.size() == before) {
+        return;
+    }
 
-        LogConfig current_config;
-        {
-            std::lock_guard<std::mutex> lock(config_mutex_);
-            current_config = config_;
+    if (fresh) {
+        // 积压为空：与正常取出一批相同
+        releaseBatch(backlog, true);
+    } else {
+        // 追加在未写完的积压之后：字节数待积压写完后再释放
+        for (size_t i = before; i < backlog.size(); ++i) {
+            backlog_held_bytes_ += recordBytes(backlog[i]);
+        }
+    }
+    convertTimestamps(backlog, fresh ? 0 : before);
+}
+
+// 写出一批高优先级日志，同一线程更早的普通日志先写
+void AsyncLogger::writeHighLane(std::vector<LogRecord>& batch) {
+    std::vector<LogRecord>& backlog = backlog_;
+    size_t position = backlog_position_;
+    if (position >= backlog.size()) {
+        writeRecords(batch, 0, batch.size(), HIGH_LANE);
+        return;
+    }
+
+    // 各线程在本批中最后一条高优先级日志的序号（同一线程在通道内按提交顺序排列）
+    std::unordered_map<uint32_t, uint32_t> last_seq;
+    for (const LogRecord& record : batch) {
+        last_seq[record.thread_tag] = record.thread_seq;
+    }
+
+    // 从积压中摘出这些线程序号更小的普通日志，其余日志保持原有顺序
+    std::unordered_map<uint32_t, std::vector<LogRecord>> earlier;
+    size_t kept = position;
+    for (size_t i = position; i < backlog.size(); ++i) {
+        auto found = last_seq.find(backlog[i].thread_tag);
+        if (found != last_seq.end() && seqBefore(backlog[i].thread_seq, found->second)) {
+            earlier[found->first].push_back(std::move(backlog[i]));
+            continue;
+        }
+        if (kept != i) {
+            backlog[kept] = std::move(backlog[i]);
+        }
+        ++kept;
+    }
+    backlog.resize(kept);
+
+    // 每条高优先级日志之前写出同一线程序号更小、尚未写出的普通日志
+    std::unordered_map<uint32_t, size_t> written;
+    size_t run_begin = 0;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        auto found = earlier.find(batch[i].thread_tag);
+        if (found == earlier.end()) {
+            continue;
+        }
+        const std::vector<LogRecord>& lows = found->second;
+        size_t& next = written[found->first];
+        size_t end = next;
+        while (end < lows.size() && seqBefore(lows[end].thread_seq, batch[i].thread_seq)) {
+            ++end;
+        }
+        if (end > next) {
+            writeRecords(batch, run_begin, i, HIGH_LANE);
+            writeRecords(lows, next, end, LOW_LANE);
+            run_begin = i;
+            next = end;
+        }
+    }
+    writeRecords(batch, run_begin, batch.size(), HIGH_LANE);
+}
+
+// 清空积压
+void AsyncLogger::resetBacklog() {
+    backlog_.clear();
+    backlog_position_ = 0;
+    if (backlog_held_bytes_ > 0) {
+        releaseQueueBytes(backlog_held_bytes_);
+        backlog_held_bytes_ = 0;
+    }
+}
+
+// 写出一段日志并统计排队时延
+void AsyncLogger::writeRecords(const std::vector<LogRecord>& batch, size_t begin, size_t end,
+                               int lane) {
+    if (begin >= end) {
+        return;
+    }
+    // 排队时延：从调用线程采集时间戳到写入线程开始处理这段日志
+    uint64_t now = nowMicros();
+    uint64_t total_wait = 0;
+    uint64_t max_wait = lane_max_wait_us_[lane].load(std::memory_order_relaxed);
+    // 每段取一次配置、过滤器与输出通道快照，updateConfig替换后从下一段开始生效
+    refreshWriterConfig();
+    std::shared_ptr<const KeywordFilter> filter = std::atomic_load(&keyword_filter_);
+    std::shared_ptr<const std::vector<std::shared_ptr<SinkChannel>>> sinks = std::atomic_load(&sinks_);
+    if (sinks != writer_sinks_) {
+        // 通道列表变化前攒下的日志仍交给原来的通道
+        commitSinks();
+        writer_sinks_ = std::move(sinks);
+    }
+    uint64_t start = steadyNanos();
+    uint64_t filtered = 0;
+    for (size_t i = begin; i < end; ++i) {
+        if (filter && !acceptRecord(batch[i], *filter)) {
+            ++filtered;
+            continue;
+        }
+        uint64_t ts = batch[i].timestamp_us;
+        uint64_t wait = now > ts ? now - ts : 0;
+        total_wait += wait;
+        max_wait = std::max(max_wait, wait);
+        lane_wait_histogram_[lane].record(wait);
+        writeRecord(batch[i]);
+    }
+    // 统计仅由写入线程更新
+    total_write_time_.fetch_add((steadyNanos() - start) / 1000, std::memory_order_relaxed);
+    filtered_logs_.fetch_add(filtered, std::memory_order_relaxed);
+    lane_logs_[lane].fetch_add(end - begin - filtered, std::memory_order_relaxed);
+    lane_wait_us_[lane].fetch_add(total_wait, std::memory_order_relaxed);
+    lane_max_wait_us_[lane].store(max_wait, std::memory_order_relaxed);
+}
+
+// 按关键词过滤日志正文
+bool AsyncLogger::acceptRecord(const LogRecord& record, const KeywordFilter& filter) {
+    if (!record.site) {
+        return filter.accept(record.text.data(), record.text.size());
+    }
+    filter_buffer_.clear();
+    formatBinaryRecord(*record.site, record.args.data(), record.args.size(), filter_buffer_);
+    return filter.accept(filter_buffer_.data(), filter_buffer_.size());
+}
+
+// 重建关键词过滤器
+void AsyncLogger::applyKeywordConfig(const LogConfig& config) {
+    std::shared_ptr<const KeywordFilter> current = std::atomic_load(&keyword_filter_);
+    if (current ? (current->includeKeywords() == config.include_keywords &&
+                   current->excludeKeywords() == config.filter_keywords)
+                : (config.include_keywords.empty() && config.filter_keywords.empty())) {
+        return;
+    }
+    std::shared_ptr<const KeywordFilter> filter =
+        std::make_shared<KeywordFilter>(config.include_keywords, config.filter_keywords);
+    if (filter->empty()) {
+        filter.reset();
+    }
+    std::atomic_store(&keyword_filter_, filter);
+}
+
+// 按策略写出文件缓冲
+void AsyncLogger::commitLogFile(bool idle) {
+    // 崩溃处理正在等待：一段日志已整体写完，在这里停住，不再写出文件缓冲
+    if (crash_stop_.load(std::memory_order_relaxed)) {
+        parkWriter();
+    }
+    commitSinks();
+    if (!log_file_ || log_file_->pendingBytes() == 0) {
+        return;
+    }
+    // 持续有日志时按滞留时间兜底，避免高负载下迟迟不写出
+    if (idle || nowMicros() - file_pending_since_us_ >= file_flush_interval_us_) {
+        flushLogFile();
+    }
+}
+
+// 写出文件缓冲并统计耗时
+void AsyncLogger::flushLogFile() {
+    if (log_file_->pendingBytes() == 0) {
+        return;
+    }
+    uint64_t start = steadyNanos();
+    log_file_->flush();
+    recordFileWrite(steadyNanos() - start);
+}
+
+// 累计一次主日志文件写入耗时
+void AsyncLogger::recordFileWrite(uint64_t cost) {
+    // 统计仅由写入线程更新
+    file_write_ns_.fetch_add(cost, std::memory_order_relaxed);
+    if (cost > file_max_write_ns_.load(std::memory_order_relaxed)) {
+        file_max_write_ns_.store(cost, std::memory_order_relaxed);
+    }
+    file_write_histogram_.record(cost);
+}
+
+// 按配置创建或停止控制台、系统日志输出通道
+void AsyncLogger::applySinkConfig(const LogConfig& config) {
+    std::vector<std::shared_ptr<SinkChannel>> retired;
+    {
+        std::lock_guard<std::mutex> lock(sinks_mutex_);
+        bool changed = false;
+        // 颜色设置变化时重建控制台通道
+        if (console_channel_ && (!config.enable_console || console_color_ != config.enable_color)) {
+            retired.push_back(std::move(console_channel_));
+            console_channel_.reset();
+            changed = true;
+        }
+        if (!console_channel_ && config.enable_console) {
+            console_channel_ = std::make_shared<SinkChannel>(
+                std::make_shared<ConsoleSink>(config.enable_color), true, config.sink_queue_capacity);
+            console_color_ = config.enable_color;
+            changed = true;
+        }
+        if (syslog_channel_ && (!config.enable_syslog || syslog_ident_ != config.syslog_ident ||
+                                syslog_path_ != config.syslog_path)) {
+            retired.push_back(std::move(syslog_channel_));
+            syslog_channel_.reset();
+            changed = true;
         }
+        if (!syslog_channel_ && config.enable_syslog) {
+            syslog_channel_ = std::make_shared<SinkChannel>(
+                std::make_shared<SyslogSink>(config.syslog_ident, config.syslog_path), true,
+                config.sink_queue_capacity);
+            syslog_ident_ = config.syslog_ident;
+            syslog_path_ = config.syslog_path;
+            changed = true;
+        }
+        if (changed) {
+            publishSinks();
+        }
+    }
+    // 写入线程可能仍持有旧列表，停止后的通道只计入丢弃
+    for (const std::shared_ptr<SinkChannel>& channel : retired) {
+        channel->stop();
+    }
+}
+
+// 发布输出通道列表
+void AsyncLogger::publishSinks() {
+    auto channels = std::make_shared<std::vector<std::shared_ptr<SinkChannel>>>();
+    if (console_channel_) {
+        channels->push_back(console_channel_);
+    }
+    if (syslog_channel_) {
+        channels->push_back(syslog_channel_);
+    }
+    channels->insert(channels->end(), user_channels_.begin(), user_channels_.end());
+    std::shared_ptr<const std::vector<std::shared_ptr<SinkChannel>>> published = std::move(channels);
+    std::atomic_store(&sinks_, published);
+}
+
+// 注册输出目标
+void AsyncLogger::addSink(std::shared_ptr<LogSink> sink, bool dedicated_thread) {
+    if (!sink) {
+        return;
+    }
+    size_t capacity;
+    {
+        std::lock_guard<std::mutex> lock(config_mutex_);
+        capacity = config_.sink_queue_capacity;
+    }
+    std::lock_guard<std::mutex> lock(sinks_mutex_);
+    user_channels_.push_back(std::make_shared<SinkChannel>(std::move(sink), dedicated_thread, capacity));
+    publishSinks();
+}
 
-        // 控制台输出剩余日志
-        if (current_config.enable_console) {
-            std::cout << msg << std::endl;
+// 注销输出目标
+void AsyncLogger::removeSink(const std::shared_ptr<LogSink>& sink) {
+    std::shared_ptr<SinkChannel> retired;
+    {
+        std::lock_guard<std::mutex> lock(sinks_mutex_);
+        for (auto it = user_channels_.begin(); it != user_channels_.end(); ++it) {
+            if ((*it)->sink() == sink) {
+                retired = *it;
+                user_channels_.erase(it);
+                publishSinks();
+                break;
+            }
         }
+    }
+    if (retired) {
+        retired->stop();
+    }
+}
+
+// 输出一条日志记录
+void AsyncLogger::writeRecord(const LogRecord& record) {
+    LogLevel level = record.level;
+
+    // 配置快照由writeRecords每段刷新一次，这里不加锁、不复制
+    const LogConfig& current_config = *writer_config_;
+
+    // 拼接时间与级别前缀（仅在有文本输出目标时格式化），复用写入线程的行缓冲
+    bool binary_file = current_config.enable_file && file_format_ == LogFileFormat::BINARY;
+    bool has_sinks = writer_sinks_ && !writer_sinks_->empty();
+    std::string& log_msg = line_buffer_;
+    log_msg.clear();
+    if (record.site && record.site->keys && (has_sinks || (current_config.enable_file && !binary_file))) {
+        // 结构化日志整行编码为JSON或logfmt
+        encodeStructuredRecord(current_config.kv_format, record.timestamp_us, level, *record.site,
+                               record.args.data(), record.args.size(), log_msg);
+    } else if (has_sinks || (current_config.enable_file && !binary_file)) {
+        char time_buf[TIME_BUFFER_SIZE];
+        log_msg += '[';
+        log_msg.append(time_buf, formatTimestamp(record.timestamp_us, time_buf));
+        log_msg += "] [";
+        log_msg += levelToString(record.level);
+        log_msg += "] ";
+        if (record.site) {
+            formatBinaryRecord(*record.site, record.args.data(), record.args.size(), log_msg);
+        } else {
+            log_msg += record.text;
+        }
+    }
 
-        // 文件输出剩余日志
-        if (current_config.enable_file && log_file_.is_open()) {
-            log_file_ << msg << std::endl;
+    // 1. 文件输出（先检查轮转），在写入线程上直接完成
+    if (current_config.enable_file && log_file_ && log_file_->isOpen()) {
+        uint64_t file_start = steadyNanos();
+        checkLogRotation(current_config, record.timestamp_us);
+        if (log_file_->pendingBytes() == 0) {
+            file_pending_since_us_ = nowMicros();
         }
+        size_t bytes;
+        if (binary_file) {
+            // 二进制格式：格式串定义在每个文件中首次使用前写入一次
+            binary_buffer_.clear();
+            if (record.site) {
+                uint32_t id = record.site->id;
+                if (id >= written_sites_.size()) {
+                    written_sites_.resize(id + 1, false);
+                }
+                if (!written_sites_[id]) {
+                    encodeBinarySiteEntry(*record.site, binary_buffer_);
+                    written_sites_[id] = true;
+                }
+            }
+            encodeBinaryLogEntry(record, binary_buffer_);
+            log_file_->append(binary_buffer_.data(), binary_buffer_.size());
+            bytes = binary_buffer_.size();
+        } else {
+            log_file_->appendLine(log_msg);
+            bytes = log_msg.size() + 1;
+        }
+        file_messages_.fetch_add(1, std::memory_order_relaxed);
+        file_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+        // 内存映射方式在append时写入页缓存；缓冲方式只在flushLogFile中统计批量写出，避免同一行计两次
+        if (file_sink_type_ == LogFileSinkType::MMAP) {
+            recordFileWrite(steadyNanos() - file_start);
+        }
+        // 攒够字节数或遇到错误日志时立即写出，其余留给批次结束时统一提交
+        if (log_file_->pendingBytes() >= current_config.file_flush_bytes ||
+            (level == LogLevel::LOG_ERROR && current_config.file_flush_on_error)) {
+            flushLogFile();
+        }
+    }
+
+    // 2. 其他输出目标（控制台、系统日志、用户注册）：追加到本段批次，提交时各通道共享
+    if (has_sinks) {
+        if (!sink_batch_) {
+            acquireSinkBatch();
+        }
+        sink_batch_->add(level, record.timestamp_us, log_msg);
+    }
+}
+
+// 把本段攒下的输出目标日志作为一个共享批次提交给各通道
+void AsyncLogger::commitSinks() {
+    if (!writer_sinks_) {
+        return;
+    }
+    // 批次只移交指针，各通道每段只加锁一次；没有新日志时仍提交，直接调用的目标借此flush
+    std::shared_ptr<const LogSinkBatch> batch = std::move(sink_batch_);
+    for (const std::shared_ptr<SinkChannel>& channel : *writer_sinks_) {
+        channel->commit(batch);
+    }
+}
+
+// 从批次池取一个各通道都已写完的批次
+void AsyncLogger::acquireSinkBatch() {
+    for (const std::shared_ptr<LogSinkBatch>& batch : sink_batch_pool_) {
+        // 只剩池中这一个引用时，各通道线程都已释放它；acquire与其释放引用时的写入同步
+        if (batch.use_count() == 1) {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            batch->clear();
+            sink_batch_ = batch;
+            return;
+        }
+    }
+    sink_batch_ = std::make_shared<LogSinkBatch>();
+    if (sink_batch_pool_.size() < SINK_BATCH_POOL_SIZE) {
+        sink_batch_pool_.push_back(sink_batch_);
     }
 }
 
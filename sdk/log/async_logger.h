@@ -10,6 +10,12 @@
 #define YALGO_SDK_LOG_ASYNC_LOGGER_H
 
 #include "log_exports.h"
+#include "mpsc_ring_buffer.h"
+#include "file_sink.h"
+#include "mmap_file_sink.h"
+#include "log_sink.h"
+#include "log_stats.h"
+#include "crash_handler.h"
 
 #include <string>
 #include <atomic>
@@ -21,6 +27,13 @@
 #include <fstream>
 #include <cstdarg>
 #include <sstream>
+#include <memory>
+#include <deque>
+#include <functional>
+#include <cstdint>
+#include <type_traits>
+#include <charconv>
+#include <string_view>
 
 // 定义命名空间
 namespace yalgo {
@@ -37,6 +50,97 @@ enum class LogLevel {
     DEBUG = 4      ///< 调试 + 所有日志
 };
 
+/**
+ * @brief 日志队列类型枚举
+ */
+enum class LogQueueType {
+    MUTEX_QUEUE = 0,   ///< 互斥锁保护的std::deque（默认）
+    LOCKFREE_RING = 1  ///< 有界无锁MPSC环形队列
+};
+
+/**
+ * @brief 日志文件格式枚举
+ */
+enum class LogFileFormat {
+    TEXT = 0,  ///< 文本格式（默认）
+    BINARY = 1 ///< 紧凑二进制格式（格式串表 + 打包参数），用log_decoder解码
+};
+
+/**
+ * @brief 结构化日志（YLOG_*_KV）编码格式枚举
+ */
+enum class LogKvFormat {
+    JSON = 0,  ///< 每条日志一个JSON对象（默认）
+    LOGFMT = 1 ///< key=value，以空格分隔
+};
+
+/**
+ * @brief 日志文件输出方式枚举
+ */
+enum class LogFileSinkType {
+    BUFFERED = 0, ///< 内存缓冲 + writev批量写出（默认）
+    MMAP = 1      ///< 预分配文件并内存映射，直接拷贝到页缓存
+};
+
+/**
+ * @brief 日志时间戳来源枚举
+ */
+enum class LogTimestampSource {
+    SYSTEM_CLOCK = 0, ///< 调用线程读取系统时钟（默认）
+    TSC = 1           ///< 调用线程只读取TSC计数，后台线程按校准结果换算为墙上时间
+};
+
+/**
+ * @brief 写入线程等待新日志的方式枚举
+ */
+enum class LogWaitStrategy {
+    BLOCK = 0,          ///< 队列为空时在条件变量上阻塞（默认）
+    SPIN_THEN_BLOCK = 1 ///< 先自旋轮询一段时间再阻塞，自旋期间生产者无需加锁唤醒（仅LOCKFREE_RING队列）
+};
+
+/**
+ * @brief 日志队列容量不足时的处理策略枚举
+ */
+enum class LogOverflowPolicy {
+    DROP_NEWEST = 0, ///< 丢弃新日志（默认）
+    DROP_OLDEST = 1, ///< 丢弃队列中最旧的非错误日志，为新日志腾出空间
+    BLOCK = 2,       ///< 阻塞调用线程等待队列腾出空间，超时后丢弃
+    SAMPLE = 3       ///< 队列占用超过3/4后每N条保留1条，容量耗尽时丢弃
+};
+
+/**
+ * @brief 单个日志级别的队列容量不足处理规则
+ */
+struct LogOverflowRule {
+    LogOverflowPolicy policy = LogOverflowPolicy::DROP_NEWEST; ///< 处理策略
+    uint32_t block_timeout_ms = 10; ///< BLOCK策略最长等待时间（毫秒）
+    uint32_t sample_rate = 10;      ///< SAMPLE策略每N条保留1条
+};
+
+/**
+ * @brief 单个模块的运行时日志级别
+ */
+struct LogModuleLevel {
+    std::string module;                ///< 模块名（与YLOG_MODULE_*宏中的字面量一致）
+    LogLevel level = LogLevel::INFO;   ///< 该模块的日志级别，覆盖全局运行时级别
+};
+
+/**
+ * @brief 计算模块编号（FNV-1a哈希，可在编译期求值）
+ * @param name 模块名
+ * @return 模块编号，空模块名为0，其余不为0
+ */
+constexpr uint32_t moduleId(const char* name) {
+    if (name[0] == '\0') {
+        return 0;
+    }
+    uint32_t hash = 2166136261u;
+    for (; *name; ++name) {
+        hash = (hash ^ static_cast<uint8_t>(*name)) * 16777619u;
+    }
+    return hash ? hash : 1;
+}
+
 /**
  * @brief 日志配置结构体
  */
@@ -49,10 +153,71 @@ struct LogConfig {
     size_t max_file_size = 500 * 1024 * 1024; ///< 单日志文件最大大小（500MB）
     int max_backup_files = 10;                ///< 保留最大历史日志数
     bool rotate_by_day = true;                ///< 是否按天轮转
-    std::vector<std::string> enable_modules;  ///< 启用的模块列表
-    std::vector<std::string> filter_keywords; ///< 关键词过滤
+    std::vector<std::string> enable_modules;  ///< 启用的模块列表（非空时未列出的模块日志全部过滤；仅默认日志器）
+    std::vector<LogModuleLevel> module_levels; ///< 按模块设置的运行时级别（仅默认日志器）
+    std::vector<std::string> filter_keywords; ///< 排除词：正文包含任意一个的日志被过滤
+    std::vector<std::string> include_keywords; ///< 包含词：非空时只保留正文至少包含一个的日志
     bool enable_syslog = false;               ///< 是否启用系统日志
     std::string syslog_ident = "yalgo";     ///< 系统日志标识
+    std::string syslog_path = "/dev/log";   ///< syslog数据报套接字路径（仅Linux）
+    LogQueueType queue_type = LogQueueType::MUTEX_QUEUE; ///< 日志队列类型（仅init时生效）
+    size_t ring_capacity = 65536;             ///< 无锁环形队列槽位数（向上取整为2的幂）
+    bool enable_staging = false;              ///< 是否启用线程本地暂存缓冲批量提交（仅init时生效）
+    size_t staging_batch_size = 256;          ///< 暂存缓冲累计多少条后提交
+    uint32_t staging_flush_ms = 5;            ///< 暂存日志最长滞留时间（毫秒）
+    LogFileFormat file_format = LogFileFormat::TEXT; ///< 日志文件格式
+    LogKvFormat kv_format = LogKvFormat::JSON; ///< 结构化日志的文本编码格式
+    LogTimestampSource timestamp_source = LogTimestampSource::SYSTEM_CLOCK; ///< 时间戳来源（仅init时生效）
+    std::vector<int> writer_cpus;             ///< 写入线程绑定的CPU编号（空表示不绑定；仅init时生效）
+    int writer_nice = 0;                      ///< 写入线程的nice值（正值降低优先级，0不调整；仅init时生效）
+    bool numa_local_queue = false;            ///< 由写入线程分配并初始化环形队列，使其内存位于写入线程所在的NUMA节点（仅init时生效）
+    LogWaitStrategy wait_strategy = LogWaitStrategy::BLOCK; ///< 写入线程等待新日志的方式（仅init时生效）
+    uint32_t spin_wait_us = 50;               ///< SPIN_THEN_BLOCK每次自旋的最长时间（微秒）
+    bool crash_handler = false;               ///< 致命信号或std::terminate时把文件缓冲、写入线程已取出的积压与无锁环形队列中的日志写入文件并追加调用栈（仅init时生效，建议配合LOCKFREE_RING）
+    size_t file_flush_bytes = 64 * 1024;      ///< 文件缓冲累计多少字节后写出（0表示逐条写出）
+    uint32_t file_flush_interval_ms = 100;    ///< 文件缓冲最长滞留时间（毫秒）
+    bool file_flush_on_error = true;          ///< 错误日志是否立即写出
+    LogFileSinkType file_sink_type = LogFileSinkType::BUFFERED; ///< 日志文件输出方式
+    size_t mmap_segment_size = 64 * 1024 * 1024; ///< 内存映射输出每次预分配的字节数
+    bool compress_rotated = false;            ///< 是否在后台压缩轮转出的历史文件（.ylz）
+    size_t queue_capacity_bytes = 32 * 1024 * 1024; ///< 队列容量（按日志记录占用的字节数计）
+    LogOverflowRule overflow_warn;            ///< 警告日志的队列容量不足处理规则
+    LogOverflowRule overflow_info;            ///< 信息日志的队列容量不足处理规则
+    LogOverflowRule overflow_debug;           ///< 调试日志的队列容量不足处理规则（错误日志始终等待，不会丢弃）
+    uint32_t suppressed_report_ms = 1000;     ///< 限频宏被抑制次数的汇报周期（毫秒，0表示不汇报；仅init时生效，仅默认日志器）
+    size_t sink_queue_capacity = 65536;       ///< 独立线程输出目标（控制台、系统日志）的队列容量（条）
+};
+
+struct BinaryLogSite;
+class KeywordFilter;
+
+/**
+ * @brief 队列中的日志记录
+ *
+ * @details 时间戳在调用线程采集，时间与级别前缀由后台线程格式化。
+ * 二进制日志记录site和参数原始字节，正文同样由后台线程格式化。
+ * TSC时间戳模式下timestamp_us在队列中暂存原始计数，后台线程取出后换算为微秒。
+ */
+struct LogRecord {
+    LogLevel level = LogLevel::OFF;      ///< 日志级别
+    uint32_t thread_tag = 0;             ///< 提交线程序号
+    uint32_t thread_seq = 0;             ///< 提交线程内的递增序号（两个通道共用，用于保持同一线程的先后顺序）
+    uint64_t timestamp_us = 0;           ///< 产生时间（Unix纪元微秒，TSC模式下入队期间为原始计数）
+    std::string text;                    ///< 日志正文（不含时间和级别前缀）
+    const BinaryLogSite* site = nullptr; ///< 二进制日志调用点（文本日志为nullptr）
+    std::string args;                    ///< 二进制日志参数原始字节
+};
+
+struct StagingBuffer;
+
+/**
+ * @brief 单个优先级通道的排队时延统计
+ */
+struct LogLaneStats {
+    uint64_t logs = 0;          ///< 经过该通道写出的日志数
+    uint64_t total_wait_us = 0; ///< 从产生到被写入线程处理的总等待时间（微秒）
+    uint64_t max_wait_us = 0;   ///< 最大等待时间（微秒）
+    LogLatencyStats wait_us;    ///< 等待时间分布（微秒）
 };
 
 /**
@@ -61,29 +226,69 @@ struct LogConfig {
 struct LogStats {
     uint64_t total_logs = 0;        ///< 总日志数
     uint64_t dropped_logs = 0;      ///< 丢弃的日志数
+    uint64_t blocked_logs = 0;      ///< 因队列容量不足而阻塞等待的日志数
+    uint64_t filtered_logs = 0;     ///< 被关键词过滤的日志数
     uint64_t total_write_time = 0;  ///< 总写入耗时（微秒）
     size_t max_queue_size = 0;      ///< 队列最大长度
+    LogLatencyStats enqueue_latency;///< 调用线程提交一条日志的耗时分布（纳秒，含容量等待；每线程每16条采样1条）
+    uint64_t writer_spin_hits = 0;  ///< 写入线程自旋期间等到新日志的次数（SPIN_THEN_BLOCK）
+    uint64_t writer_blocks = 0;     ///< 写入线程因队列为空而阻塞等待的次数
+    LogLaneStats high_lane;         ///< 高优先级通道（错误、警告）
+    LogLaneStats low_lane;          ///< 普通通道（信息、调试）
+    std::vector<LogSinkStats> sinks;///< 各输出目标（首项为主日志文件）
 };
 
 /**
  * @brief 高性能异步日志器类
  * 
- * @details 单例模式，线程安全的异步日志实现，支持多输出和动态配置
+ * @details 线程安全的异步日志实现，支持多输出和动态配置。YLOG_*宏写入默认日志器
+ * （getInstance单例）；另可用createLogger创建命名日志器，各自拥有独立的队列、
+ * 写入线程、输出目标、配置与统计，经YLOG_LOGGER_*宏写入，例如把审计日志与
+ * 高频遥测日志分开，遥测日志积压或丢弃不会影响审计日志，两者也可各用一套
+ * 刷新与轮转策略。模块级别表与限频汇报只属于默认日志器；不同日志器不应写同一个文件。
  */
 class LOG_API AsyncLogger {
 private:
     /**
-     * @brief 私有构造函数（单例模式）
+     * @brief 私有构造函数（经getInstance或createLogger创建）
+     * @param name 日志器名称
+     * @param is_default 是否为默认日志器（宏快速路径级别与模块级别表只由它发布）
      */
-    AsyncLogger();
+    AsyncLogger(const std::string& name, bool is_default);
 
 public:
     /**
-     * @brief 获取日志器单例实例
+     * @brief 获取默认日志器（单例）
      * @return AsyncLogger& 日志器实例引用
      */
     static AsyncLogger& getInstance();
 
+    /**
+     * @brief 创建命名日志器，按config初始化并启动其写入线程
+     * @param name 日志器名称（非空，不能与已有的命名日志器重名）
+     * @param config 日志配置
+     * @return 日志器；名称为空或已存在时返回nullptr
+     */
+    static std::shared_ptr<AsyncLogger> createLogger(const std::string& name, const LogConfig& config);
+
+    /**
+     * @brief 按名称查找命名日志器
+     * @param name 日志器名称
+     * @return 日志器，不存在时返回nullptr
+     */
+    static std::shared_ptr<AsyncLogger> getLogger(const std::string& name);
+
+    /**
+     * @brief 注销命名日志器；最后一个引用释放时写完队列中的日志并停止写入线程
+     * @param name 日志器名称
+     */
+    static void dropLogger(const std::string& name);
+
+    /**
+     * @brief 日志器名称（默认日志器为"default"）
+     */
+    const std::string& name() const { return name_; }
+
     /**
      * @brief 禁用拷贝构造函数
      */
@@ -132,11 +337,112 @@ public:
     /**
      * @brief 提交日志消息（内部使用）
      * @param level 日志级别
-     * @param level_str 日志级别字符串
+     * @param level_str 日志级别字符串（保留兼容，输出前缀按level生成）
      * @param message 日志内容
      */
     void log(LogLevel level, const std::string& level_str, const std::string& message);
 
+    /**
+     * @brief 判断日志级别当前是否会被记录：一次relaxed原子读
+     * @param level 日志级别
+     * @return 后台线程运行中且级别不高于运行时级别时返回true
+     */
+    bool isEnabled(LogLevel level) const {
+        return static_cast<int>(level) <= enabled_level_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 按本日志器的模块级别表判断日志级别当前是否会被记录
+     *
+     * @details 模块级别表按模块编号的低位索引，命中时只多一次数组读取；
+     * 未设置级别的模块沿用运行时级别（enable_modules非空时为OFF）。
+     * module_id为0（无模块）时等价于isEnabled。
+     * @param module_id 模块编号（moduleId）
+     * @param level 日志级别
+     * @return 级别当前是否会被记录
+     */
+    bool isModuleEnabled(uint32_t module_id, LogLevel level) const {
+        int global = enabled_level_.load(std::memory_order_relaxed);
+        if (module_id == 0 || global < 0) {
+            return static_cast<int>(level) <= global;
+        }
+        uint64_t entry = module_levels_[module_id & (MODULE_TABLE_SIZE - 1)].load(std::memory_order_relaxed);
+        int limit;
+        if (static_cast<uint32_t>(entry >> 32) == module_id) {
+            limit = static_cast<int>(entry & 0xFF);
+        } else if (entry == 0) {
+            limit = module_default_level_.load(std::memory_order_relaxed);
+        } else {
+            limit = findModuleLevel(module_id);
+        }
+        if (limit == MODULE_LEVEL_GLOBAL) {
+            limit = global;
+        }
+        return static_cast<int>(level) <= limit;
+    }
+
+    /**
+     * @brief 日志宏使用的默认日志器级别检查：不调用getInstance
+     *
+     * @details 经由默认日志器指针读取其级别，与getInstance().isEnabled等价；
+     * 默认日志器尚未构造或后台线程未运行时全部过滤。宏在此检查通过之前
+     * 不会求值任何参数表达式。
+     * @param level 日志级别
+     * @return 级别当前是否会被记录
+     */
+    static bool levelEnabled(LogLevel level) {
+        const AsyncLogger* logger = default_logger_.load(std::memory_order_acquire);
+        return logger && logger->isEnabled(level);
+    }
+
+    /**
+     * @brief 模块日志宏使用的默认日志器级别检查（getInstance().isModuleEnabled）
+     * @param module_id 模块编号（moduleId）
+     * @param level 日志级别
+     * @return 级别当前是否会被记录
+     */
+    static bool moduleLevelEnabled(uint32_t module_id, LogLevel level) {
+        const AsyncLogger* logger = default_logger_.load(std::memory_order_acquire);
+        return logger && logger->isModuleEnabled(module_id, level);
+    }
+
+    /**
+     * @brief 提交模块日志，按模块级别检查
+     * @param module_id 模块编号（moduleId）
+     * @param level 日志级别
+     * @param message 日志内容（已含"[module] "前缀）
+     */
+    void logModule(uint32_t module_id, LogLevel level, const std::string& message);
+
+    /**
+     * @brief 动态设置单个模块的运行时级别
+     * @param module 模块名
+     * @param level 目标日志级别
+     */
+    void setModuleLogLevel(const std::string& module, LogLevel level);
+
+    /**
+     * @brief 注册输出目标
+     *
+     * @details 慢速目标应使用独立线程：写入线程只把日志放入该目标的有界队列，
+     * 队列满时丢弃并计入该目标的统计，不影响文件和其他目标。
+     * @param sink 输出目标
+     * @param dedicated_thread 是否使用独立线程（false时在写入线程上直接调用）
+     */
+    void addSink(std::shared_ptr<LogSink> sink, bool dedicated_thread = true);
+
+    /**
+     * @brief 注销输出目标，返回前写完其队列中的日志
+     * @param sink 已注册的输出目标
+     */
+    void removeSink(const std::shared_ptr<LogSink>& sink);
+
+    /**
+     * @brief 提交已构造的日志记录（内部使用，调用方需先检查isEnabled）
+     * @param record 日志记录，时间戳在此处采集
+     */
+    void submit(LogRecord&& record);
+
     /**
      * @brief 从环境变量加载日志配置
      */
@@ -158,35 +464,140 @@ public:
      */
     ~AsyncLogger();
 
-private:
     /**
-     * @brief 格式化当前时间
+     * @brief 格式化时间戳
+     * @param timestamp_us Unix纪元微秒时间戳
      * @return std::string 格式化后的时间字符串
      */
-    static std::string getFormattedTime();
+    static std::string getFormattedTime(uint64_t timestamp_us);
 
     /**
-     * @brief 获取控制台颜色转义序列
+     * @brief 格式化时间戳到缓冲区（"YYYY-mm-dd HH:MM:SS.uuuuuu"）
+     *
+     * @details 每个线程缓存当前秒的日期时间前缀，同一秒内只改写微秒位。
+     * @param timestamp_us Unix纪元微秒时间戳
+     * @param buf 输出缓冲区，至少TIME_BUFFER_SIZE字节
+     * @return size_t 写入的字符数（不含结尾'\0'）
+     */
+    static size_t formatTimestamp(uint64_t timestamp_us, char* buf);
+
+    static const size_t TIME_BUFFER_SIZE = 32; ///< formatTimestamp所需缓冲区大小
+
+    /**
+     * @brief 获取日志级别字符串
      * @param level 日志级别
-     * @return std::string 颜色转义序列
+     * @return const char* 级别字符串
      */
-    std::string getColorCode(LogLevel level) const;
+    static const char* levelToString(LogLevel level);
 
+private:
     /**
-     * @brief 检查并切割日志文件
+     * @brief 把running_与runtime_level_合成为isEnabled使用的级别
      */
-    void checkLogRotation();
+    void publishLevel();
 
     /**
-     * @brief 执行日志文件轮转
+     * @brief 按enable_modules与module_levels重建模块级别表（调用方需持有config_mutex_）
+     * @param config 日志配置
      */
-    void rotateLogFile();
+    void applyModuleConfig(const LogConfig& config);
+
+    /**
+     * @brief 模块级别表首个槽位被其他模块占用时，沿线性探测序列查找
+     * @param module_id 模块编号
+     * @return 模块级别，未设置时返回默认级别
+     */
+    int findModuleLevel(uint32_t module_id) const;
+
+    /**
+     * @brief 按配置打开日志文件，二进制格式的新文件写入文件头
+     * （后台线程运行时只由后台线程调用，否则调用方需持有config_mutex_）
+     * @param config 日志配置
+     */
+    void openLogFile(const LogConfig& config);
+
+    /**
+     * @brief 把config_复制为不可变快照并原子发布（调用方需持有config_mutex_）
+     */
+    void publishConfig();
+
+    /**
+     * @brief 写入线程取最新配置快照；文件路径、格式或输出方式变化时在写入线程上重新打开文件
+     */
+    void refreshWriterConfig();
+
+    /**
+     * @brief 新打开或轮转后的文件准备：校正写游标，二进制新文件写入文件头
+     */
+    void startLogFile();
+
+    /**
+     * @brief 检查并切割日志文件（仅后台线程调用，每条日志两次整数比较）
+     * @param config 当前配置
+     * @param now_us 当前日志的时间戳（Unix纪元微秒）
+     */
+    void checkLogRotation(const LogConfig& config, uint64_t now_us);
+
+    /**
+     * @brief 执行日志文件轮转，并安排维护线程压缩历史文件、清理多余的历史文件
+     * @param config 当前配置
+     */
+    void rotateLogFile(const LogConfig& config);
+
+    /**
+     * @brief 计算下一个本地零点
+     * @param now_us 当前时间（Unix纪元微秒）
+     * @return uint64_t 下一个零点（Unix纪元微秒）
+     */
+    static uint64_t nextMidnightMicros(uint64_t now_us);
+
+    /**
+     * @brief 删除最旧的历史日志文件，只保留max_backup_files个（在维护线程执行）
+     * @param log_path 日志文件路径
+     * @param max_backup_files 保留的历史文件数
+     */
+    static void pruneBackupFiles(const std::string& log_path, int max_backup_files);
+
+    /**
+     * @brief 提交后台维护任务，维护线程在首次提交时启动
+     * @param task 任务
+     */
+    void scheduleMaintenance(std::function<void()> task);
+
+    /**
+     * @brief 维护线程主循环（以低优先级运行）
+     */
+    void runMaintenance();
 
     /**
      * @brief 后台线程处理日志队列
      */
     void processLogs();
 
+    /**
+     * @brief 崩溃写出回调（在信号处理函数中调用）
+     */
+    static void onCrash(void* context, const CrashInfo& crash);
+
+    /**
+     * @brief 把文件缓冲与无锁环形队列中的日志直接写入文件，再追加调用栈
+     *
+     * @details 只使用原子读取、栈上缓冲、nanosleep与write/fstat，不加锁、不读取生产者
+     * 可能正在修改的容器。崩溃发生在其他线程时先请写入线程停止，轮询等它在一段日志之间
+     * 停住或确认它正阻塞等待（最多1秒，超时不写出）后才碰文件；随后写出它已取出、尚未写出
+     * 的积压，再按时间戳归并写出两个环形队列。二进制文件写出BINARY/TEXT条目，调用栈只有
+     * 地址。带锁队列与暂存缓冲中的日志不写出；崩溃发生在写入线程自身时积压也不写出。
+     */
+    void writePendingOnCrash(const CrashInfo& crash);
+
+    /**
+     * @brief 崩溃处理期间停住写入线程，不再返回（在写入线程上调用）
+     *
+     * @details 只在一段日志整体写完之后调用，此时已取出未写出的日志都在backlog_中；
+     * 置位writer_parked_通知崩溃处理可以写文件。
+     */
+    [[noreturn]] void parkWriter();
+
     /**
      * @brief 解析日志级别字符串
      * @param level_str 级别字符串
@@ -194,20 +605,407 @@ private:
      */
     LogLevel parseLogLevel(const std::string& level_str);
 
+    /**
+     * @brief 解析模块级别列表
+     * @param value 形如 "earth=DEBUG, log=WARN"
+     * @return 模块级别，无法识别的级别按OFF处理
+     */
+    std::vector<LogModuleLevel> parseModuleLevels(const std::string& value);
+
+    /**
+     * @brief 按配置创建日志队列并启动后台线程（调用方需持有config_mutex_）
+     */
+    void startWorker();
+
+    /**
+     * @brief 按config_创建环形队列（numa_local_queue时由写入线程调用）
+     */
+    void createQueues();
+
+    /**
+     * @brief 按配置设置写入线程的CPU亲和性与优先级（在写入线程上调用）
+     */
+    void applyWriterThreadConfig();
+
+    /**
+     * @brief SPIN_THEN_BLOCK：阻塞前先自旋等待环形队列出现日志，按命中情况调整自旋时长
+     * @return 自旋期间是否等到日志
+     */
+    bool spinForLogs();
+
+    /**
+     * @brief 从当前队列批量取出日志
+     * @param batch 接收日志记录（追加）
+     * @param wait 队列为空时是否阻塞等待
+     * @return 是否取到日志
+     */
+    bool dequeueLogs(std::vector<LogRecord>& batch, bool wait);
+
+    /**
+     * @brief 写入无锁环形队列；槽位耗尽时错误日志在容量条件变量上等待后台线程腾出槽位
+     * @param ring 环形队列
+     * @param record 日志记录（失败时保持不变）
+     * @return 是否入队成功
+     */
+    bool pushRing(MpscRingBuffer<LogRecord>& ring, LogRecord&& record);
+
+    /**
+     * @brief 唤醒可能正在休眠的后台线程（环形队列模式）
+     */
+    void wakeConsumer();
+
+    /**
+     * @brief 错误、警告日志写入高优先级通道
+     * @param record 日志记录
+     * @param bytes 已预留的队列字节数
+     */
+    void enqueueHighLane(LogRecord&& record, size_t bytes);
+
+    /**
+     * @brief 把限频宏在本周期内被抑制的次数作为汇总日志入队（仅后台线程调用，队列满时丢弃）
+     * @param now_us 当前时间（Unix纪元微秒）
+     */
+    void reportSuppressed(uint64_t now_us);
+
+    /**
+     * @brief 高优先级通道是否有待写出的日志
+     */
+    bool highLanePending() const;
+
+    /**
+     * @brief 非阻塞取出高优先级通道中的全部日志并写出，直到通道为空
+     * @param batch 工作缓冲
+     * @return 是否写出了日志
+     */
+    bool drainHighLane(std::vector<LogRecord>& batch);
+
+    /**
+     * @brief 非阻塞取出高优先级通道中的全部日志
+     * @param batch 接收日志记录（先清空）
+     * @return 是否取到日志
+     */
+    bool takeHighLane(std::vector<LogRecord>& batch);
+
+    /**
+     * @brief 把普通通道中已入队的日志追加到backlog_（写出高优先级日志之前调用）
+     *
+     * @details 高优先级日志已取出时，同一线程更早提交的普通日志一定已经入队；
+     * 环形队列中被其他生产者占用但尚未写完的槽位会短暂等待。backlog_非空时
+     * 追加部分的队列字节数暂不释放，待backlog_写完后释放，内存仍受队列容量约束。
+     */
+    void pullLowLane();
+
+    /**
+     * @brief 写出一批高优先级日志，同一线程序号更小的普通日志从backlog_中摘出写在其前
+     * @param batch 高优先级日志（各线程内按提交顺序排列）
+     */
+    void writeHighLane(std::vector<LogRecord>& batch);
+
+    /**
+     * @brief 清空backlog_并释放其中暂未释放的队列字节数
+     */
+    void resetBacklog();
+
+    /**
+     * @brief 写出一段日志并统计排队时延
+     * @param batch 日志记录（时间戳已换算为微秒）
+     * @param begin 起始下标
+     * @param end 结束下标
+     * @param lane 通道统计下标（HIGH_LANE或LOW_LANE）
+     */
+    void writeRecords(const std::vector<LogRecord>& batch, size_t begin, size_t end, int lane);
+
+    /**
+     * @brief 按关键词过滤日志正文（二进制日志先格式化正文）
+     * @param record 日志记录
+     * @param filter 关键词过滤器
+     * @return 是否保留
+     */
+    bool acceptRecord(const LogRecord& record, const KeywordFilter& filter);
+
+    /**
+     * @brief 关键词列表变化时重建过滤器并原子替换（调用方需持有config_mutex_）
+     * @param config 日志配置
+     */
+    void applyKeywordConfig(const LogConfig& config);
+
+    /**
+     * @brief 将记录追加到调用线程的暂存缓冲，满时整块提交
+     * @param record 日志记录
+     */
+    void stageRecord(LogRecord&& record);
+
+    /**
+     * @brief 提交一个暂存块到后台线程（调用方需持有该缓冲的互斥锁）
+     * @param buffer 所属暂存缓冲
+     * @param block 日志块
+     */
+    void publishBlock(StagingBuffer& buffer, std::vector<LogRecord>&& block);
+
+    /**
+     * @brief 提交超时或所属线程已退出的暂存缓冲
+     * @param force 是否无视期限提交全部暂存日志
+     */
+    void sweepStagingBuffers(bool force);
+
+    /**
+     * @brief 按线程分组并按时间戳归并已提交的暂存块
+     * @param batch 接收归并后的日志记录（追加）
+     * @param wait 没有可用日志块时是否等待
+     * @return 是否取到日志
+     */
+    bool collectStagedBlocks(std::vector<LogRecord>& batch, bool wait);
+
+    /**
+     * @brief 输出一条日志记录到各目标
+     * @param record 日志记录
+     */
+    void writeRecord(const LogRecord& record);
+
+    /**
+     * @brief 按刷新策略写出文件缓冲
+     * @param idle 队列是否已取空
+     */
+    void commitLogFile(bool idle);
+
+    /**
+     * @brief 把本段攒下的输出目标日志作为一个共享批次提交给各通道
+     */
+    void commitSinks();
+
+    /**
+     * @brief 从批次池取一个各通道都已写完的批次，没有时新建
+     */
+    void acquireSinkBatch();
+
+    /**
+     * @brief 写出文件缓冲并统计耗时
+     */
+    void flushLogFile();
+
+    /**
+     * @brief 累计一次主日志文件写入耗时（缓冲方式为一次批量写出，内存映射方式为一条日志的拷贝）
+     * @param cost 耗时（纳秒）
+     */
+    void recordFileWrite(uint64_t cost);
+
+    /**
+     * @brief 按配置创建或停止控制台、系统日志输出通道（调用方需持有config_mutex_）
+     * @param config 日志配置
+     */
+    void applySinkConfig(const LogConfig& config);
+
+    /**
+     * @brief 发布输出通道列表，写入线程从下一段日志开始使用（调用方需持有sinks_mutex_）
+     */
+    void publishSinks();
+
+    /**
+     * @brief 采集当前时间戳（系统时钟微秒或TSC计数）
+     * @return uint64_t 时间戳
+     */
+    uint64_t captureTimestamp() const;
+
+    /**
+     * @brief 校准TSC计数与墙上时间的换算关系
+     * @param initial 是否为启动时的首次校准
+     */
+    void calibrateTicks(bool initial);
+
+    /**
+     * @brief 将一批日志的TSC计数换算为Unix纪元微秒（仅后台线程调用）
+     * @param batch 日志记录
+     * @param begin 起始下标（之前的记录已换算）
+     */
+    void convertTimestamps(std::vector<LogRecord>& batch, size_t begin = 0);
+
+    /**
+     * @brief 按配置更新队列容量与各级别的容量不足处理规则
+     * @param config 日志配置
+     */
+    void applyOverflowConfig(const LogConfig& config);
+
+    /**
+     * @brief 为一条日志预留队列容量，不足时按级别策略丢弃、腾出空间或等待
+     * @param level 日志级别
+     * @param bytes 日志记录占用的字节数
+     * @return 是否允许入队
+     */
+    bool admitRecord(LogLevel level, size_t bytes);
+
+    /**
+     * @brief 容量足够（或队列为空）时预留字节数
+     * @param bytes 字节数
+     * @return 是否预留成功
+     */
+    bool tryReserveQueueBytes(size_t bytes);
+
+    /**
+     * @brief 阻塞等待队列腾出空间并预留
+     * @param bytes 字节数
+     * @param timeout_ms 最长等待时间（毫秒）
+     * @param forever 是否无限等待（错误日志）
+     * @return 是否预留成功
+     */
+    bool waitQueueSpace(size_t bytes, uint32_t timeout_ms, bool forever);
+
+    /**
+     * @brief 丢弃队列中最旧的非错误日志，释放至少bytes字节；
+     * 无法在队列中直接丢弃的部分（环形队列、线程暂存缓冲）由后台线程取出后丢弃
+     * @param bytes 需要释放的字节数
+     */
+    void evictOldest(size_t bytes);
+
+    /**
+     * @brief 登记待后台线程丢弃的字节数（总数不超过队列中尚未取出的字节数与容量的1/4）
+     * @param bytes 字节数
+     */
+    void addEvictDebt(size_t bytes);
+
+    /**
+     * @brief 后台线程取出日志后释放其占用的队列容量，并唤醒等待空间的调用线程
+     * @param bytes 字节数
+     */
+    void releaseQueueBytes(size_t bytes);
+
+    /**
+     * @brief 释放刚取出的一批日志占用的队列容量，并按生产者未能直接完成的腾空请求
+     * 丢弃本批中最旧的非错误日志（仅后台线程调用）
+     * @param batch 日志记录
+     * @param evict 是否处理腾空请求（高优先级通道不丢弃）
+     */
+    void releaseBatch(std::vector<LogRecord>& batch, bool evict);
+
+    /**
+     * @brief 更新队列最大长度统计
+     * @param size 当前队列长度
+     */
+    void updateMaxQueueSize(size_t size);
+
+    /**
+     * @brief 按级别与队列模式把日志放入队列（submit计时后调用）
+     * @param record 日志记录
+     */
+    void enqueueRecord(LogRecord&& record);
+
+    std::string name_;                   ///< 日志器名称
+    bool is_default_;                    ///< 是否为默认日志器
+    uint64_t instance_id_;               ///< 进程内唯一的实例序号（区分各日志器的线程暂存缓冲）
     std::atomic<bool> running_;          ///< 后台线程运行标志
     std::atomic<LogLevel> runtime_level_;///< 运行时日志级别
     LogConfig config_;                   ///< 当前日志配置
     mutable std::mutex config_mutex_;    ///< 配置修改互斥锁
+    std::shared_ptr<const LogConfig> config_snapshot_; ///< 配置快照（std::atomic_load/atomic_store访问，修改后整体替换）
+    std::shared_ptr<const LogConfig> writer_config_;   ///< 写入线程持有的配置快照，每段日志刷新一次
     std::mutex queue_mutex_;             ///< 日志队列互斥锁
     std::condition_variable queue_cv_;   ///< 队列条件变量
-    std::queue<std::string> log_queue_;  ///< 日志消息队列
+    std::deque<LogRecord> log_queue_;    ///< 日志消息队列
+    std::unique_ptr<MpscRingBuffer<LogRecord>> ring_queue_; ///< 无锁环形队列（LOCKFREE_RING模式）
+    std::deque<LogRecord> high_queue_;   ///< 高优先级通道（错误、警告），受queue_mutex_保护
+    std::atomic<size_t> high_queue_size_;///< 高优先级通道长度，供后台线程无锁检查
+    std::unique_ptr<MpscRingBuffer<LogRecord>> high_ring_; ///< 高优先级无锁环形队列（LOCKFREE_RING模式）
+    bool staging_enabled_ = false;       ///< 是否启用暂存缓冲模式
+    size_t staging_batch_size_ = 256;    ///< 暂存块大小
+    uint64_t staging_flush_us_ = 5000;   ///< 暂存日志最长滞留时间（微秒）
+    uint64_t staging_flush_span_ = 5000; ///< 暂存日志最长滞留时间（时间戳单位）
+    bool tsc_timestamps_ = false;        ///< 是否使用TSC时间戳
+    uint64_t tick_anchor_ = 0;           ///< 校准锚点：TSC计数
+    uint64_t wall_anchor_us_ = 0;        ///< 校准锚点：Unix纪元微秒
+    double ticks_per_us_ = 1.0;          ///< 每微秒TSC计数
+    uint64_t next_calibrate_us_ = 0;     ///< 下次重新校准的墙上时间
+    std::mutex staging_mutex_;           ///< 暂存缓冲登记表互斥锁
+    std::vector<std::shared_ptr<StagingBuffer>> staging_buffers_; ///< 已登记的线程暂存缓冲
+    std::vector<std::pair<uint64_t, std::vector<LogRecord>>> staged_blocks_; ///< 已提交的暂存块（线程序号, 日志块），受queue_mutex_保护
+    std::atomic<bool> consumer_waiting_; ///< 后台线程是否即将阻塞等待
+    bool spin_wait_ = false;             ///< 是否先自旋再阻塞（SPIN_THEN_BLOCK且为环形队列）
+    uint64_t spin_limit_ns_ = 0;         ///< 自旋时长上限（纳秒）
+    uint64_t spin_budget_ns_ = 0;        ///< 当前自旋时长：命中时加倍、落空时减半（仅写入线程使用）
+    std::atomic<uint64_t> spin_hits_;    ///< 统计：自旋期间等到日志的次数
+    std::atomic<uint64_t> writer_blocks_;///< 统计：写入线程阻塞等待的次数
     std::thread log_thread_;             ///< 后台日志线程
-    std::ofstream log_file_;             ///< 日志文件流
-    LogStats stats_;                     ///< 日志性能统计
-    mutable std::mutex stats_mutex_;     ///< 统计信息互斥锁
+    std::unique_ptr<FileSink> log_file_; ///< 日志文件输出
+    LogFileSinkType file_sink_type_ = LogFileSinkType::BUFFERED; ///< 当前文件输出方式
+    uint64_t file_pending_since_us_ = 0; ///< 文件缓冲中最早一条未写出日志的时间
+    uint64_t file_flush_interval_us_ = 100000; ///< 文件缓冲最长滞留时间（微秒）
+    LogFileFormat file_format_ = LogFileFormat::TEXT; ///< 当前打开文件的格式
+    std::vector<bool> written_sites_;    ///< 当前二进制文件中已写入定义的格式串编号
+    std::string binary_buffer_;          ///< 二进制条目编码缓冲
+    std::string line_buffer_;            ///< 文本行格式化缓冲（仅写入线程使用）
+    std::vector<LogRecord> backlog_;     ///< 普通通道已取出、尚未写完的日志（仅写入线程使用）
+    size_t backlog_position_ = 0;        ///< backlog_中下一条待写出的位置
+    size_t backlog_held_bytes_ = 0;      ///< backlog_中提前取出、尚未释放的队列字节数
+    bool crash_registered_ = false;      ///< 是否已登记崩溃写出回调
+    std::atomic<bool> crash_stop_;       ///< 崩溃处理要求写入线程停止
+    std::atomic<bool> writer_parked_;    ///< 写入线程已停住或正阻塞等待，不在修改文件与积压（崩溃处理中轮询）
+    std::atomic<uintptr_t> writer_thread_; ///< 写入线程的本机线程句柄，未进入或已退出处理循环时为0（崩溃处理中比较）
+    ShardedCounter total_logs_;          ///< 统计：总日志数（按调用线程分片）
+    ShardedCounter dropped_logs_;        ///< 统计：丢弃的日志数（按调用线程分片）
+    ShardedLatencyHistogram enqueue_histogram_; ///< 统计：提交耗时分布（纳秒，按间隔采样）
+    static const uint32_t ENQUEUE_SAMPLE_INTERVAL = 16; ///< 每个调用线程每多少条采样一次提交耗时
+    std::atomic<uint64_t> total_write_time_; ///< 统计：总写入耗时（微秒）
+    std::atomic<size_t> max_queue_size_; ///< 统计：队列最大长度
     size_t current_queue_size_ = 0;      ///< 当前队列长度
-    std::string last_rotate_date_;       ///< 上次轮转日期
-    const size_t MAX_QUEUE_SIZE = 100000;///< 队列最大长度
+    ShardedCounter blocked_logs_;        ///< 统计：阻塞等待的日志数（按调用线程分片）
+    std::atomic<uint64_t> filtered_logs_; ///< 统计：被关键词过滤的日志数
+    std::shared_ptr<const KeywordFilter> keyword_filter_; ///< 关键词过滤器（std::atomic_load/atomic_store访问，无关键词时为空）
+    std::string filter_buffer_;          ///< 二进制日志正文格式化缓冲（仅写入线程使用）
+    std::mutex sinks_mutex_;             ///< 输出通道登记互斥锁
+    std::shared_ptr<SinkChannel> console_channel_; ///< 控制台输出通道（受sinks_mutex_保护）
+    std::shared_ptr<SinkChannel> syslog_channel_;  ///< 系统日志输出通道（受sinks_mutex_保护）
+    bool console_color_ = false;         ///< 控制台通道创建时的颜色设置
+    std::string syslog_ident_;           ///< 系统日志通道创建时的标识
+    std::string syslog_path_;            ///< 系统日志通道创建时的套接字路径
+    std::vector<std::shared_ptr<SinkChannel>> user_channels_; ///< 用户注册的输出通道（受sinks_mutex_保护）
+    std::shared_ptr<const std::vector<std::shared_ptr<SinkChannel>>> sinks_; ///< 全部输出通道（std::atomic_load/atomic_store访问）
+    std::shared_ptr<const std::vector<std::shared_ptr<SinkChannel>>> writer_sinks_; ///< 写入线程持有的通道列表快照
+    std::shared_ptr<LogSinkBatch> sink_batch_; ///< 本段待分发给输出目标的日志（仅写入线程使用）
+    std::vector<std::shared_ptr<LogSinkBatch>> sink_batch_pool_; ///< 复用的批次，保留缓冲容量（仅写入线程使用）
+    static const size_t SINK_BATCH_POOL_SIZE = 8; ///< 批次池最多保留的批次数
+    std::atomic<uint64_t> file_messages_; ///< 统计：写入主日志文件的日志数
+    std::atomic<uint64_t> file_bytes_;   ///< 统计：写入主日志文件的字节数
+    std::atomic<uint64_t> file_write_ns_;///< 统计：主日志文件总写入耗时（纳秒）
+    std::atomic<uint64_t> file_max_write_ns_; ///< 统计：主日志文件单次最大写入耗时（纳秒）
+    LatencyHistogram file_write_histogram_; ///< 统计：主日志文件写入耗时分布（纳秒）
+
+    static const int HIGH_LANE = 0;      ///< 高优先级通道统计下标
+    static const int LOW_LANE = 1;       ///< 普通通道统计下标
+    static const size_t LANE_SLICE = 256;///< 普通通道每写出多少条检查一次高优先级通道
+    std::atomic<uint64_t> lane_logs_[2]; ///< 统计：各通道写出的日志数
+    std::atomic<uint64_t> lane_wait_us_[2];     ///< 统计：各通道总排队时间（微秒）
+    std::atomic<uint64_t> lane_max_wait_us_[2]; ///< 统计：各通道最大排队时间（微秒）
+    LatencyHistogram lane_wait_histogram_[2];   ///< 统计：各通道排队时间分布（微秒）
+
+    /**
+     * @brief 单个级别的容量不足处理规则（原子字段，调用线程无锁读取）
+     */
+    struct OverflowState {
+        std::atomic<int> policy{0};             ///< LogOverflowPolicy
+        std::atomic<uint32_t> block_timeout_ms{10}; ///< BLOCK最长等待时间（毫秒）
+        std::atomic<uint32_t> sample_rate{10};  ///< SAMPLE每N条保留1条
+        std::atomic<uint64_t> sample_counter{0};///< SAMPLE计数
+    };
+
+    OverflowState overflow_states_[5];   ///< 按LogLevel索引的容量不足处理规则
+    std::atomic<size_t> queue_capacity_bytes_; ///< 队列容量（字节）
+    std::atomic<size_t> queued_bytes_;   ///< 已入队尚未被后台线程取出的字节数
+    std::atomic<size_t> evict_bytes_;    ///< 待后台线程丢弃的最旧日志字节数
+    std::mutex space_mutex_;             ///< 等待队列空间的互斥锁
+    std::condition_variable space_cv_;   ///< 队列空间条件变量
+    std::atomic<int> space_waiters_;     ///< 正在等待队列空间的调用线程数
+    uint64_t next_rotate_us_ = 0;        ///< 下一次按天轮转的时间（Unix纪元微秒，0表示尚未计算）
+    uint64_t suppressed_report_us_ = 0;  ///< 限频汇报周期（微秒）
+    uint64_t last_report_us_ = 0;        ///< 上次限频汇报时间（Unix纪元微秒）
+    std::thread maintenance_thread_;     ///< 维护线程（历史文件压缩与清理）
+    std::mutex maintenance_mutex_;       ///< 维护任务队列互斥锁
+    std::condition_variable maintenance_cv_; ///< 维护任务条件变量
+    std::deque<std::function<void()>> maintenance_tasks_; ///< 维护任务队列
+    bool maintenance_stop_ = false;      ///< 维护线程退出标志
+    static std::atomic<AsyncLogger*> default_logger_; ///< 默认日志器（构造前为nullptr），宏快速路径经由它读取级别
+    static const size_t MODULE_TABLE_SIZE = 256; ///< 模块级别表槽位数（2的幂）
+    static const int MODULE_LEVEL_GLOBAL = 0xFF; ///< 模块级别：沿用运行时级别
+    std::atomic<int> enabled_level_;     ///< 级别检查读取的级别（后台线程未运行时为-1）
+    std::atomic<uint64_t> module_levels_[MODULE_TABLE_SIZE]; ///< 模块级别表：编号<<32|级别，0为空槽
+    std::atomic<int> module_default_level_; ///< 未设置级别的模块使用的级别
 };
 
 /**
@@ -218,31 +1016,113 @@ private:
  */
 LOG_API std::string formatLog(const char* format, ...);
 
-// 流式日志辅助类
+/**
+ * @brief 流式日志辅助类
+ *
+ * @details 正文直接追加到线程本地的复用缓冲：整数、浮点数、字符串由内置重载
+ * 用std::to_chars格式化（浮点数与std::ostream默认格式一致，%g、6位有效数字），
+ * 稳态下格式化过程不分配内存。其他类型和流操纵符回退到绑定同一缓冲的std::ostream，
+ * 回退之后本条日志余下的值都经std::ostream输出，操纵符对后续内置类型同样生效。
+ * 允许在<<链中嵌套使用流式日志（各自记录在缓冲中的起点）。
+ */
 class LOG_API LogStream {
 public:
-    LogStream(LogLevel level, const std::string& level_str,
+    LogStream(LogLevel level, const char* level_str,
               const char* file, int line, const char* func,
-              const std::string& module = "");
+              const char* module = "");
+
+    // 写入指定日志器（按该日志器的运行时级别检查）
+    LogStream(AsyncLogger& logger, LogLevel level, const char* file, int line, const char* func);
 
     // 析构时自动提交日志
     ~LogStream();
 
-    // 重载<<运算符，支持各种类型
+    LogStream(const LogStream&) = delete;
+    LogStream& operator=(const LogStream&) = delete;
+
+    LogStream& operator<<(const std::string& value) { return appendText(value.data(), value.size()); }
+    LogStream& operator<<(std::string_view value) { return appendText(value.data(), value.size()); }
+    LogStream& operator<<(const char* value) {
+        return value ? appendText(value, std::char_traits<char>::length(value)) : appendText("(null)", 6);
+    }
+    LogStream& operator<<(char value) { return appendText(&value, 1); }
+    LogStream& operator<<(bool value) { return appendInteger(static_cast<int>(value)); }
+    LogStream& operator<<(short value) { return appendInteger(value); }
+    LogStream& operator<<(unsigned short value) { return appendInteger(value); }
+    LogStream& operator<<(int value) { return appendInteger(value); }
+    LogStream& operator<<(unsigned int value) { return appendInteger(value); }
+    LogStream& operator<<(long value) { return appendInteger(value); }
+    LogStream& operator<<(unsigned long value) { return appendInteger(value); }
+    LogStream& operator<<(long long value) { return appendInteger(value); }
+    LogStream& operator<<(unsigned long long value) { return appendInteger(value); }
+    LogStream& operator<<(float value) { return appendFloat(value); }
+    LogStream& operator<<(double value) { return appendFloat(value); }
+    LogStream& operator<<(long double value) { return appendFloat(value); }
+
+    // 其他类型（用户类型、指针、操纵符等）回退到std::ostream
     template<typename T>
     LogStream& operator<<(const T& value) {
-        stream_ << value;
+        fallbackStream() << value;
         return *this;
     }
 
 private:
+    LogStream& appendText(const char* data, size_t size) {
+        if (stream_) {
+            *stream_ << std::string_view(data, size);
+        } else {
+            buffer_->append(data, size);
+        }
+        return *this;
+    }
+
+    template<typename T>
+    LogStream& appendInteger(T value) {
+        if (stream_) {
+            *stream_ << value;
+            return *this;
+        }
+        char buf[24];
+        std::to_chars_result result = std::to_chars(buf, buf + sizeof(buf), value);
+        buffer_->append(buf, static_cast<size_t>(result.ptr - buf));
+        return *this;
+    }
+
+    template<typename T>
+    LogStream& appendFloat(T value) {
+        if (stream_) {
+            *stream_ << value;
+            return *this;
+        }
+        char buf[64];
+        std::to_chars_result result = std::to_chars(buf, buf + sizeof(buf), value, std::chars_format::general, 6);
+        buffer_->append(buf, static_cast<size_t>(result.ptr - buf));
+        return *this;
+    }
+
+    /**
+     * @brief 本条日志首次回退时重置线程本地std::ostream的格式状态
+     */
+    std::ostream& fallbackStream();
+
+    /**
+     * @brief 在线程本地缓冲中记下起点并写入"[模块] [文件:行号:函数] "前缀
+     */
+    void beginRecord(const char* file, int line, const char* func);
+
+    AsyncLogger* logger_ = nullptr;  ///< 目标日志器，nullptr为默认日志器（按模块级别检查）
     LogLevel level_;
-    std::string level_str_;
-    const char* file_;
-    int line_;
-    const char* func_;
-    std::string module_;
-    std::ostringstream stream_;
+    const char* module_;
+    std::string* buffer_;            ///< 线程本地格式化缓冲
+    size_t begin_;                   ///< 本条日志在缓冲中的起点
+    std::ostream* stream_ = nullptr; ///< 已回退时为绑定缓冲的std::ostream
+};
+
+/**
+ * @brief 把流式日志表达式转换为void，使级别检查能以条件表达式包裹<<链
+ */
+struct LogStreamVoidify {
+    void operator&(const LogStream&) {}
 };
 
 } // namespace log
@@ -253,13 +1133,47 @@ private:
 #define YALGO_LOG_LEVEL 4 // DEBUG级别
 #endif
 
+// 分支预测提示：日志宏的运行时级别检查按"多数调用被过滤"优化
+#if defined(__GNUC__) || defined(__clang__)
+#define YLOG_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+#define YLOG_UNLIKELY(x) (x)
+#endif
+
+// 运行时级别检查，通过之前不求值任何日志参数
+#define YLOG_LEVEL_ENABLED(level) YLOG_UNLIKELY(yalgo::log::AsyncLogger::levelEnabled(level))
+
+// 模块编号：模块名须为字符串字面量，编号在编译期求值
+#define YLOG_MODULE_ID(module) std::integral_constant<uint32_t, yalgo::log::moduleId(module)>::value
+
+// 模块级别检查：全局级别读取加一次模块级别表读取，通过之前不求值任何日志参数
+#define YLOG_MODULE_ENABLED(module, level) \
+    YLOG_UNLIKELY(yalgo::log::AsyncLogger::moduleLevelEnabled(YLOG_MODULE_ID(module), level))
+
+// 流式宏实现：级别关闭时整个<<链都不求值
+#define YLOG_STREAM_IMPL(level, level_str) \
+    !YLOG_LEVEL_ENABLED(level) ? (void)0 : \
+    yalgo::log::LogStreamVoidify() & yalgo::log::LogStream(level, level_str, __FILE__, __LINE__, __func__)
+
+// 模块流式宏实现
+#define YLOG_MODULE_STREAM_IMPL(module, level, level_str) \
+    !YLOG_MODULE_ENABLED(module, level) ? (void)0 : \
+    yalgo::log::LogStreamVoidify() & yalgo::log::LogStream(level, level_str, __FILE__, __LINE__, __func__, module)
+
+// 编译期关闭的流式宏：保持<<链可编译，但整个表达式被丢弃
+#define YLOG_STREAM_DISABLED(level, level_str, ...) \
+    true ? (void)0 : \
+    yalgo::log::LogStreamVoidify() & yalgo::log::LogStream(level, level_str, __FILE__, __LINE__, __func__, ##__VA_ARGS__)
+
 // 日志宏定义（使用命名空间）
 #if YALGO_LOG_LEVEL >= 1 // LOG_ERROR级别
 #define YLOG_ERROR(format, ...) do { \
-    std::ostringstream oss; \
-    oss << "[" << __FILE__ << ":" << __LINE__ << ":" << __func__ << "] " \
-        << yalgo::log::formatLog(format, ##__VA_ARGS__); \
-    yalgo::log::AsyncLogger::getInstance().log(yalgo::log::LogLevel::LOG_ERROR, "ERROR", oss.str()); \
+    if (YLOG_LEVEL_ENABLED(yalgo::log::LogLevel::LOG_ERROR)) { \
+        std::ostringstream oss; \
+        oss << "[" << __FILE__ << ":" << __LINE__ << ":" << __func__ << "] " \
+            << yalgo::log::formatLog(format, ##__VA_ARGS__); \
+        yalgo::log::AsyncLogger::getInstance().log(yalgo::log::LogLevel::LOG_ERROR, "ERROR", oss.str()); \
+    } \
 } while(0)
 #else
 #define YLOG_ERROR(format, ...) do {} while(0)
@@ -267,10 +1181,12 @@ private:
 
 #if YALGO_LOG_LEVEL >= 2 // WARN级别
 #define YLOG_WARN(format, ...) do { \
-    std::ostringstream oss; \
-    oss << "[" << __FILE__ << ":" << __LINE__ << ":" << __func__ << "] " \
-        << yalgo::log::formatLog(format, ##__VA_ARGS__); \
-    yalgo::log::AsyncLogger::getInstance().log(yalgo::log::LogLevel::WARN, "WARN", oss.str()); \
+    if (YLOG_LEVEL_ENABLED(yalgo::log::LogLevel::WARN)) { \
+        std::ostringstream oss; \
+        oss << "[" << __FILE__ << ":" << __LINE__ << ":" << __func__ << "] " \
+            << yalgo::log::formatLog(format, ##__VA_ARGS__); \
+        yalgo::log::AsyncLogger::getInstance().log(yalgo::log::LogLevel::WARN, "WARN", oss.str()); \
+    } \
 } while(0)
 #else
 #define YLOG_WARN(format, ...) do {} while(0)
@@ -278,10 +1194,12 @@ private:
 
 #if YALGO_LOG_LEVEL >= 3 // INFO级别
 #define YLOG_INFO(format, ...) do { \
-    std::ostringstream oss; \
-    oss << "[" << __FILE__ << ":" << __LINE__ << ":" << __func__ << "] " \
-        << yalgo::log::formatLog(format, ##__VA_ARGS__); \
-    yalgo::log::AsyncLogger::getInstance().log(yalgo::log::LogLevel::INFO, "INFO", oss.str()); \
+    if (YLOG_LEVEL_ENABLED(yalgo::log::LogLevel::INFO)) { \
+        std::ostringstream oss; \
+        oss << "[" << __FILE__ << ":" << __LINE__ << ":" << __func__ << "] " \
+            << yalgo::log::formatLog(format, ##__VA_ARGS__); \
+        yalgo::log::AsyncLogger::getInstance().log(yalgo::log::LogLevel::INFO, "INFO", oss.str()); \
+    } \
 } while(0)
 #else
 #define YLOG_INFO(format, ...) do {} while(0)
@@ -289,10 +1207,12 @@ private:
 
 #if YALGO_LOG_LEVEL >= 4 // DEBUG级别
 #define YLOG_DEBUG(format, ...) do { \
-    std::ostringstream oss; \
-    oss << "[" << __FILE__ << ":" << __LINE__ << ":" << __func__ << "] " \
-        << yalgo::log::formatLog(format, ##__VA_ARGS__); \
-    yalgo::log::AsyncLogger::getInstance().log(yalgo::log::LogLevel::DEBUG, "DEBUG", oss.str()); \
+    if (YLOG_LEVEL_ENABLED(yalgo::log::LogLevel::DEBUG)) { \
+        std::ostringstream oss; \
+        oss << "[" << __FILE__ << ":" << __LINE__ << ":" << __func__ << "] " \
+            << yalgo::log::formatLog(format, ##__VA_ARGS__); \
+        yalgo::log::AsyncLogger::getInstance().log(yalgo::log::LogLevel::DEBUG, "DEBUG", oss.str()); \
+    } \
 } while(0)
 #else
 #define YLOG_DEBUG(format, ...) do {} while(0)
@@ -301,10 +1221,12 @@ private:
 // 模块日志宏
 #if YALGO_LOG_LEVEL >= 1 // ERROR级别
 #define YLOG_MODULE_ERROR(module, format, ...) do { \
-    std::ostringstream oss; \
-    oss << "[" << module << "] [" << __FILE__ << ":" << __LINE__ << ":" << __func__ << "] " \
-        << yalgo::log::formatLog(format, ##__VA_ARGS__); \
-    yalgo::log::AsyncLogger::getInstance().log(yalgo::log::LogLevel::LOG_ERROR, "ERROR", oss.str()); \
+    if (YLOG_MODULE_ENABLED(module, yalgo::log::LogLevel::LOG_ERROR)) { \
+        std::ostringstream oss; \
+        oss << "[" << module << "] [" << __FILE__ << ":" << __LINE__ << ":" << __func__ << "] " \
+            << yalgo::log::formatLog(format, ##__VA_ARGS__); \
+        yalgo::log::AsyncLogger::getInstance().logModule(YLOG_MODULE_ID(module), yalgo::log::LogLevel::LOG_ERROR, oss.str()); \
+    } \
 } while(0)
 #else
 #define YLOG_MODULE_ERROR(module, format, ...) do {} while(0)
@@ -312,10 +1234,12 @@ private:
 
 #if YALGO_LOG_LEVEL >= 2 // WARN级别
 #define YLOG_MODULE_WARN(module, format, ...) do { \
-    std::ostringstream oss; \
-    oss << "[" << module << "] [" << __FILE__ << ":" << __LINE__ << ":" << __func__ << "] " \
-        << yalgo::log::formatLog(format, ##__VA_ARGS__); \
-    yalgo::log::AsyncLogger::getInstance().log(yalgo::log::LogLevel::WARN, "WARN", oss.str()); \
+    if (YLOG_MODULE_ENABLED(module, yalgo::log::LogLevel::WARN)) { \
+        std::ostringstream oss; \
+        oss << "[" << module << "] [" << __FILE__ << ":" << __LINE__ << ":" << __func__ << "] " \
+            << yalgo::log::formatLog(format, ##__VA_ARGS__); \
+        yalgo::log::AsyncLogger::getInstance().logModule(YLOG_MODULE_ID(module), yalgo::log::LogLevel::WARN, oss.str()); \
+    } \
 } while(0)
 #else
 #define YLOG_MODULE_WARN(module, format, ...) do {} while(0)
@@ -323,10 +1247,12 @@ private:
 
 #if YALGO_LOG_LEVEL >= 4 // DEBUG级别
 #define YLOG_MODULE_DEBUG(module, format, ...) do { \
-    std::ostringstream oss; \
-    oss << "[" << module << "] [" << __FILE__ << ":" << __LINE__ << ":" << __func__ << "] " \
-        << yalgo::log::formatLog(format, ##__VA_ARGS__); \
-    yalgo::log::AsyncLogger::getInstance().log(yalgo::log::LogLevel::DEBUG, "DEBUG", oss.str()); \
+    if (YLOG_MODULE_ENABLED(module, yalgo::log::LogLevel::DEBUG)) { \
+        std::ostringstream oss; \
+        oss << "[" << module << "] [" << __FILE__ << ":" << __LINE__ << ":" << __func__ << "] " \
+            << yalgo::log::formatLog(format, ##__VA_ARGS__); \
+        yalgo::log::AsyncLogger::getInstance().logModule(YLOG_MODULE_ID(module), yalgo::log::LogLevel::DEBUG, oss.str()); \
+    } \
 } while(0)
 #else
 #define YLOG_MODULE_DEBUG(module, format, ...) do {} while(0)
@@ -334,10 +1260,12 @@ private:
 
 #if YALGO_LOG_LEVEL >= 3 // INFO级别
 #define YLOG_MODULE_INFO(module, format, ...) do { \
-    std::ostringstream oss; \
-    oss << "[" << module << "] [" << __FILE__ << ":" << __LINE__ << ":" << __func__ << "] " \
-        << yalgo::log::formatLog(format, ##__VA_ARGS__); \
-    yalgo::log::AsyncLogger::getInstance().log(yalgo::log::LogLevel::INFO, "INFO", oss.str()); \
+    if (YLOG_MODULE_ENABLED(module, yalgo::log::LogLevel::INFO)) { \
+        std::ostringstream oss; \
+        oss << "[" << module << "] [" << __FILE__ << ":" << __LINE__ << ":" << __func__ << "] " \
+            << yalgo::log::formatLog(format, ##__VA_ARGS__); \
+        yalgo::log::AsyncLogger::getInstance().logModule(YLOG_MODULE_ID(module), yalgo::log::LogLevel::INFO, oss.str()); \
+    } \
 } while(0)
 #else
 #define YLOG_MODULE_INFO(module, format, ...) do {} while(0)
@@ -345,51 +1273,104 @@ private:
 
 // 流式日志宏
 #if YALGO_LOG_LEVEL >= 1 // LOG_ERROR级别
-#define YLOG_ERROR_STREAM yalgo::log::LogStream(yalgo::log::LogLevel::LOG_ERROR, "ERROR", __FILE__, __LINE__, __func__)
+#define YLOG_ERROR_STREAM YLOG_STREAM_IMPL(yalgo::log::LogLevel::LOG_ERROR, "ERROR")
 #else
-#define YLOG_ERROR_STREAM do {} while(0)
+#define YLOG_ERROR_STREAM YLOG_STREAM_DISABLED(yalgo::log::LogLevel::LOG_ERROR, "ERROR")
 #endif
 
 #if YALGO_LOG_LEVEL >= 2 // WARN级别
-#define YLOG_WARN_STREAM yalgo::log::LogStream(yalgo::log::LogLevel::WARN, "WARN", __FILE__, __LINE__, __func__)
+#define YLOG_WARN_STREAM YLOG_STREAM_IMPL(yalgo::log::LogLevel::WARN, "WARN")
 #else
-#define YLOG_WARN_STREAM do {} while(0)
+#define YLOG_WARN_STREAM YLOG_STREAM_DISABLED(yalgo::log::LogLevel::WARN, "WARN")
 #endif
 
 #if YALGO_LOG_LEVEL >= 3 // INFO级别
-#define YLOG_INFO_STREAM yalgo::log::LogStream(yalgo::log::LogLevel::INFO, "INFO", __FILE__, __LINE__, __func__)
+#define YLOG_INFO_STREAM YLOG_STREAM_IMPL(yalgo::log::LogLevel::INFO, "INFO")
 #else
-#define YLOG_INFO_STREAM do {} while(0)
+#define YLOG_INFO_STREAM YLOG_STREAM_DISABLED(yalgo::log::LogLevel::INFO, "INFO")
 #endif
 
 #if YALGO_LOG_LEVEL >= 4 // DEBUG级别
-#define YLOG_DEBUG_STREAM yalgo::log::LogStream(yalgo::log::LogLevel::DEBUG, "DEBUG", __FILE__, __LINE__, __func__)
+#define YLOG_DEBUG_STREAM YLOG_STREAM_IMPL(yalgo::log::LogLevel::DEBUG, "DEBUG")
 #else
-#define YLOG_DEBUG_STREAM do {} while(0)
+#define YLOG_DEBUG_STREAM YLOG_STREAM_DISABLED(yalgo::log::LogLevel::DEBUG, "DEBUG")
 #endif
 
 #if YALGO_LOG_LEVEL >= 1 // ERROR级别
-#define YLOG_MODULE_ERROR_STREAM(module) yalgo::log::LogStream(yalgo::log::LogLevel::LOG_ERROR, "ERROR", __FILE__, __LINE__, __func__, module)
+#define YLOG_MODULE_ERROR_STREAM(module) YLOG_MODULE_STREAM_IMPL(module, yalgo::log::LogLevel::LOG_ERROR, "ERROR")
+#else
+#define YLOG_MODULE_ERROR_STREAM(module) YLOG_STREAM_DISABLED(yalgo::log::LogLevel::LOG_ERROR, "ERROR", module)
+#endif
+
+#if YALGO_LOG_LEVEL >= 2 // WARN级别
+#define YLOG_MODULE_WARN_STREAM(module) YLOG_MODULE_STREAM_IMPL(module, yalgo::log::LogLevel::WARN, "WARN")
+#else
+#define YLOG_MODULE_WARN_STREAM(module) YLOG_STREAM_DISABLED(yalgo::log::LogLevel::WARN, "WARN", module)
+#endif
+
+#if YALGO_LOG_LEVEL >= 3 // INFO级别
+#define YLOG_MODULE_INFO_STREAM(module) YLOG_MODULE_STREAM_IMPL(module, yalgo::log::LogLevel::INFO, "INFO")
+#else
+#define YLOG_MODULE_INFO_STREAM(module) YLOG_STREAM_DISABLED(yalgo::log::LogLevel::INFO, "INFO", module)
+#endif
+
+#if YALGO_LOG_LEVEL >= 4 // DEBUG级别
+#define YLOG_MODULE_DEBUG_STREAM(module) YLOG_MODULE_STREAM_IMPL(module, yalgo::log::LogLevel::DEBUG, "DEBUG")
+#else
+#define YLOG_MODULE_DEBUG_STREAM(module) YLOG_STREAM_DISABLED(yalgo::log::LogLevel::DEBUG, "DEBUG", module)
+#endif
+
+// 指定日志器的宏：logger为AsyncLogger对象（如 *audit_logger），按该日志器自己的运行时级别检查
+#define YLOG_LOGGER_IMPL(logger, level, format, ...) do { \
+    yalgo::log::AsyncLogger& yalgo_target_logger = (logger); \
+    if (YLOG_UNLIKELY(yalgo_target_logger.isEnabled(level))) { \
+        std::ostringstream oss; \
+        oss << "[" << __FILE__ << ":" << __LINE__ << ":" << __func__ << "] " \
+            << yalgo::log::formatLog(format, ##__VA_ARGS__); \
+        yalgo_target_logger.log(level, yalgo::log::AsyncLogger::levelToString(level), oss.str()); \
+    } \
+} while(0)
+
+// 指定日志器的流式宏实现：logger表达式只求值一次；if自带else，宏之后的else不会与之错配
+#define YLOG_LOGGER_STREAM_IMPL(logger, level) \
+    if (yalgo::log::AsyncLogger& yalgo_target_logger = (logger); !YLOG_UNLIKELY(yalgo_target_logger.isEnabled(level))) {} else \
+    yalgo::log::LogStreamVoidify() & yalgo::log::LogStream(yalgo_target_logger, level, __FILE__, __LINE__, __func__)
+
+// 编译期关闭的指定日志器流式宏
+#define YLOG_LOGGER_STREAM_DISABLED(logger, level) \
+    true ? (void)0 : \
+    yalgo::log::LogStreamVoidify() & yalgo::log::LogStream(logger, level, __FILE__, __LINE__, __func__)
+
+#if YALGO_LOG_LEVEL >= 1 // LOG_ERROR级别
+#define YLOG_LOGGER_ERROR(logger, format, ...) YLOG_LOGGER_IMPL(logger, yalgo::log::LogLevel::LOG_ERROR, format, ##__VA_ARGS__)
+#define YLOG_LOGGER_ERROR_STREAM(logger) YLOG_LOGGER_STREAM_IMPL(logger, yalgo::log::LogLevel::LOG_ERROR)
 #else
-#define YLOG_MODULE_ERROR_STREAM(module) do {} while(0)
+#define YLOG_LOGGER_ERROR(logger, format, ...) do {} while(0)
+#define YLOG_LOGGER_ERROR_STREAM(logger) YLOG_LOGGER_STREAM_DISABLED(logger, yalgo::log::LogLevel::LOG_ERROR)
 #endif
 
 #if YALGO_LOG_LEVEL >= 2 // WARN级别
-#define YLOG_MODULE_WARN_STREAM(module) yalgo::log::LogStream(yalgo::log::LogLevel::WARN, "WARN", __FILE__, __LINE__, __func__, module)
+#define YLOG_LOGGER_WARN(logger, format, ...) YLOG_LOGGER_IMPL(logger, yalgo::log::LogLevel::WARN, format, ##__VA_ARGS__)
+#define YLOG_LOGGER_WARN_STREAM(logger) YLOG_LOGGER_STREAM_IMPL(logger, yalgo::log::LogLevel::WARN)
 #else
-#define YLOG_MODULE_WARN_STREAM(module) do {} while(0)
+#define YLOG_LOGGER_WARN(logger, format, ...) do {} while(0)
+#define YLOG_LOGGER_WARN_STREAM(logger) YLOG_LOGGER_STREAM_DISABLED(logger, yalgo::log::LogLevel::WARN)
 #endif
 
 #if YALGO_LOG_LEVEL >= 3 // INFO级别
-#define YLOG_MODULE_INFO_STREAM(module) yalgo::log::LogStream(yalgo::log::LogLevel::INFO, "INFO", __FILE__, __LINE__, __func__, module)
+#define YLOG_LOGGER_INFO(logger, format, ...) YLOG_LOGGER_IMPL(logger, yalgo::log::LogLevel::INFO, format, ##__VA_ARGS__)
+#define YLOG_LOGGER_INFO_STREAM(logger) YLOG_LOGGER_STREAM_IMPL(logger, yalgo::log::LogLevel::INFO)
 #else
-#define YLOG_MODULE_INFO_STREAM(module) do {} while(0)
+#define YLOG_LOGGER_INFO(logger, format, ...) do {} while(0)
+#define YLOG_LOGGER_INFO_STREAM(logger) YLOG_LOGGER_STREAM_DISABLED(logger, yalgo::log::LogLevel::INFO)
 #endif
 
 #if YALGO_LOG_LEVEL >= 4 // DEBUG级别
-#define YLOG_MODULE_DEBUG_STREAM(module) yalgo::log::LogStream(yalgo::log::LogLevel::DEBUG, "DEBUG", __FILE__, __LINE__, __func__, module)
+#define YLOG_LOGGER_DEBUG(logger, format, ...) YLOG_LOGGER_IMPL(logger, yalgo::log::LogLevel::DEBUG, format, ##__VA_ARGS__)
+#define YLOG_LOGGER_DEBUG_STREAM(logger) YLOG_LOGGER_STREAM_IMPL(logger, yalgo::log::LogLevel::DEBUG)
 #else
-#define YLOG_MODULE_DEBUG_STREAM(module) do {} while(0)
+#define YLOG_LOGGER_DEBUG(logger, format, ...) do {} while(0)
+#define YLOG_LOGGER_DEBUG_STREAM(logger) YLOG_LOGGER_STREAM_DISABLED(logger, yalgo::log::LogLevel::DEBUG)
 #endif
 
 #endif // YALGO_SDK_LOG_ASYNC_LOGGER_H
\ No newline at end of file
@@ -0,0 +1,594 @@
+/**
+ * @file binary_log.cpp
+ * @brief 二进制延迟格式化日志实现文件
+ * @author yAlgo Team
+ * @date 2026-10-16
+ * @version 1.0.0
+ */
+
+#include "binary_log.h"
+#include "structured_log.h"
+
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+namespace yalgo {
+namespace log {
+
+namespace {
+
+// 调用点注册表：deque保证元素地址不随扩容变化
+std::mutex site_mutex;
+std::deque<BinaryLogSite> sites;
+
+// 顺序读取参数原始字节
+class BinaryArgReader {
+public:
+    BinaryArgReader(const BinaryLogSite& site, const char* data, size_t size)
+        : site_(site), data_(data), size_(size) {}
+
+    bool hasNext() const { return index_ < site_.arg_count; }
+
+    BinaryArgType nextType() const { return site_.arg_types[index_]; }
+
+    // 读取整数类参数，越界或类型不符时返回false
+    bool readInteger(long long& value) {
+        if (!hasNext()) {
+            return false;
+        }
+        switch (nextType()) {
+            case BinaryArgType::INT32: value = read<int32_t>(); break;
+            case BinaryArgType::INT64: value = read<int64_t>(); break;
+            case BinaryArgType::UINT32: value = read<uint32_t>(); break;
+            case BinaryArgType::UINT64: value = static_cast<long long>(read<uint64_t>()); break;
+            case BinaryArgType::CHAR: value = read<char>(); break;
+            case BinaryArgType::BOOL: value = read<uint8_t>(); break;
+            default: return false;
+        }
+        ++index_;
+        return ok_;
+    }
+
+    template <typename T>
+    T read() {
+        T value{};
+        if (pos_ + sizeof(T) > size_) {
+            ok_ = false;
+            pos_ = size_;
+            return value;
+        }
+        std::memcpy(&value, data_ + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return value;
+    }
+
+    std::string_view readString() {
+        uint32_t len = read<uint32_t>();
+        if (!ok_ || pos_ + len > size_) {
+            ok_ = false;
+            pos_ = size_;
+            return std::string_view();
+        }
+        std::string_view str(data_ + pos_, len);
+        pos_ += len;
+        return str;
+    }
+
+    void advance() { ++index_; }
+
+    bool ok() const { return ok_; }
+
+private:
+    const BinaryLogSite& site_;
+    const char* data_;
+    size_t size_;
+    size_t pos_ = 0;
+    size_t index_ = 0;
+    bool ok_ = true;
+};
+
+template <typename T>
+void appendPrintf(std::string& out, const std::string& spec, T value) {
+    char buf[128];
+    int n = snprintf(buf, sizeof(buf), spec.c_str(), value);
+    if (n < 0) {
+        return;
+    }
+    if (static_cast<size_t>(n) < sizeof(buf)) {
+        out.append(buf, n);
+        return;
+    }
+    std::string big(n + 1, '\0');
+    snprintf(&big[0], big.size(), spec.c_str(), value);
+    out.append(big.data(), n);
+}
+
+bool isIntegerConversion(char c) {
+    return c == 'd' || c == 'i' || c == 'o' || c == 'u' || c == 'x' || c == 'X' || c == 'c';
+}
+
+bool isFloatConversion(char c) {
+    return c == 'f' || c == 'F' || c == 'e' || c == 'E' || c == 'g' || c == 'G' ||
+           c == 'a' || c == 'A';
+}
+
+// 按实际参数类型输出一个格式说明符；spec为去掉长度修饰符的"%标志宽度精度"
+void appendArg(std::string& out, std::string spec, char conv, BinaryArgReader& reader) {
+    switch (reader.nextType()) {
+        case BinaryArgType::INT32:
+        case BinaryArgType::INT64:
+        case BinaryArgType::UINT32:
+        case BinaryArgType::UINT64:
+        case BinaryArgType::CHAR:
+        case BinaryArgType::BOOL: {
+            bool is_unsigned = reader.nextType() == BinaryArgType::UINT32 ||
+                               reader.nextType() == BinaryArgType::UINT64;
+            bool is_char = reader.nextType() == BinaryArgType::CHAR;
+            long long value = 0;
+            reader.readInteger(value);
+            if (isFloatConversion(conv)) {
+                appendPrintf(out, spec + conv, static_cast<double>(value));
+            } else if (conv == 'c' || (is_char && !isIntegerConversion(conv))) {
+                appendPrintf(out, spec + 'c', static_cast<int>(value));
+            } else if (conv == 'o' || conv == 'u' || conv == 'x' || conv == 'X') {
+                appendPrintf(out, spec + "ll" + conv, static_cast<unsigned long long>(value));
+            } else if (is_unsigned) {
+                appendPrintf(out, spec + "llu", static_cast<unsigned long long>(value));
+            } else {
+                appendPrintf(out, spec + "lld", value);
+            }
+            break;
+        }
+        case BinaryArgType::DOUBLE: {
+            double value = reader.read<double>();
+            reader.advance();
+            appendPrintf(out, spec + (isFloatConversion(conv) ? conv : 'g'), value);
+            break;
+        }
+        case BinaryArgType::STRING: {
+            std::string_view str = reader.readString();
+            reader.advance();
+            if (conv == 's' && spec.size() > 1) {
+                appendPrintf(out, spec + 's', std::string(str).c_str());
+            } else {
+                out.append(str.data(), str.size());
+            }
+            break;
+        }
+        case BinaryArgType::POINTER: {
+            uint64_t value = reader.read<uint64_t>();
+            reader.advance();
+            appendPrintf(out, spec + 'p', reinterpret_cast<void*>(static_cast<uintptr_t>(value)));
+            break;
+        }
+        default:
+            reader.advance();
+            out += "<bad-arg>";
+            break;
+    }
+}
+
+/**
+ * @brief 把编码结果交给写出函数的输出（崩溃处理用，不分配内存）
+ */
+struct CallbackOutput {
+    BinaryEntryWriter write;
+    void* context;
+
+    void append(const char* data, size_t size) { write(context, data, size); }
+};
+
+template <typename Out, typename T>
+void appendValue(Out& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename Out>
+void appendString(Out& out, const char* str) {
+    size_t len = str ? strlen(str) : 0;
+    appendValue(out, static_cast<uint32_t>(len));
+    out.append(str ? str : "", len);
+}
+
+// 编码格式串定义条目
+template <typename Out>
+void encodeSiteEntry(const BinaryLogSite& site, Out& out) {
+    appendValue(out, static_cast<uint8_t>(site.keys ? BinaryEntryType::KV_SITE : BinaryEntryType::SITE));
+    appendValue(out, site.id);
+    appendValue(out, static_cast<uint8_t>(site.level));
+    appendValue(out, static_cast<int32_t>(site.line));
+    appendValue(out, static_cast<uint16_t>(site.arg_count));
+    for (size_t i = 0; i < site.arg_count; ++i) {
+        appendValue(out, static_cast<uint8_t>(site.arg_types[i]));
+    }
+    appendString(out, site.module);
+    appendString(out, site.file);
+    appendString(out, site.func);
+    appendString(out, site.format);
+    if (site.keys) {
+        for (size_t i = 0; i < site.arg_count; ++i) {
+            appendString(out, site.keys[i]);
+        }
+    }
+}
+
+// 编码日志条目：有调用点时为参数字节，否则为正文
+template <typename Out>
+void encodeLogEntry(uint64_t timestamp_us, LogLevel level, const BinaryLogSite* site,
+                    const char* data, size_t size, Out& out) {
+    appendValue(out, static_cast<uint8_t>(site ? BinaryEntryType::BINARY : BinaryEntryType::TEXT));
+    appendValue(out, timestamp_us);
+    appendValue(out, static_cast<uint8_t>(level));
+    if (site) {
+        appendValue(out, site->id);
+    }
+    appendValue(out, static_cast<uint32_t>(size));
+    out.append(data, size);
+}
+
+// 带越界检查的顺序读取
+class EntryReader {
+public:
+    EntryReader(const char* data, size_t size, size_t offset)
+        : data_(data), size_(size), pos_(offset) {}
+
+    template <typename T>
+    bool read(T& value) {
+        if (size_ - pos_ < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, data_ + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return true;
+    }
+
+    bool readBytes(size_t len, const char*& ptr) {
+        if (size_ - pos_ < len) {
+            return false;
+        }
+        ptr = data_ + pos_;
+        pos_ += len;
+        return true;
+    }
+
+    bool readString(std::string& str) {
+        uint32_t len = 0;
+        const char* ptr = nullptr;
+        if (!read(len) || !readBytes(len, ptr)) {
+            return false;
+        }
+        str.assign(ptr, len);
+        return true;
+    }
+
+    size_t position() const { return pos_; }
+
+private:
+    const char* data_;
+    size_t size_;
+    size_t pos_;
+};
+
+bool validLevel(uint8_t level) {
+    return level <= static_cast<uint8_t>(LogLevel::DEBUG);
+}
+
+} // namespace
+
+// 注册调用点
+const BinaryLogSite* registerBinaryLogSite(const BinaryLogSite& site) {
+    std::lock_guard<std::mutex> lock(site_mutex);
+    sites.push_back(site);
+    sites.back().id = static_cast<uint32_t>(sites.size());
+    return &sites.back();
+}
+
+// 按编号查找调用点
+const BinaryLogSite* findBinaryLogSite(uint32_t id) {
+    std::lock_guard<std::mutex> lock(site_mutex);
+    if (id == 0 || id > sites.size()) {
+        return nullptr;
+    }
+    return &sites[id - 1];
+}
+
+// 格式化二进制日志正文
+void formatBinaryRecord(const BinaryLogSite& site, const char* args, size_t size,
+                        std::string& out) {
+    if (site.module && site.module[0] != '\0') {
+        out += '[';
+        out += site.module;
+        out += "] ";
+    }
+    out += '[';
+    out += site.file;
+    out += ':';
+    out += std::to_string(site.line);
+    out += ':';
+    out += site.func;
+    out += "] ";
+
+    // 结构化日志：消息原样输出，字段按logfmt追加
+    if (site.keys) {
+        out += site.format;
+        appendStructuredFields(site, args, size, out);
+        return;
+    }
+
+    BinaryArgReader reader(site, args, size);
+    const char* p = site.format;
+    while (*p) {
+        if (*p != '%') {
+            const char* literal = p;
+            while (*p && *p != '%') {
+                ++p;
+            }
+            out.append(literal, p - literal);
+            continue;
+        }
+        if (p[1] == '%') {
+            out += '%';
+            p += 2;
+            continue;
+        }
+
+        // 解析 %[flags][width][.precision][length]conversion
+        const char* spec_begin = p++;
+        std::string spec = "%";
+        while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0') {
+            spec += *p++;
+        }
+        bool missing = false;
+        auto takeNumber = [&]() {
+            if (*p == '*') {
+                long long value = 0;
+                missing |= !reader.readInteger(value);
+                spec += std::to_string(value);
+                ++p;
+            } else {
+                while (*p >= '0' && *p <= '9') {
+                    spec += *p++;
+                }
+            }
+        };
+        takeNumber();
+        if (*p == '.') {
+            spec += *p++;
+            takeNumber();
+        }
+        while (*p == 'h' || *p == 'l' || *p == 'j' || *p == 'z' || *p == 't' || *p == 'L' ||
+               *p == 'q') {
+            ++p; // 长度修饰符以实际参数类型为准
+        }
+        char conv = *p;
+        if (conv == '\0') {
+            out.append(spec_begin, p - spec_begin);
+            break;
+        }
+        ++p;
+
+        if (missing || !reader.hasNext()) {
+            out += "<missing>";
+            continue;
+        }
+        appendArg(out, spec, conv, reader);
+    }
+
+    if (!reader.ok()) {
+        out += " <truncated>";
+    }
+}
+
+// 写入文件头
+void encodeBinaryFileHeader(std::string& out) {
+    out.append(BINARY_LOG_MAGIC, sizeof(BINARY_LOG_MAGIC));
+}
+
+// 写入格式串定义
+void encodeBinarySiteEntry(const BinaryLogSite& site, std::string& out) {
+    encodeSiteEntry(site, out);
+}
+
+// 写入日志条目
+void encodeBinaryLogEntry(const LogRecord& record, std::string& out) {
+    if (record.site) {
+        encodeLogEntry(record.timestamp_us, record.level, record.site, record.args.data(), record.args.size(), out);
+    } else {
+        encodeLogEntry(record.timestamp_us, record.level, nullptr, record.text.data(), record.text.size(), out);
+    }
+}
+
+// 逐段写出格式串定义
+void writeBinarySiteEntry(const BinaryLogSite& site, BinaryEntryWriter write, void* context) {
+    CallbackOutput out{write, context};
+    encodeSiteEntry(site, out);
+}
+
+// 逐段写出日志条目
+void writeBinaryLogEntry(uint64_t timestamp_us, LogLevel level, const BinaryLogSite* site,
+                         const char* data, size_t size, BinaryEntryWriter write, void* context) {
+    CallbackOutput out{write, context};
+    encodeLogEntry(timestamp_us, level, site, data, size, out);
+}
+
+// 解码器持有的格式串定义（字符串由解码器自己保存）
+struct BinaryLogDecoder::OwnedSite {
+    BinaryLogSite site;
+    std::vector<BinaryArgType> arg_types;
+    std::string module;
+    std::string file;
+    std::string func;
+    std::string format;
+    std::vector<std::string> keys;
+    std::vector<const char*> key_ptrs;
+};
+
+BinaryLogDecoder::BinaryLogDecoder() {}
+
+BinaryLogDecoder::~BinaryLogDecoder() {
+    for (OwnedSite* site : sites_) {
+        delete site;
+    }
+}
+
+// 检查文件头
+bool BinaryLogDecoder::checkHeader(const char* data, size_t size, size_t& offset) {
+    if (size < sizeof(BINARY_LOG_MAGIC) ||
+        std::memcmp(data, BINARY_LOG_MAGIC, sizeof(BINARY_LOG_MAGIC)) != 0) {
+        return false;
+    }
+    offset = sizeof(BINARY_LOG_MAGIC);
+    return true;
+}
+
+// 判断零填充尾部
+bool BinaryLogDecoder::isPadding(const char* data, size_t size, size_t offset) {
+    for (size_t i = offset; i < size; ++i) {
+        if (data[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 计算完整条目长度
+size_t BinaryLogDecoder::validLength(const char* data, size_t size) {
+    size_t offset = 0;
+    if (!checkHeader(data, size, offset)) {
+        return 0;
+    }
+    BinaryLogDecoder decoder;
+    BinaryLogEntry entry;
+    while (decoder.next(data, size, offset, entry)) {
+    }
+    return offset;
+}
+
+// 解码下一条日志
+bool BinaryLogDecoder::next(const char* data, size_t size, size_t& offset, BinaryLogEntry& entry) {
+    while (offset < size) {
+        EntryReader reader(data, size, offset);
+        uint8_t type = 0;
+        uint8_t level = 0;
+        reader.read(type);
+
+        if (type == static_cast<uint8_t>(BinaryEntryType::SITE) ||
+            type == static_cast<uint8_t>(BinaryEntryType::KV_SITE)) {
+            std::unique_ptr<OwnedSite> owned(new OwnedSite());
+            uint32_t id = 0;
+            int32_t line = 0;
+            uint16_t arg_count = 0;
+            if (!reader.read(id) || !reader.read(level) || !reader.read(line) ||
+                !reader.read(arg_count) || id == 0 || !validLevel(level)) {
+                return false;
+            }
+            owned->arg_types.resize(arg_count);
+            for (uint16_t i = 0; i < arg_count; ++i) {
+                uint8_t arg_type = 0;
+                if (!reader.read(arg_type)) {
+                    return false;
+                }
+                owned->arg_types[i] = static_cast<BinaryArgType>(arg_type);
+            }
+            if (!reader.readString(owned->module) || !reader.readString(owned->file) ||
+                !reader.readString(owned->func) || !reader.readString(owned->format)) {
+                return false;
+            }
+            if (type == static_cast<uint8_t>(BinaryEntryType::KV_SITE)) {
+                owned->keys.resize(arg_count);
+                for (uint16_t i = 0; i < arg_count; ++i) {
+                    if (!reader.readString(owned->keys[i])) {
+                        return false;
+                    }
+                    owned->key_ptrs.push_back(owned->keys[i].c_str());
+                }
+                owned->key_ptrs.push_back(nullptr);
+                owned->site.keys = owned->key_ptrs.data();
+            }
+            owned->site.id = id;
+            owned->site.level = static_cast<LogLevel>(level);
+            owned->site.line = line;
+            owned->site.arg_count = arg_count;
+            owned->site.arg_types = owned->arg_types.data();
+            owned->site.module = owned->module.c_str();
+            owned->site.file = owned->file.c_str();
+            owned->site.func = owned->func.c_str();
+            owned->site.format = owned->format.c_str();
+
+            if (id > sites_.size()) {
+                sites_.resize(id, nullptr);
+            }
+            delete sites_[id - 1];
+            sites_[id - 1] = owned.release();
+            offset = reader.position();
+            continue;
+        }
+
+        uint64_t timestamp = 0;
+        uint32_t site_id = 0;
+        uint32_t length = 0;
+        const char* payload = nullptr;
+        if (type == static_cast<uint8_t>(BinaryEntryType::BINARY)) {
+            if (!reader.read(timestamp) || !reader.read(level) || !reader.read(site_id) ||
+                !reader.read(length) || !reader.readBytes(length, payload) ||
+                !validLevel(level) || site_id == 0 || site_id > sites_.size() ||
+                sites_[site_id - 1] == nullptr) {
+                return false;
+            }
+            entry.site = &sites_[site_id - 1]->site;
+        } else if (type == static_cast<uint8_t>(BinaryEntryType::TEXT)) {
+            if (!reader.read(timestamp) || !reader.read(level) || !reader.read(length) ||
+                !reader.readBytes(length, payload) || !validLevel(level)) {
+                return false;
+            }
+            entry.site = nullptr;
+        } else {
+            return false;
+        }
+
+        entry.level = static_cast<LogLevel>(level);
+        entry.timestamp_us = timestamp;
+        entry.data = payload;
+        entry.size = length;
+        offset = reader.position();
+        return true;
+    }
+    return false;
+}
+
+// 按文本布局格式化日志条目
+void BinaryLogDecoder::formatEntry(const BinaryLogEntry& entry, std::string& out) {
+    out += '[';
+    out += AsyncLogger::getFormattedTime(entry.timestamp_us);
+    out += "] [";
+    out += AsyncLogger::levelToString(entry.level);
+    out += "] ";
+    if (entry.site) {
+        formatBinaryRecord(*entry.site, entry.data, entry.size, out);
+    } else {
+        out.append(entry.data, entry.size);
+    }
+}
+
+// 获取日志条目的模块名
+std::string_view BinaryLogDecoder::entryModule(const BinaryLogEntry& entry) {
+    if (entry.site) {
+        return entry.site->module;
+    }
+    // 文本日志：模块日志以"[module] [file:line:func] "开头
+    std::string_view text(entry.data, entry.size);
+    if (text.size() < 2 || text[0] != '[') {
+        return std::string_view();
+    }
+    size_t close = text.find(']');
+    if (close == std::string_view::npos || close + 2 >= text.size() ||
+        text[close + 1] != ' ' || text[close + 2] != '[') {
+        return std::string_view();
+    }
+    return text.substr(1, close - 1);
+}
+
+} // namespace log
+} // namespace yalgo
@@ -0,0 +1,399 @@
+/**
+ * @file binary_log.h
+ * @brief 二进制延迟格式化日志
+ * @author yAlgo Team
+ * @date 2026-10-16
+ * @version 1.0.0
+ *
+ * 调用线程只记录静态格式串编号和参数原始字节，
+ * 格式化由后台线程（或离线解码工具）完成。
+ * 参数类型在编译期通过变参模板确定，不经过C可变参数。
+ */
+
+#ifndef YALGO_SDK_LOG_BINARY_LOG_H
+#define YALGO_SDK_LOG_BINARY_LOG_H
+
+#include "log_exports.h"
+#include "async_logger.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace yalgo {
+namespace log {
+
+/**
+ * @brief 二进制日志参数类型
+ */
+enum class BinaryArgType : uint8_t {
+    INT32 = 1,   ///< 32位及以下有符号整数
+    INT64 = 2,   ///< 64位有符号整数
+    UINT32 = 3,  ///< 32位及以下无符号整数
+    UINT64 = 4,  ///< 64位无符号整数
+    DOUBLE = 5,  ///< 浮点数
+    CHAR = 6,    ///< 单个字符
+    STRING = 7,  ///< 字符串（长度前缀 + 内容）
+    POINTER = 8, ///< 指针地址
+    BOOL = 9     ///< 布尔值（1字节）
+};
+
+/**
+ * @brief 二进制日志调用点描述（每个调用点一份，注册后地址不变）
+ */
+struct BinaryLogSite {
+    uint32_t id = 0;                          ///< 格式串编号
+    LogLevel level = LogLevel::OFF;           ///< 日志级别
+    const char* module = "";                  ///< 模块名（字符串字面量）
+    const char* file = "";                    ///< 源文件
+    int line = 0;                             ///< 行号
+    const char* func = "";                    ///< 函数名
+    const char* format = "";                  ///< printf风格格式串（字符串字面量）
+    const BinaryArgType* arg_types = nullptr; ///< 参数类型表
+    size_t arg_count = 0;                     ///< 参数个数
+    const char* const* keys = nullptr;        ///< 结构化日志字段名（非空时为YLOG_*_KV调用点，format为消息，参数为字段值）
+};
+
+/**
+ * @brief 注册调用点并分配格式串编号
+ * @param site 调用点描述（拷贝到内部存储）
+ * @return const BinaryLogSite* 注册后的调用点，生命周期与进程相同
+ */
+LOG_API const BinaryLogSite* registerBinaryLogSite(const BinaryLogSite& site);
+
+/**
+ * @brief 按编号查找已注册的调用点
+ * @param id 格式串编号
+ * @return const BinaryLogSite* 未注册时返回nullptr
+ */
+LOG_API const BinaryLogSite* findBinaryLogSite(uint32_t id);
+
+/**
+ * @brief 按调用点格式串和参数原始字节生成日志正文
+ * @param site 调用点描述
+ * @param args 参数原始字节
+ * @param size 参数字节数
+ * @param out 追加输出（含"[module] [file:line:func] "前缀；结构化日志为消息加logfmt字段）
+ */
+LOG_API void formatBinaryRecord(const BinaryLogSite& site, const char* args, size_t size,
+                                std::string& out);
+
+/**
+ * @brief 二进制日志文件条目类型
+ *
+ * @details 文件以BINARY_LOG_MAGIC开头，之后为连续的条目，每个条目以1字节类型开头。
+ * 多字节整数按本机字节序（小端）存储。
+ * - SITE：u32编号, u8级别, i32行号, u16参数个数, 参数类型[n], 字符串module/file/func/format
+ * - KV_SITE：与SITE相同，其后为n个字段名字符串（结构化日志调用点）
+ * - BINARY：u64时间戳, u8级别, u32格式串编号, u32参数字节数, 参数字节
+ * - TEXT：u64时间戳, u8级别, u32正文字节数, 正文
+ * 字符串均为u32长度前缀 + 内容。格式串定义在每个文件中首次使用前写入一次。
+ */
+enum class BinaryEntryType : uint8_t {
+    SITE = 1,   ///< 格式串定义
+    BINARY = 2, ///< 二进制参数日志
+    TEXT = 3,   ///< 已格式化的文本日志
+    KV_SITE = 4 ///< 结构化日志调用点定义
+};
+
+/**
+ * @brief 二进制日志文件头
+ */
+constexpr char BINARY_LOG_MAGIC[8] = {'Y', 'L', 'O', 'G', 'B', 'I', 'N', '1'};
+
+/**
+ * @brief 追加二进制日志文件头
+ * @param out 输出缓冲
+ */
+LOG_API void encodeBinaryFileHeader(std::string& out);
+
+/**
+ * @brief 追加一个格式串定义条目
+ * @param site 调用点描述
+ * @param out 输出缓冲
+ */
+LOG_API void encodeBinarySiteEntry(const BinaryLogSite& site, std::string& out);
+
+/**
+ * @brief 追加一个日志条目（二进制日志写BINARY条目，文本日志写TEXT条目）
+ * @param record 日志记录
+ * @param out 输出缓冲
+ */
+LOG_API void encodeBinaryLogEntry(const LogRecord& record, std::string& out);
+
+/**
+ * @brief 条目写出函数（接收编码结果的一段字节）
+ */
+typedef void (*BinaryEntryWriter)(void* context, const char* data, size_t size);
+
+/**
+ * @brief 逐段写出一个格式串定义条目（不分配内存，可在信号处理函数中调用）
+ * @param site 调用点描述
+ * @param write 写出函数
+ * @param context 写出函数的上下文
+ */
+LOG_API void writeBinarySiteEntry(const BinaryLogSite& site, BinaryEntryWriter write, void* context);
+
+/**
+ * @brief 逐段写出一个日志条目（不分配内存，可在信号处理函数中调用）
+ * @param timestamp_us 时间戳（Unix纪元微秒）
+ * @param level 日志级别
+ * @param site 调用点（非空时写BINARY条目，data为参数字节；为空时写TEXT条目，data为正文）
+ * @param data 参数字节或正文
+ * @param size 字节数
+ * @param write 写出函数
+ * @param context 写出函数的上下文
+ */
+LOG_API void writeBinaryLogEntry(uint64_t timestamp_us, LogLevel level, const BinaryLogSite* site,
+                                 const char* data, size_t size, BinaryEntryWriter write, void* context);
+
+/**
+ * @brief 解码得到的一条日志（指针指向被解码的缓冲区，不拥有内存）
+ */
+struct BinaryLogEntry {
+    LogLevel level = LogLevel::OFF;      ///< 日志级别
+    uint64_t timestamp_us = 0;           ///< 时间戳（Unix纪元微秒）
+    const BinaryLogSite* site = nullptr; ///< 格式串定义（TEXT条目为nullptr）
+    const char* data = nullptr;          ///< 参数字节或文本正文
+    size_t size = 0;                     ///< data字节数
+};
+
+/**
+ * @brief 二进制日志文件解码器
+ *
+ * @details 顺序扫描文件内容，格式串定义条目由解码器内部保存，只向调用方返回日志条目
+ */
+class LOG_API BinaryLogDecoder {
+public:
+    BinaryLogDecoder();
+    ~BinaryLogDecoder();
+
+    BinaryLogDecoder(const BinaryLogDecoder&) = delete;
+    BinaryLogDecoder& operator=(const BinaryLogDecoder&) = delete;
+
+    /**
+     * @brief 检查文件头
+     * @param data 文件内容
+     * @param size 文件字节数
+     * @param offset 成功时设置为首个条目的偏移
+     * @return 文件头是否有效
+     */
+    static bool checkHeader(const char* data, size_t size, size_t& offset);
+
+    /**
+     * @brief 解码下一条日志
+     * @param data 文件内容
+     * @param size 文件字节数
+     * @param offset 当前偏移，成功时前移到下一个条目
+     * @param entry 接收日志条目
+     * @return 到达文件末尾、条目被截断或内容损坏时返回false
+     */
+    bool next(const char* data, size_t size, size_t& offset, BinaryLogEntry& entry);
+
+    /**
+     * @brief 判断offset之后是否全部为零填充（内存映射输出预分配、进程崩溃后遗留的尾部）
+     * @param data 文件内容
+     * @param size 文件字节数
+     * @param offset 偏移
+     * @return 剩余字节全为零时返回true
+     */
+    static bool isPadding(const char* data, size_t size, size_t offset);
+
+    /**
+     * @brief 计算文件中完整条目的总长度（文件头 + 所有可解码条目）
+     * @param data 文件内容
+     * @param size 文件字节数
+     * @return 第一个截断、损坏或零填充位置的偏移；文件头无效时返回0
+     */
+    static size_t validLength(const char* data, size_t size);
+
+    /**
+     * @brief 按原文本布局格式化日志条目："[time] [LEVEL] [module] [file:line:func] msg"
+     * @param entry 日志条目
+     * @param out 追加输出（不含换行）
+     */
+    static void formatEntry(const BinaryLogEntry& entry, std::string& out);
+
+    /**
+     * @brief 获取日志条目的模块名
+     * @param entry 日志条目
+     * @return 模块名，文本日志按"[module] [file:line:func]"前缀解析，无模块时为空
+     */
+    static std::string_view entryModule(const BinaryLogEntry& entry);
+
+private:
+    struct OwnedSite;
+    std::vector<OwnedSite*> sites_; ///< 按编号索引的格式串定义
+};
+
+namespace detail {
+
+template <typename T>
+struct AlwaysFalse : std::false_type {};
+
+template <typename T>
+constexpr BinaryArgType binaryArgType() {
+    using U = typename std::decay<T>::type;
+    if constexpr (std::is_same<U, bool>::value) {
+        return BinaryArgType::BOOL;
+    } else if constexpr (std::is_same<U, char>::value) {
+        return BinaryArgType::CHAR;
+    } else if constexpr (std::is_integral<U>::value && std::is_signed<U>::value) {
+        return sizeof(U) <= 4 ? BinaryArgType::INT32 : BinaryArgType::INT64;
+    } else if constexpr (std::is_integral<U>::value) {
+        return sizeof(U) <= 4 ? BinaryArgType::UINT32 : BinaryArgType::UINT64;
+    } else if constexpr (std::is_floating_point<U>::value) {
+        return BinaryArgType::DOUBLE;
+    } else if constexpr (std::is_same<U, const char*>::value || std::is_same<U, char*>::value ||
+                         std::is_same<U, std::string>::value ||
+                         std::is_same<U, std::string_view>::value) {
+        return BinaryArgType::STRING;
+    } else if constexpr (std::is_pointer<U>::value) {
+        return BinaryArgType::POINTER;
+    } else {
+        static_assert(AlwaysFalse<T>::value,
+                      "二进制日志参数仅支持整数、浮点数、字符、字符串和指针");
+        return BinaryArgType::INT32;
+    }
+}
+
+inline std::string_view binaryArgString(const char* value) {
+    return value ? std::string_view(value) : std::string_view("(null)");
+}
+inline std::string_view binaryArgString(const std::string& value) { return value; }
+inline std::string_view binaryArgString(std::string_view value) { return value; }
+
+template <typename T>
+inline size_t binaryArgSize(const T& value) {
+    constexpr BinaryArgType type = binaryArgType<T>();
+    if constexpr (type == BinaryArgType::STRING) {
+        return sizeof(uint32_t) + binaryArgString(value).size();
+    } else if constexpr (type == BinaryArgType::INT32 || type == BinaryArgType::UINT32) {
+        return 4;
+    } else if constexpr (type == BinaryArgType::CHAR || type == BinaryArgType::BOOL) {
+        return 1;
+    } else {
+        return 8;
+    }
+}
+
+template <typename T>
+inline void writeBinaryValue(char*& out, T value) {
+    std::memcpy(out, &value, sizeof(T));
+    out += sizeof(T);
+}
+
+template <typename T>
+inline void encodeBinaryArg(char*& out, const T& value) {
+    constexpr BinaryArgType type = binaryArgType<T>();
+    if constexpr (type == BinaryArgType::STRING) {
+        std::string_view str = binaryArgString(value);
+        writeBinaryValue(out, static_cast<uint32_t>(str.size()));
+        std::memcpy(out, str.data(), str.size());
+        out += str.size();
+    } else if constexpr (type == BinaryArgType::INT32) {
+        writeBinaryValue(out, static_cast<int32_t>(value));
+    } else if constexpr (type == BinaryArgType::INT64) {
+        writeBinaryValue(out, static_cast<int64_t>(value));
+    } else if constexpr (type == BinaryArgType::UINT32) {
+        writeBinaryValue(out, static_cast<uint32_t>(value));
+    } else if constexpr (type == BinaryArgType::UINT64) {
+        writeBinaryValue(out, static_cast<uint64_t>(value));
+    } else if constexpr (type == BinaryArgType::DOUBLE) {
+        writeBinaryValue(out, static_cast<double>(value));
+    } else if constexpr (type == BinaryArgType::CHAR) {
+        writeBinaryValue(out, value);
+    } else if constexpr (type == BinaryArgType::BOOL) {
+        writeBinaryValue(out, static_cast<uint8_t>(value ? 1 : 0));
+    } else {
+        writeBinaryValue(out, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value)));
+    }
+}
+
+/**
+ * @brief 提交一条二进制日志
+ *
+ * @details SiteTag为调用点处的lambda类型，保证每个调用点拥有独立的静态描述，
+ * 首次调用时注册格式串，之后只剩级别检查、参数拷贝和入队。
+ */
+template <typename SiteTag, typename... Args>
+inline void logBinary(SiteTag, LogLevel level, uint32_t module_id, const char* module, const char* file,
+                      int line, const char* func, const char* format, const Args&... args) {
+    if (!AsyncLogger::moduleLevelEnabled(module_id, level)) {
+        return;
+    }
+    AsyncLogger& logger = AsyncLogger::getInstance();
+
+    static const BinaryArgType arg_types[sizeof...(Args) + 1] = {binaryArgType<Args>()...};
+    static const BinaryLogSite* site = [&]() {
+        BinaryLogSite desc;
+        desc.level = level;
+        desc.module = module;
+        desc.file = file;
+        desc.line = line;
+        desc.func = func;
+        desc.format = format;
+        desc.arg_types = arg_types;
+        desc.arg_count = sizeof...(Args);
+        return registerBinaryLogSite(desc);
+    }();
+
+    LogRecord record;
+    record.level = level;
+    record.site = site;
+    record.args.resize((size_t(0) + ... + binaryArgSize(args)));
+    char* out = &record.args[0];
+    (void)out;
+    (encodeBinaryArg(out, args), ...);
+    logger.submit(std::move(record));
+}
+
+} // namespace detail
+
+} // namespace log
+} // namespace yalgo
+
+// 二进制日志宏：格式串与模块名须为字符串字面量，级别关闭时不求值参数
+#define YLOG_BIN_IMPL(level, module, format, ...) do { \
+    if (YLOG_MODULE_ENABLED(module, level)) { \
+        yalgo::log::detail::logBinary([] {}, level, YLOG_MODULE_ID(module), module, __FILE__, __LINE__, \
+                                      __func__, format, ##__VA_ARGS__); \
+    } \
+} while(0)
+
+#if YALGO_LOG_LEVEL >= 1 // LOG_ERROR级别
+#define YLOG_BIN_ERROR(format, ...) YLOG_BIN_IMPL(yalgo::log::LogLevel::LOG_ERROR, "", format, ##__VA_ARGS__)
+#define YLOG_BIN_MODULE_ERROR(module, format, ...) YLOG_BIN_IMPL(yalgo::log::LogLevel::LOG_ERROR, module, format, ##__VA_ARGS__)
+#else
+#define YLOG_BIN_ERROR(format, ...) do {} while(0)
+#define YLOG_BIN_MODULE_ERROR(module, format, ...) do {} while(0)
+#endif
+
+#if YALGO_LOG_LEVEL >= 2 // WARN级别
+#define YLOG_BIN_WARN(format, ...) YLOG_BIN_IMPL(yalgo::log::LogLevel::WARN, "", format, ##__VA_ARGS__)
+#define YLOG_BIN_MODULE_WARN(module, format, ...) YLOG_BIN_IMPL(yalgo::log::LogLevel::WARN, module, format, ##__VA_ARGS__)
+#else
+#define YLOG_BIN_WARN(format, ...) do {} while(0)
+#define YLOG_BIN_MODULE_WARN(module, format, ...) do {} while(0)
+#endif
+
+#if YALGO_LOG_LEVEL >= 3 // INFO级别
+#define YLOG_BIN_INFO(format, ...) YLOG_BIN_IMPL(yalgo::log::LogLevel::INFO, "", format, ##__VA_ARGS__)
+#define YLOG_BIN_MODULE_INFO(module, format, ...) YLOG_BIN_IMPL(yalgo::log::LogLevel::INFO, module, format, ##__VA_ARGS__)
+#else
+#define YLOG_BIN_INFO(format, ...) do {} while(0)
+#define YLOG_BIN_MODULE_INFO(module, format, ...) do {} while(0)
+#endif
+
+#if YALGO_LOG_LEVEL >= 4 // DEBUG级别
+#define YLOG_BIN_DEBUG(format, ...) YLOG_BIN_IMPL(yalgo::log::LogLevel::DEBUG, "", format, ##__VA_ARGS__)
+#define YLOG_BIN_MODULE_DEBUG(module, format, ...) YLOG_BIN_IMPL(yalgo::log::LogLevel::DEBUG, module, format, ##__VA_ARGS__)
+#else
+#define YLOG_BIN_DEBUG(format, ...) do {} while(0)
+#define YLOG_BIN_MODULE_DEBUG(module, format, ...) do {} while(0)
+#endif
+
+#endif // YALGO_SDK_LOG_BINARY_LOG_H
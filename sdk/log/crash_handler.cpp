@@ -0,0 +1,383 @@
+/**
+ * @file crash_handler.cpp
+ * @brief 致命信号与std::terminate时写出待处理日志的崩溃处理实现
+ * @author yAlgo Team
+ * @date 2026-10-16
+ * @version 1.0.0
+ */
+
+#include "crash_handler.h"
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <ctime>
+#include <exception>
+#include <mutex>
+
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#if defined(__GLIBC__) || defined(__APPLE__)
+#include <execinfo.h>
+#define YALGO_LOG_HAS_BACKTRACE 1
+#endif
+
+namespace yalgo {
+namespace log {
+
+namespace {
+
+const int kMaxFrames = 64;         // 调用栈最大层数
+const size_t kMaxCallbacks = 16;   // 写出回调登记表容量
+
+/**
+ * @brief 写出回调登记项，信号处理函数只做原子读取
+ */
+struct CallbackSlot {
+    std::atomic<void*> context{nullptr};
+    std::atomic<CrashFlushCallback> callback{nullptr};
+};
+
+CallbackSlot callback_slots[kMaxCallbacks];
+std::atomic<int> crash_state{0};        // 0 未崩溃，1 正在写出，2 已写出
+std::atomic<int64_t> utc_offset_s{0};   // 本地时区偏移（秒）
+std::mutex install_mutex;
+bool installed = false;
+std::terminate_handler previous_terminate = nullptr;
+
+#ifdef _WIN32
+const int kFatalSignals[] = {SIGSEGV, SIGFPE, SIGILL, SIGABRT};
+void (*previous_handlers[4])(int) = {};
+#else
+const int kFatalSignals[] = {SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT};
+struct sigaction previous_actions[5];
+char alt_stack[64 * 1024]; // 安装线程的备用信号栈
+#endif
+const size_t kSignalCount = sizeof(kFatalSignals) / sizeof(kFatalSignals[0]);
+
+// 公历日期到Unix纪元天数
+int64_t daysFromCivil(int64_t year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    unsigned yoe = static_cast<unsigned>(year - era * 400);
+    unsigned doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+// Unix纪元天数到公历日期
+void civilFromDays(int64_t days, int64_t& year, unsigned& month, unsigned& day) {
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    unsigned doe = static_cast<unsigned>(days - era * 146097);
+    unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    unsigned mp = (5 * doy + 2) / 153;
+    day = doy - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = static_cast<int64_t>(yoe) + era * 400 + (month <= 2);
+}
+
+// 记录本地时区偏移（正常上下文中调用）
+void recordUtcOffset() {
+    time_t now = time(nullptr);
+    struct tm local_tm;
+#ifdef _WIN32
+    if (localtime_s(&local_tm, &now) != 0) {
+        return;
+    }
+#else
+    if (localtime_r(&now, &local_tm) == nullptr) {
+        return;
+    }
+#endif
+    int64_t local = daysFromCivil(local_tm.tm_year + 1900, static_cast<unsigned>(local_tm.tm_mon + 1),
+                                  static_cast<unsigned>(local_tm.tm_mday)) * 86400 +
+                    local_tm.tm_hour * 3600 + local_tm.tm_min * 60 + local_tm.tm_sec;
+    utc_offset_s.store(local - static_cast<int64_t>(now), std::memory_order_relaxed);
+}
+
+// 写入定宽十进制数
+char* writeDigits(char* out, uint64_t value, int width) {
+    for (int i = width - 1; i >= 0; --i) {
+        out[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    return out + width;
+}
+
+// 追加字符串，超出容量的部分截断
+void appendText(char* buf, size_t& length, size_t capacity, const char* text) {
+    while (*text != '\0' && length < capacity) {
+        buf[length++] = *text++;
+    }
+}
+
+// 信号名
+const char* signalName(int signal) {
+    switch (signal) {
+        case SIGSEGV: return "SIGSEGV";
+        case SIGFPE:  return "SIGFPE";
+        case SIGILL:  return "SIGILL";
+        case SIGABRT: return "SIGABRT";
+#ifndef _WIN32
+        case SIGBUS:  return "SIGBUS";
+#endif
+        default:      return "signal";
+    }
+}
+
+// 采集当前线程的调用栈
+int captureFrames(void** frames) {
+#if defined(YALGO_LOG_HAS_BACKTRACE)
+    return backtrace(frames, kMaxFrames);
+#elif defined(_WIN32)
+    return static_cast<int>(CaptureStackBackTrace(0, kMaxFrames, frames, nullptr));
+#else
+    (void)frames;
+    return 0;
+#endif
+}
+
+// 依次调用写出回调，再把崩溃原因与调用栈写到标准错误
+void runCrashCallbacks(int signal, const char* reason) {
+    void* frames[kMaxFrames];
+    CrashInfo crash;
+    crash.signal = signal;
+    crash.reason = reason;
+    crash.timestamp_us = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    crash.frames = frames;
+    crash.frame_count = captureFrames(frames);
+
+    for (CallbackSlot& slot : callback_slots) {
+        void* context = slot.context.load(std::memory_order_acquire);
+        CrashFlushCallback callback = slot.callback.load(std::memory_order_acquire);
+        if (context && callback) {
+            callback(context, crash);
+        }
+    }
+
+    char banner[128];
+    size_t length = 0;
+    appendText(banner, length, sizeof(banner) - 1, "*** yalgo_log: fatal ");
+    appendText(banner, length, sizeof(banner) - 1, reason);
+    appendText(banner, length, sizeof(banner) - 1, ", pending logs flushed; stack trace: ***");
+    banner[length++] = '\n';
+    writeAllOnCrash(2, banner, length);
+    writeCrashBacktrace(2, frames, crash.frame_count);
+}
+
+// 恢复原有的信号处理方式
+void restoreHandlers() {
+    for (size_t i = 0; i < kSignalCount; ++i) {
+#ifdef _WIN32
+        ::signal(kFatalSignals[i], previous_handlers[i] ? previous_handlers[i] : SIG_DFL);
+#else
+        sigaction(kFatalSignals[i], &previous_actions[i], nullptr);
+#endif
+    }
+}
+
+// 致命信号处理函数
+void onFatalSignal(int signal) {
+    int expected = 0;
+    if (crash_state.compare_exchange_strong(expected, 1)) {
+        // 先恢复原有处理方式：写出过程中再次出错时直接终止，不会重入
+        restoreHandlers();
+        runCrashCallbacks(signal, signalName(signal));
+        crash_state.store(2);
+    } else {
+        // 其他线程正在写出时最多等待2秒（nanosleep异步信号安全），std::terminate写出后的abort直接放行
+        for (int i = 0; i < 2000 && crash_state.load() == 1; ++i) {
+#ifdef _WIN32
+            Sleep(1);
+#else
+            struct timespec interval = {0, 1000000};
+            nanosleep(&interval, nullptr);
+#endif
+        }
+        restoreHandlers();
+    }
+    // 处理函数返回后按恢复的处理方式投递
+    raise(signal);
+}
+
+// std::terminate处理函数
+[[noreturn]] void onTerminate() {
+    int expected = 0;
+    if (crash_state.compare_exchange_strong(expected, 1)) {
+        runCrashCallbacks(SIGABRT, "std::terminate");
+        crash_state.store(2);
+    }
+    // 原处理函数（如输出未捕获异常的类型）最终调用abort
+    if (previous_terminate) {
+        previous_terminate();
+    }
+    std::abort();
+}
+
+} // namespace
+
+// 安装崩溃处理
+bool installCrashHandler() {
+    std::lock_guard<std::mutex> lock(install_mutex);
+    recordUtcOffset();
+    if (installed) {
+        return true;
+    }
+#if defined(YALGO_LOG_HAS_BACKTRACE)
+    // 首次调用backtrace会加载libgcc并分配内存，提前在正常上下文中完成
+    void* warmup[1];
+    backtrace(warmup, 1);
+#endif
+
+    bool ok = true;
+#ifdef _WIN32
+    for (size_t i = 0; i < kSignalCount; ++i) {
+        void (*previous)(int) = ::signal(kFatalSignals[i], onFatalSignal);
+        if (previous == SIG_ERR) {
+            ok = false;
+            previous = SIG_DFL;
+        }
+        previous_handlers[i] = previous;
+    }
+#else
+    // 安装线程栈溢出时在备用栈上执行处理函数
+    stack_t current;
+    if (sigaltstack(nullptr, &current) == 0 && (current.ss_flags & SS_DISABLE)) {
+        stack_t stack;
+        stack.ss_sp = alt_stack;
+        stack.ss_size = sizeof(alt_stack);
+        stack.ss_flags = 0;
+        sigaltstack(&stack, nullptr);
+    }
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = onFatalSignal;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_ONSTACK;
+    for (size_t i = 0; i < kSignalCount; ++i) {
+        if (sigaction(kFatalSignals[i], &action, &previous_actions[i]) != 0) {
+            ok = false;
+        }
+    }
+#endif
+    previous_terminate = std::set_terminate(onTerminate);
+    installed = true;
+    return ok;
+}
+
+// 登记写出回调
+bool registerCrashCallback(CrashFlushCallback callback, void* context) {
+    for (CallbackSlot& slot : callback_slots) {
+        void* expected = nullptr;
+        if (slot.context.compare_exchange_strong(expected, context)) {
+            slot.callback.store(callback, std::memory_order_release);
+            return true;
+        }
+    }
+    return false;
+}
+
+// 注销写出回调
+void unregisterCrashCallback(void* context) {
+    for (CallbackSlot& slot : callback_slots) {
+        void* expected = context;
+        if (slot.context.compare_exchange_strong(expected, nullptr)) {
+            slot.callback.store(nullptr, std::memory_order_release);
+        }
+    }
+}
+
+// 完整写入文件描述符
+bool writeAllOnCrash(int fd, const char* data, size_t size) {
+    while (size > 0) {
+#ifdef _WIN32
+        int n = _write(fd, data, static_cast<unsigned int>(size));
+#else
+        ssize_t n = ::write(fd, data, size);
+#endif
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// 按记录的时区偏移格式化时间戳
+size_t formatCrashTimestamp(uint64_t timestamp_us, char* buf) {
+    int64_t seconds = static_cast<int64_t>(timestamp_us / 1000000) + utc_offset_s.load(std::memory_order_relaxed);
+    int64_t days = seconds >= 0 ? seconds / 86400 : (seconds - 86399) / 86400;
+    int64_t second_of_day = seconds - days * 86400;
+    int64_t year = 0;
+    unsigned month = 0;
+    unsigned day = 0;
+    civilFromDays(days, year, month, day);
+
+    char* p = buf;
+    p = writeDigits(p, static_cast<uint64_t>(year < 0 ? 0 : year), 4);
+    *p++ = '-';
+    p = writeDigits(p, month, 2);
+    *p++ = '-';
+    p = writeDigits(p, day, 2);
+    *p++ = ' ';
+    p = writeDigits(p, static_cast<uint64_t>(second_of_day / 3600), 2);
+    *p++ = ':';
+    p = writeDigits(p, static_cast<uint64_t>(second_of_day / 60 % 60), 2);
+    *p++ = ':';
+    p = writeDigits(p, static_cast<uint64_t>(second_of_day % 60), 2);
+    *p++ = '.';
+    p = writeDigits(p, timestamp_us % 1000000, 6);
+    return static_cast<size_t>(p - buf);
+}
+
+// 格式化一行调用栈
+size_t formatCrashFrame(int index, const void* address, char* buf) {
+    static const char hex[] = "0123456789abcdef";
+    char* p = buf;
+    *p++ = '#';
+    int width = index >= 10 ? 2 : 1;
+    p = writeDigits(p, static_cast<uint64_t>(index < 0 ? 0 : index % 100), width);
+    *p++ = ' ';
+    *p++ = '0';
+    *p++ = 'x';
+    uintptr_t value = reinterpret_cast<uintptr_t>(address);
+    int shift = static_cast<int>(sizeof(value) * 8) - 4;
+    while (shift > 0 && ((value >> shift) & 0xF) == 0) {
+        shift -= 4;
+    }
+    for (; shift >= 0; shift -= 4) {
+        *p++ = hex[(value >> shift) & 0xF];
+    }
+    *p++ = '\n';
+    return static_cast<size_t>(p - buf);
+}
+
+// 写出调用栈
+void writeCrashBacktrace(int fd, void* const* frames, int frame_count) {
+#if defined(YALGO_LOG_HAS_BACKTRACE)
+    // backtrace_symbols_fd不分配内存，逐行写出"模块(符号+偏移)[地址]"
+    backtrace_symbols_fd(frames, frame_count, fd);
+#else
+    char line[32];
+    for (int i = 0; i < frame_count; ++i) {
+        writeAllOnCrash(fd, line, formatCrashFrame(i, frames[i], line));
+    }
+#endif
+}
+
+} // namespace log
+} // namespace yalgo
@@ -0,0 +1,100 @@
+/**
+ * @file crash_handler.h
+ * @brief 致命信号与std::terminate时写出待处理日志的崩溃处理
+ * @author yAlgo Team
+ * @date 2026-10-16
+ * @version 1.0.0
+ *
+ * 进程收到SIGSEGV、SIGBUS、SIGFPE、SIGILL、SIGABRT或调用std::terminate时，
+ * 依次调用已登记的写出回调，把各日志器队列中尚未写出的日志直接写入文件描述符，
+ * 追加调用栈后恢复原有处理方式并重新发出信号。回调在信号处理函数中执行，
+ * 只能使用异步信号安全的操作：不分配内存、不加锁、不调用stdio。
+ */
+
+#ifndef YALGO_SDK_LOG_CRASH_HANDLER_H
+#define YALGO_SDK_LOG_CRASH_HANDLER_H
+
+#include "log_exports.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace yalgo {
+namespace log {
+
+/**
+ * @brief 崩溃现场
+ */
+struct CrashInfo {
+    int signal = 0;              ///< 信号编号（std::terminate为SIGABRT）
+    const char* reason = "";     ///< 信号名或"std::terminate"
+    uint64_t timestamp_us = 0;   ///< 崩溃时间（Unix纪元微秒）
+    void* const* frames = nullptr; ///< 崩溃线程的调用栈地址
+    int frame_count = 0;         ///< 调用栈层数（平台不支持时为0）
+};
+
+/**
+ * @brief 崩溃写出回调（在信号处理函数中调用）
+ * @param context 登记时传入的上下文
+ * @param crash 崩溃现场
+ */
+typedef void (*CrashFlushCallback)(void* context, const CrashInfo& crash);
+
+/**
+ * @brief 安装崩溃处理（可重复调用，只安装一次）
+ *
+ * @details 原有的信号处理方式与terminate处理函数会被保存，写出完成后恢复并
+ * 重新发出信号，默认处理方式下进程照常终止并生成core文件。安装线程同时设置
+ * 备用信号栈，栈溢出引起的SIGSEGV也能执行写出；其他线程栈溢出时无法写出。
+ * Windows上用signal()安装，调用栈只输出地址。
+ * @return 全部信号处理函数是否安装成功
+ */
+LOG_API bool installCrashHandler();
+
+/**
+ * @brief 登记崩溃写出回调
+ * @param callback 回调
+ * @param context 上下文（同时作为注销时的键）
+ * @return 登记表已满（16项）时返回false
+ */
+LOG_API bool registerCrashCallback(CrashFlushCallback callback, void* context);
+
+/**
+ * @brief 注销崩溃写出回调
+ * @param context 登记时传入的上下文
+ */
+LOG_API void unregisterCrashCallback(void* context);
+
+/**
+ * @brief 把数据完整写入文件描述符（异步信号安全，处理EINTR与部分写入）
+ * @return 是否全部写入
+ */
+LOG_API bool writeAllOnCrash(int fd, const char* data, size_t size);
+
+/**
+ * @brief 格式化"YYYY-MM-DD hh:mm:ss.uuuuuu"（异步信号安全）
+ *
+ * @details 不调用localtime，按安装崩溃处理时记录的本地时区偏移换算，
+ * 之后发生的夏令时切换不会反映在结果中。
+ * @param timestamp_us Unix纪元微秒
+ * @param buf 输出缓冲（至少32字节）
+ * @return 写入的字节数
+ */
+LOG_API size_t formatCrashTimestamp(uint64_t timestamp_us, char* buf);
+
+/**
+ * @brief 格式化一行调用栈"#序号 0x地址\n"（异步信号安全）
+ * @param buf 输出缓冲（至少32字节）
+ * @return 写入的字节数
+ */
+LOG_API size_t formatCrashFrame(int index, const void* address, char* buf);
+
+/**
+ * @brief 把调用栈写入文件描述符，能解析时附带模块与符号名（异步信号安全）
+ */
+LOG_API void writeCrashBacktrace(int fd, void* const* frames, int frame_count);
+
+} // namespace log
+} // namespace yalgo
+
+#endif // YALGO_SDK_LOG_CRASH_HANDLER_H
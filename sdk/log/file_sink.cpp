@@ -0,0 +1,241 @@
+/**
+ * @file file_sink.cpp
+ * @brief 日志文件输出实现
+ * @author yAlgo Team
+ * @date 2026-10-16
+ * @version 1.0.0
+ */
+
+#include "file_sink.h"
+#include "crash_handler.h"
+
+#include <atomic>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace yalgo {
+namespace log {
+
+namespace {
+
+#ifndef _WIN32
+#ifdef IOV_MAX
+const size_t kMaxIov = IOV_MAX;
+#else
+const size_t kMaxIov = 1024;
+#endif
+#endif
+
+} // namespace
+
+// 追加一行文本
+void FileSink::appendLine(const std::string& line) {
+    append(line.data(), line.size());
+    append("\n", 1);
+}
+
+// 默认轮转：关闭、改名、重新打开
+bool FileSink::rotate(const std::string& backup_path) {
+    std::string path = path_;
+    close();
+    std::rename(path.c_str(), backup_path.c_str());
+    return open(path);
+}
+
+// 构造函数
+BufferedFileSink::BufferedFileSink()
+    : fd_(-1),
+      chunks_(),
+      used_chunks_(0),
+      pending_bytes_(0),
+      file_size_(0),
+      write_calls_(0),
+      flushing_(false),
+      flush_base_(0) {}
+
+// 析构函数
+BufferedFileSink::~BufferedFileSink() {
+    close();
+}
+
+// 打开文件
+bool BufferedFileSink::open(const std::string& path) {
+    close();
+    path_ = path;
+#ifdef _WIN32
+    fd_ = _open(path.c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, _S_IREAD | _S_IWRITE);
+    if (fd_ < 0) {
+        return false;
+    }
+    struct _stat64 st;
+    file_size_ = (_fstat64(fd_, &st) == 0) ? static_cast<uint64_t>(st.st_size) : 0;
+#else
+    fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        return false;
+    }
+    struct stat st;
+    file_size_ = (fstat(fd_, &st) == 0) ? static_cast<uint64_t>(st.st_size) : 0;
+#endif
+    write_calls_ = 0;
+    return true;
+}
+
+// 关闭文件
+void BufferedFileSink::close() {
+    if (fd_ < 0) {
+        return;
+    }
+    flush();
+#ifdef _WIN32
+    _close(fd_);
+#else
+    ::close(fd_);
+#endif
+    fd_ = -1;
+    file_size_ = 0;
+}
+
+// 追加数据
+void BufferedFileSink::append(const char* data, size_t size) {
+    while (size > 0) {
+        if (used_chunks_ == 0 || chunks_[used_chunks_ - 1].size() == CHUNK_SIZE) {
+            if (used_chunks_ == chunks_.size()) {
+                chunks_.emplace_back();
+                chunks_.back().reserve(CHUNK_SIZE);
+            }
+            ++used_chunks_;
+        }
+        std::string& chunk = chunks_[used_chunks_ - 1];
+        size_t n = std::min(size, CHUNK_SIZE - chunk.size());
+        chunk.append(data, n);
+        data += n;
+        size -= n;
+        pending_bytes_ += n;
+    }
+}
+
+// 写出提交缓冲
+bool BufferedFileSink::flush() {
+    if (pending_bytes_ == 0) {
+        return true;
+    }
+
+    // 写出到清空分块之间，崩溃处理按文件大小跳过已写入的部分
+    flush_base_.store(file_size_, std::memory_order_relaxed);
+    flushing_.store(true, std::memory_order_release);
+    bool ok = fd_ >= 0;
+    if (ok) {
+#ifdef _WIN32
+        for (size_t i = 0; i < used_chunks_ && ok; ++i) {
+            const std::string& chunk = chunks_[i];
+            size_t done = 0;
+            while (done < chunk.size()) {
+                int n = _write(fd_, chunk.data() + done, static_cast<unsigned int>(chunk.size() - done));
+                ++write_calls_;
+                if (n <= 0) {
+                    ok = false;
+                    break;
+                }
+                done += static_cast<size_t>(n);
+                file_size_ += static_cast<uint64_t>(n);
+            }
+        }
+#else
+        // 分块按IOV_MAX分组提交，处理部分写入后从断点继续
+        std::vector<struct iovec> iov(std::min(used_chunks_, kMaxIov));
+        size_t chunk_index = 0;
+        size_t chunk_offset = 0;
+        while (chunk_index < used_chunks_) {
+            size_t count = 0;
+            for (size_t i = chunk_index; i < used_chunks_ && count < iov.size(); ++i, ++count) {
+                size_t offset = (i == chunk_index) ? chunk_offset : 0;
+                iov[count].iov_base = const_cast<char*>(chunks_[i].data()) + offset;
+                iov[count].iov_len = chunks_[i].size() - offset;
+            }
+            ssize_t n = ::writev(fd_, iov.data(), static_cast<int>(count));
+            ++write_calls_;
+            if (n <= 0) {
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                ok = false;
+                break;
+            }
+            file_size_ += static_cast<uint64_t>(n);
+            size_t written = static_cast<size_t>(n);
+            while (written > 0 && chunk_index < used_chunks_) {
+                size_t remain = chunks_[chunk_index].size() - chunk_offset;
+                if (written >= remain) {
+                    written -= remain;
+                    ++chunk_index;
+                    chunk_offset = 0;
+                } else {
+                    chunk_offset += written;
+                    written = 0;
+                }
+            }
+        }
+#endif
+    }
+
+    // 写入失败的数据直接丢弃，避免缓冲无限增长
+    for (size_t i = 0; i < used_chunks_; ++i) {
+        chunks_[i].clear();
+    }
+    used_chunks_ = 0;
+    pending_bytes_ = 0;
+    flushing_.store(false, std::memory_order_release);
+    return ok;
+}
+
+// 崩溃时写出提交缓冲
+void BufferedFileSink::flushOnCrash() {
+    if (fd_ < 0) {
+        return;
+    }
+    uint64_t skip = 0;
+    if (flushing_.load(std::memory_order_acquire)) {
+#ifdef _WIN32
+        struct _stat64 st;
+        bool stat_ok = _fstat64(fd_, &st) == 0;
+#else
+        struct stat st;
+        bool stat_ok = fstat(fd_, &st) == 0;
+#endif
+        uint64_t base = flush_base_.load(std::memory_order_relaxed);
+        if (stat_ok && static_cast<uint64_t>(st.st_size) > base) {
+            skip = static_cast<uint64_t>(st.st_size) - base;
+        }
+    }
+    for (size_t i = 0; i < used_chunks_; ++i) {
+        size_t size = chunks_[i].size();
+        size_t offset = static_cast<size_t>(std::min<uint64_t>(skip, size));
+        skip -= offset;
+        if (offset < size && !writeAllOnCrash(fd_, chunks_[i].data() + offset, size - offset)) {
+            return;
+        }
+    }
+}
+
+// 崩溃时直接写入文件
+bool BufferedFileSink::appendOnCrash(const char* data, size_t size) {
+    return fd_ >= 0 && writeAllOnCrash(fd_, data, size);
+}
+
+} // namespace log
+} // namespace yalgo
@@ -0,0 +1,190 @@
+/**
+ * @file file_sink.h
+ * @brief 日志文件输出接口与批量提交实现
+ * @author yAlgo Team
+ * @date 2026-10-16
+ * @version 1.0.0
+ */
+
+#ifndef YALGO_SDK_LOG_FILE_SINK_H
+#define YALGO_SDK_LOG_FILE_SINK_H
+
+#include "log_exports.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace yalgo {
+namespace log {
+
+/**
+ * @brief 日志文件输出接口
+ *
+ * @details 以字节流的形式接收已编码的日志（文本行或二进制条目），负责写入、
+ * 刷新和轮转。非线程安全，仅由日志后台线程使用。
+ */
+class LOG_API FileSink {
+public:
+    /**
+     * @brief 析构函数
+     */
+    virtual ~FileSink() {}
+
+    /**
+     * @brief 以追加方式打开文件（已打开的文件先关闭）
+     * @param path 文件路径
+     * @return 是否打开成功
+     */
+    virtual bool open(const std::string& path) = 0;
+
+    /**
+     * @brief 写出未提交数据并关闭文件
+     */
+    virtual void close() = 0;
+
+    /**
+     * @brief 文件是否已打开
+     */
+    virtual bool isOpen() const = 0;
+
+    /**
+     * @brief 追加数据
+     * @param data 数据
+     * @param size 字节数
+     */
+    virtual void append(const char* data, size_t size) = 0;
+
+    /**
+     * @brief 追加一行文本（自动补换行符）
+     * @param line 文本
+     */
+    void appendLine(const std::string& line);
+
+    /**
+     * @brief 把尚未写出的数据交给内核
+     * @return 是否全部写入成功
+     */
+    virtual bool flush() = 0;
+
+    /**
+     * @brief 尚未写出的字节数
+     */
+    virtual size_t pendingBytes() const = 0;
+
+    /**
+     * @brief 文件当前大小（含尚未写出的数据）
+     */
+    virtual uint64_t size() const = 0;
+
+    /**
+     * @brief 轮转：当前文件改名为backup_path，并在原路径上继续写入新文件
+     * @param backup_path 历史文件路径
+     * @return 新文件是否打开成功
+     */
+    virtual bool rotate(const std::string& backup_path);
+
+    /**
+     * @brief 崩溃时写出尚未提交的数据（异步信号安全，不修改内部状态）
+     */
+    virtual void flushOnCrash() {}
+
+    /**
+     * @brief 崩溃时直接追加数据（异步信号安全：不分配内存、不加锁）
+     * @param data 数据
+     * @param size 字节数
+     * @return 是否写入成功
+     */
+    virtual bool appendOnCrash(const char* data, size_t size) {
+        (void)data;
+        (void)size;
+        return false;
+    }
+
+    /**
+     * @brief 当前文件路径
+     */
+    const std::string& path() const { return path_; }
+
+protected:
+    std::string path_; ///< 当前文件路径
+};
+
+/**
+ * @brief 批量提交的日志文件输出
+ *
+ * @details 写入的数据先追加到内存中的分块缓冲，flush时用一次writev把所有分块
+ * 交给内核，避免每行日志一次系统调用。分块在flush后复用，稳态下不再分配内存。
+ * 何时flush由调用方按策略决定。
+ */
+class LOG_API BufferedFileSink : public FileSink {
+public:
+    /**
+     * @brief 构造函数
+     */
+    BufferedFileSink();
+
+    /**
+     * @brief 析构函数，写出未提交数据并关闭文件
+     */
+    ~BufferedFileSink() override;
+
+    BufferedFileSink(const BufferedFileSink&) = delete;
+    BufferedFileSink& operator=(const BufferedFileSink&) = delete;
+
+    bool open(const std::string& path) override;
+    void close() override;
+    bool isOpen() const override { return fd_ >= 0; }
+    void append(const char* data, size_t size) override;
+
+    /**
+     * @brief 把提交缓冲中的全部数据一次性写入文件
+     * @return 是否全部写入成功
+     */
+    bool flush() override;
+
+    size_t pendingBytes() const override { return pending_bytes_; }
+    uint64_t size() const override { return file_size_ + pending_bytes_; }
+
+    /**
+     * @brief 逐个分块write写出提交缓冲（不分配iovec数组）
+     *
+     * @details 调用方须先让写入线程停住。崩溃发生在写入线程flush途中时，按文件当前
+     * 大小跳过其已写入的部分，避免重复写出。
+     */
+    void flushOnCrash() override;
+
+    /**
+     * @brief 直接write到文件
+     */
+    bool appendOnCrash(const char* data, size_t size) override;
+
+    /**
+     * @brief 文件描述符（未打开时为-1）
+     */
+    int fd() const { return fd_; }
+
+    /**
+     * @brief 打开以来执行的写系统调用次数
+     */
+    uint64_t writeCalls() const { return write_calls_; }
+
+private:
+    static const size_t CHUNK_SIZE = 64 * 1024; ///< 单个分块容量
+
+    int fd_;                         ///< 文件描述符
+    std::vector<std::string> chunks_;///< 分块缓冲（已用分块在前）
+    size_t used_chunks_;             ///< 含数据的分块数
+    size_t pending_bytes_;           ///< 尚未写出的字节数
+    uint64_t file_size_;             ///< 已写入文件的字节数
+    uint64_t write_calls_;           ///< 写系统调用次数
+    std::atomic<bool> flushing_;     ///< flush正在写出并清空分块（崩溃处理中读取）
+    std::atomic<uint64_t> flush_base_; ///< 本次flush开始时的文件大小
+};
+
+} // namespace log
+} // namespace yalgo
+
+#endif // YALGO_SDK_LOG_FILE_SINK_H
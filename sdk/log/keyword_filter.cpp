@@ -0,0 +1,142 @@
+/**
+ * @file keyword_filter.cpp
+ * @brief 基于Aho-Corasick自动机的日志关键词过滤实现
+ * @author yAlgo Team
+ * @date 2026-10-16
+ * @version 1.0.0
+ */
+
+#include "keyword_filter.h"
+
+#include <cstring>
+#include <deque>
+#include <limits>
+
+namespace yalgo {
+namespace log {
+
+namespace {
+
+const uint32_t kNoTransition = std::numeric_limits<uint32_t>::max();
+
+} // namespace
+
+// 构建过滤器
+KeywordFilter::KeywordFilter(const std::vector<std::string>& include_keywords,
+                             const std::vector<std::string>& exclude_keywords)
+    : include_keywords_(include_keywords),
+      exclude_keywords_(exclude_keywords) {
+    std::memset(classes_, 0, sizeof(classes_));
+
+    // 1. 字节类别：只为关键词中出现过的字节分配类别
+    uint32_t total_length = 0;
+    for (const auto* list : {&include_keywords_, &exclude_keywords_}) {
+        for (const std::string& keyword : *list) {
+            for (unsigned char c : keyword) {
+                if (classes_[c] == 0) {
+                    classes_[c] = static_cast<uint8_t>(class_count_++);
+                }
+            }
+            total_length += static_cast<uint32_t>(keyword.size());
+        }
+    }
+
+    // 2. 字典树：每个状态一行转移，命中标志暂存在outputs中
+    const uint32_t k = class_count_;
+    std::vector<uint32_t> goto_table(static_cast<size_t>(total_length + 1) * k, kNoTransition);
+    std::vector<uint32_t> outputs(1, 0);
+    auto insert = [&](const std::string& keyword, uint32_t flag) {
+        if (keyword.empty()) {
+            return;
+        }
+        uint32_t state = 0;
+        for (unsigned char c : keyword) {
+            uint32_t& target = goto_table[state * k + classes_[c]];
+            if (target == kNoTransition) {
+                target = static_cast<uint32_t>(outputs.size());
+                outputs.push_back(0);
+            }
+            state = target;
+        }
+        outputs[state] |= flag;
+        if (flag == MATCH_INCLUDE) {
+            has_include_ = true;
+        } else {
+            has_exclude_ = true;
+        }
+    };
+    for (const std::string& keyword : include_keywords_) {
+        insert(keyword, MATCH_INCLUDE);
+    }
+    for (const std::string& keyword : exclude_keywords_) {
+        insert(keyword, MATCH_EXCLUDE);
+    }
+    const uint32_t state_count = static_cast<uint32_t>(outputs.size());
+    goto_table.resize(static_cast<size_t>(state_count) * k);
+
+    // 3. 按层遍历补全失配转移，得到确定自动机；命中标志沿失配链合并
+    std::vector<uint32_t> fail(state_count, 0);
+    std::deque<uint32_t> pending;
+    for (uint32_t c = 0; c < k; ++c) {
+        uint32_t& target = goto_table[c];
+        if (target == kNoTransition) {
+            target = 0;
+        } else {
+            pending.push_back(target);
+        }
+    }
+    while (!pending.empty()) {
+        uint32_t state = pending.front();
+        pending.pop_front();
+        outputs[state] |= outputs[fail[state]];
+        for (uint32_t c = 0; c < k; ++c) {
+            uint32_t& target = goto_table[state * k + c];
+            uint32_t fallback = goto_table[fail[state] * k + c];
+            if (target == kNoTransition) {
+                target = fallback;
+            } else {
+                fail[target] = fallback;
+                pending.push_back(target);
+            }
+        }
+    }
+
+    // 4. 转移表项预乘类别数并附带目标状态的命中标志
+    next_.resize(goto_table.size());
+    for (size_t i = 0; i < goto_table.size(); ++i) {
+        uint32_t target = goto_table[i];
+        next_[i] = ((target * k) << 2) | outputs[target];
+    }
+}
+
+// 判断日志是否保留
+bool KeywordFilter::accept(const char* text, size_t size) const {
+    if (empty()) {
+        return true;
+    }
+    const uint32_t* next = next_.data();
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(text);
+    const unsigned char* end = p + size;
+    // 内层循环只有查表，每64字节检查一次能否提前结束
+    const uint32_t decided = has_exclude_ ? MATCH_EXCLUDE : MATCH_INCLUDE;
+    uint32_t offset = 0;
+    uint32_t seen = 0;
+    while (p != end) {
+        const unsigned char* chunk_end = (end - p > 64) ? p + 64 : end;
+        while (p != chunk_end) {
+            uint32_t entry = next[offset + classes_[*p++]];
+            offset = entry >> 2;
+            seen |= entry;
+        }
+        if (seen & decided) {
+            break;
+        }
+    }
+    if (seen & MATCH_EXCLUDE) {
+        return false;
+    }
+    return !has_include_ || (seen & MATCH_INCLUDE) != 0;
+}
+
+} // namespace log
+} // namespace yalgo
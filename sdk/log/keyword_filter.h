@@ -0,0 +1,74 @@
+/**
+ * @file keyword_filter.h
+ * @brief 基于Aho-Corasick自动机的日志关键词过滤
+ * @author yAlgo Team
+ * @date 2026-10-16
+ * @version 1.0.0
+ *
+ * 所有包含词与排除词构建为同一个自动机，每条日志只扫描一遍，
+ * 每个字节一次查表，匹配耗时与关键词数量无关。
+ */
+
+#ifndef YALGO_SDK_LOG_KEYWORD_FILTER_H
+#define YALGO_SDK_LOG_KEYWORD_FILTER_H
+
+#include "log_exports.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace yalgo {
+namespace log {
+
+/**
+ * @brief 日志关键词过滤器（构建后只读，可被多个线程同时使用）
+ *
+ * @details 状态转移表按字节类别压缩：未出现在任何关键词中的字节归入类别0，
+ * 一律回到初始状态。转移表项为 目标状态偏移<<2 | 命中标志，扫描时无需再查输出表。
+ * 关键词区分大小写。
+ */
+class LOG_API KeywordFilter {
+public:
+    /**
+     * @brief 构建过滤器
+     * @param include_keywords 包含词：非空时日志须至少包含其中一个
+     * @param exclude_keywords 排除词：包含其中任意一个的日志被过滤
+     */
+    KeywordFilter(const std::vector<std::string>& include_keywords,
+                  const std::vector<std::string>& exclude_keywords);
+
+    /**
+     * @brief 判断日志是否保留
+     * @param text 日志内容
+     * @param size 内容长度
+     * @return 未命中排除词，且包含词为空或至少命中一个时返回true
+     */
+    bool accept(const char* text, size_t size) const;
+
+    /**
+     * @brief 是否没有任何关键词（此时accept总是返回true）
+     */
+    bool empty() const { return !has_include_ && !has_exclude_; }
+
+    const std::vector<std::string>& includeKeywords() const { return include_keywords_; }
+    const std::vector<std::string>& excludeKeywords() const { return exclude_keywords_; }
+
+private:
+    static const uint32_t MATCH_INCLUDE = 1; ///< 命中包含词
+    static const uint32_t MATCH_EXCLUDE = 2; ///< 命中排除词
+
+    std::vector<std::string> include_keywords_; ///< 包含词
+    std::vector<std::string> exclude_keywords_; ///< 排除词
+    bool has_include_ = false;                  ///< 是否有包含词
+    bool has_exclude_ = false;                  ///< 是否有排除词
+    uint8_t classes_[256];                      ///< 字节到类别的映射
+    uint32_t class_count_ = 1;                  ///< 类别数
+    std::vector<uint32_t> next_;                ///< 转移表：[状态 * 类别数 + 类别]
+};
+
+} // namespace log
+} // namespace yalgo
+
+#endif // YALGO_SDK_LOG_KEYWORD_FILTER_H
@@ -0,0 +1,155 @@
+/**
+ * @file log_format.cpp
+ * @brief 编译期检查的{}风格日志格式化实现
+ * @author yAlgo Team
+ * @date 2026-10-16
+ * @version 1.0.0
+ */
+
+#include "log_format.h"
+
+#include <charconv>
+#include <cstring>
+
+namespace yalgo {
+namespace log {
+
+namespace {
+
+const char kHexDigits[] = "0123456789abcdef";
+
+// 单个参数输出长度的上界
+size_t formatArgBound(const FormatArg& arg) {
+    switch (arg.type) {
+        case FormatArgType::STRING:  return arg.size;
+        case FormatArgType::CHAR:    return 1;
+        case FormatArgType::BOOL:    return 5;
+        case FormatArgType::POINTER: return 18;
+        case FormatArgType::FLOAT:
+        case FormatArgType::DOUBLE:  return 32;
+        default:                     return 20;
+    }
+}
+
+// 写入单个参数，返回写入后的位置
+char* writeFormatArg(char* out, const FormatArg& arg) {
+    switch (arg.type) {
+        case FormatArgType::INT64:
+            return std::to_chars(out, out + 20, arg.i).ptr;
+        case FormatArgType::UINT64:
+            return std::to_chars(out, out + 20, arg.u).ptr;
+        case FormatArgType::FLOAT:
+            return std::to_chars(out, out + 32, arg.f).ptr;
+        case FormatArgType::DOUBLE:
+            return std::to_chars(out, out + 32, arg.d).ptr;
+        case FormatArgType::BOOL:
+            if (arg.b) {
+                std::memcpy(out, "true", 4);
+                return out + 4;
+            }
+            std::memcpy(out, "false", 5);
+            return out + 5;
+        case FormatArgType::CHAR:
+            *out = arg.c;
+            return out + 1;
+        case FormatArgType::STRING:
+            if (arg.size > 0) {
+                std::memcpy(out, arg.s, arg.size);
+            }
+            return out + arg.size;
+        case FormatArgType::POINTER: {
+            out[0] = '0';
+            out[1] = 'x';
+            char* end = out + 2;
+            int shift = 60;
+            while (shift > 0 && ((arg.u >> shift) & 0xF) == 0) {
+                shift -= 4;
+            }
+            for (; shift >= 0; shift -= 4) {
+                *end++ = kHexDigits[(arg.u >> shift) & 0xF];
+            }
+            return end;
+        }
+    }
+    return out;
+}
+
+// 按格式串写入，out须有足够空间，返回写入后的位置
+char* writeFormatted(char* out, const char* format, const FormatArg* args, size_t arg_count) {
+    size_t next = 0;
+    const char* run = format;
+    const char* p = format;
+    for (; *p != '\0'; ++p) {
+        if (*p != '{' && *p != '}') {
+            continue;
+        }
+        std::memcpy(out, run, static_cast<size_t>(p - run));
+        out += p - run;
+        if (p[0] == '{' && p[1] == '}' && next < arg_count) {
+            out = writeFormatArg(out, args[next++]);
+            run = ++p + 1;
+        } else if (p[1] == p[0]) {
+            // {{ 或 }} 输出一个花括号
+            *out++ = *p++;
+            run = p + 1;
+        } else {
+            run = p;
+        }
+    }
+    std::memcpy(out, run, static_cast<size_t>(p - run));
+    return out + (p - run);
+}
+
+// 格式化结果长度的上界
+size_t formattedBound(const char* format, const FormatArg* args, size_t arg_count) {
+    size_t bound = std::strlen(format);
+    for (size_t i = 0; i < arg_count; ++i) {
+        bound += formatArgBound(args[i]);
+    }
+    return bound;
+}
+
+} // namespace
+
+// 按格式串追加参数
+void formatArgsTo(std::string& out, const char* format, const FormatArg* args, size_t arg_count) {
+    size_t begin = out.size();
+    out.resize(begin + formattedBound(format, args, arg_count));
+    char* end = writeFormatted(&out[begin], format, args, arg_count);
+    out.resize(static_cast<size_t>(end - out.data()));
+}
+
+// 生成带调用点前缀的日志正文
+void formatLogText(std::string& out, const char* module, const char* file, int line,
+                   const char* func, const char* format, const FormatArg* args, size_t arg_count) {
+    size_t module_len = std::strlen(module);
+    size_t file_len = std::strlen(file);
+    size_t func_len = std::strlen(func);
+    size_t begin = out.size();
+    // "[模块] " + "[文件:行号:函数] "
+    out.resize(begin + (module_len > 0 ? module_len + 3 : 0) + file_len + func_len + 16 +
+               formattedBound(format, args, arg_count));
+    char* p = &out[begin];
+    if (module_len > 0) {
+        *p++ = '[';
+        std::memcpy(p, module, module_len);
+        p += module_len;
+        std::memcpy(p, "] ", 2);
+        p += 2;
+    }
+    *p++ = '[';
+    std::memcpy(p, file, file_len);
+    p += file_len;
+    *p++ = ':';
+    p = std::to_chars(p, p + 11, line).ptr;
+    *p++ = ':';
+    std::memcpy(p, func, func_len);
+    p += func_len;
+    std::memcpy(p, "] ", 2);
+    p += 2;
+    p = writeFormatted(p, format, args, arg_count);
+    out.resize(static_cast<size_t>(p - out.data()));
+}
+
+} // namespace log
+} // namespace yalgo
@@ -0,0 +1,323 @@
+/**
+ * @file log_format.h
+ * @brief 编译期检查的{}风格日志格式化
+ * @author yAlgo Team
+ * @date 2026-10-16
+ * @version 1.0.0
+ *
+ * 格式串须为字符串字面量，占位符个数与参数个数在编译期核对，不一致时编译失败。
+ * 参数按类型打包后由库内的非模板函数一次性写入日志记录的正文缓冲：
+ * 先按参数估算上界、只分配一次，整数和浮点数用std::to_chars直接写入，
+ * 不经过C可变参数，也不产生中间字符串。
+ */
+
+#ifndef YALGO_SDK_LOG_LOG_FORMAT_H
+#define YALGO_SDK_LOG_LOG_FORMAT_H
+
+#include "log_exports.h"
+#include "async_logger.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace yalgo {
+namespace log {
+
+/**
+ * @brief 格式化参数类型
+ */
+enum class FormatArgType : uint8_t {
+    INT64,   ///< 有符号整数
+    UINT64,  ///< 无符号整数
+    FLOAT,   ///< 单精度浮点数
+    DOUBLE,  ///< 双精度浮点数（long double按double输出）
+    BOOL,    ///< 布尔值（true / false）
+    CHAR,    ///< 单个字符
+    STRING,  ///< 字符串（空指针输出(null)）
+    POINTER  ///< 指针地址（0x十六进制）
+};
+
+/**
+ * @brief 按类型打包的格式化参数（字符串只保存指针和长度）
+ */
+struct FormatArg {
+    FormatArgType type = FormatArgType::INT64; ///< 参数类型
+    union {
+        int64_t i;          ///< INT64
+        uint64_t u;         ///< UINT64、POINTER
+        float f;            ///< FLOAT
+        double d;           ///< DOUBLE
+        bool b;             ///< BOOL
+        char c;             ///< CHAR
+        const char* s;      ///< STRING内容
+    };
+    size_t size = 0;        ///< STRING长度
+};
+
+/**
+ * @brief 统计格式串中的{}占位符个数
+ *
+ * @details {{与}}输出字面花括号；未配对的花括号或花括号中带格式说明时返回-1。
+ * @param format 格式串
+ * @return 占位符个数，格式串非法时为-1
+ */
+constexpr int countFormatPlaceholders(const char* format) {
+    int count = 0;
+    for (const char* p = format; *p != '\0'; ++p) {
+        if (*p == '{') {
+            if (p[1] == '{') {
+                ++p;
+            } else if (p[1] == '}') {
+                ++count;
+                ++p;
+            } else {
+                return -1;
+            }
+        } else if (*p == '}') {
+            if (p[1] != '}') {
+                return -1;
+            }
+            ++p;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief 按格式串把参数追加到out（运行时版本，不做编译期检查）
+ *
+ * @details 先按参数估算输出长度的上界并一次性扩容，再直接写入。
+ * 多出的占位符原样输出{}，多出的参数忽略。
+ * @param out 追加输出
+ * @param format 格式串
+ * @param args 参数
+ * @param arg_count 参数个数
+ */
+LOG_API void formatArgsTo(std::string& out, const char* format, const FormatArg* args, size_t arg_count);
+
+/**
+ * @brief 生成{}风格日志的正文："[模块] [文件:行号:函数] 消息"（无模块时省略模块）
+ * @param out 追加输出
+ * @param module 模块名
+ * @param file 源文件
+ * @param line 行号
+ * @param func 函数名
+ * @param format 格式串
+ * @param args 参数
+ * @param arg_count 参数个数
+ */
+LOG_API void formatLogText(std::string& out, const char* module, const char* file, int line,
+                           const char* func, const char* format, const FormatArg* args,
+                           size_t arg_count);
+
+namespace detail {
+
+template <typename T>
+struct FormatAlwaysFalse : std::false_type {};
+
+inline FormatArg makeFormatArg(bool value) {
+    FormatArg arg;
+    arg.type = FormatArgType::BOOL;
+    arg.b = value;
+    return arg;
+}
+
+inline FormatArg makeFormatArg(char value) {
+    FormatArg arg;
+    arg.type = FormatArgType::CHAR;
+    arg.c = value;
+    return arg;
+}
+
+inline FormatArg makeFormatArg(float value) {
+    FormatArg arg;
+    arg.type = FormatArgType::FLOAT;
+    arg.f = value;
+    return arg;
+}
+
+inline FormatArg makeFormatArg(double value) {
+    FormatArg arg;
+    arg.type = FormatArgType::DOUBLE;
+    arg.d = value;
+    return arg;
+}
+
+inline FormatArg makeFormatArg(long double value) {
+    return makeFormatArg(static_cast<double>(value));
+}
+
+inline FormatArg makeFormatArg(std::string_view value) {
+    FormatArg arg;
+    arg.type = FormatArgType::STRING;
+    arg.s = value.data();
+    arg.size = value.size();
+    return arg;
+}
+
+inline FormatArg makeFormatArg(const std::string& value) {
+    return makeFormatArg(std::string_view(value));
+}
+
+inline FormatArg makeFormatArg(const char* value) {
+    return value ? makeFormatArg(std::string_view(value)) : makeFormatArg(std::string_view("(null)"));
+}
+
+inline FormatArg makeFormatArg(char* value) {
+    return makeFormatArg(static_cast<const char*>(value));
+}
+
+template <typename T>
+inline FormatArg makeFormatArg(const T& value) {
+    FormatArg arg;
+    if constexpr (std::is_integral<T>::value && std::is_signed<T>::value) {
+        arg.type = FormatArgType::INT64;
+        arg.i = static_cast<int64_t>(value);
+    } else if constexpr (std::is_integral<T>::value) {
+        arg.type = FormatArgType::UINT64;
+        arg.u = static_cast<uint64_t>(value);
+    } else if constexpr (std::is_pointer<T>::value) {
+        arg.type = FormatArgType::POINTER;
+        arg.u = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value));
+    } else {
+        static_assert(FormatAlwaysFalse<T>::value,
+                      "{}格式化参数仅支持整数、浮点数、布尔值、字符、字符串和指针");
+    }
+    return arg;
+}
+
+/**
+ * @brief 编译期核对格式串（FormatTag为返回格式串字面量的lambda），返回格式串
+ */
+template <size_t ArgCount, typename FormatTag>
+constexpr const char* checkedFormat(FormatTag format_tag) {
+    constexpr const char* format = format_tag();
+    constexpr int placeholders = countFormatPlaceholders(format);
+    static_assert(placeholders >= 0, "格式串中的花括号须成对出现（字面花括号写作{{或}}），占位符只支持{}");
+    static_assert(placeholders < 0 || placeholders == static_cast<int>(ArgCount),
+                  "格式串中的{}个数与参数个数不一致");
+    return format;
+}
+
+/**
+ * @brief 编译期核对格式串后格式化
+ */
+template <typename FormatTag, typename... Args>
+inline void formatChecked(std::string& out, FormatTag format_tag, const Args&... args) {
+    const char* format = checkedFormat<sizeof...(Args)>(format_tag);
+    const FormatArg format_args[sizeof...(Args) + 1] = {makeFormatArg(args)...};
+    formatArgsTo(out, format, format_args, sizeof...(Args));
+}
+
+/**
+ * @brief 编译期核对格式串后向logger提交一条{}风格日志，正文直接写入日志记录
+ */
+template <typename FormatTag, typename... Args>
+inline void submitFormatted(AsyncLogger& logger, FormatTag format_tag, LogLevel level, const char* module,
+                            const char* file, int line, const char* func, const Args&... args) {
+    const char* format = checkedFormat<sizeof...(Args)>(format_tag);
+    const FormatArg format_args[sizeof...(Args) + 1] = {makeFormatArg(args)...};
+    LogRecord record;
+    record.level = level;
+    formatLogText(record.text, module, file, line, func, format, format_args, sizeof...(Args));
+    logger.submit(std::move(record));
+}
+
+/**
+ * @brief 向默认日志器提交一条{}风格日志（按模块级别检查）
+ */
+template <typename FormatTag, typename... Args>
+inline void logFormatted(FormatTag format_tag, LogLevel level, uint32_t module_id, const char* module,
+                         const char* file, int line, const char* func, const Args&... args) {
+    if (!AsyncLogger::moduleLevelEnabled(module_id, level)) {
+        return;
+    }
+    submitFormatted(AsyncLogger::getInstance(), format_tag, level, module, file, line, func, args...);
+}
+
+} // namespace detail
+
+} // namespace log
+} // namespace yalgo
+
+// 按{}格式串追加到std::string：格式串须为字符串字面量，占位符个数在编译期核对
+#define YLOG_FORMAT_TO(out, format, ...) \
+    yalgo::log::detail::formatChecked(out, [] { return format; }, ##__VA_ARGS__)
+
+// {}风格日志宏实现：级别关闭时不求值参数
+#define YLOG_FMT_IMPL(level, module, format, ...) do { \
+    if (YLOG_MODULE_ENABLED(module, level)) { \
+        yalgo::log::detail::logFormatted([] { return format; }, level, YLOG_MODULE_ID(module), module, \
+                                         __FILE__, __LINE__, __func__, ##__VA_ARGS__); \
+    } \
+} while(0)
+
+#if YALGO_LOG_LEVEL >= 1 // LOG_ERROR级别
+#define YLOG_ERROR_FMT(format, ...) YLOG_FMT_IMPL(yalgo::log::LogLevel::LOG_ERROR, "", format, ##__VA_ARGS__)
+#define YLOG_MODULE_ERROR_FMT(module, format, ...) YLOG_FMT_IMPL(yalgo::log::LogLevel::LOG_ERROR, module, format, ##__VA_ARGS__)
+#else
+#define YLOG_ERROR_FMT(format, ...) do {} while(0)
+#define YLOG_MODULE_ERROR_FMT(module, format, ...) do {} while(0)
+#endif
+
+#if YALGO_LOG_LEVEL >= 2 // WARN级别
+#define YLOG_WARN_FMT(format, ...) YLOG_FMT_IMPL(yalgo::log::LogLevel::WARN, "", format, ##__VA_ARGS__)
+#define YLOG_MODULE_WARN_FMT(module, format, ...) YLOG_FMT_IMPL(yalgo::log::LogLevel::WARN, module, format, ##__VA_ARGS__)
+#else
+#define YLOG_WARN_FMT(format, ...) do {} while(0)
+#define YLOG_MODULE_WARN_FMT(module, format, ...) do {} while(0)
+#endif
+
+#if YALGO_LOG_LEVEL >= 3 // INFO级别
+#define YLOG_INFO_FMT(format, ...) YLOG_FMT_IMPL(yalgo::log::LogLevel::INFO, "", format, ##__VA_ARGS__)
+#define YLOG_MODULE_INFO_FMT(module, format, ...) YLOG_FMT_IMPL(yalgo::log::LogLevel::INFO, module, format, ##__VA_ARGS__)
+#else
+#define YLOG_INFO_FMT(format, ...) do {} while(0)
+#define YLOG_MODULE_INFO_FMT(module, format, ...) do {} while(0)
+#endif
+
+#if YALGO_LOG_LEVEL >= 4 // DEBUG级别
+#define YLOG_DEBUG_FMT(format, ...) YLOG_FMT_IMPL(yalgo::log::LogLevel::DEBUG, "", format, ##__VA_ARGS__)
+#define YLOG_MODULE_DEBUG_FMT(module, format, ...) YLOG_FMT_IMPL(yalgo::log::LogLevel::DEBUG, module, format, ##__VA_ARGS__)
+#else
+#define YLOG_DEBUG_FMT(format, ...) do {} while(0)
+#define YLOG_MODULE_DEBUG_FMT(module, format, ...) do {} while(0)
+#endif
+
+// 指定日志器的{}风格日志宏：logger为AsyncLogger对象（如 *audit_logger），按该日志器自己的运行时级别检查
+#define YLOG_LOGGER_FMT_IMPL(logger, level, format, ...) do { \
+    yalgo::log::AsyncLogger& yalgo_target_logger = (logger); \
+    if (YLOG_UNLIKELY(yalgo_target_logger.isEnabled(level))) { \
+        yalgo::log::detail::submitFormatted(yalgo_target_logger, [] { return format; }, level, "", \
+                                            __FILE__, __LINE__, __func__, ##__VA_ARGS__); \
+    } \
+} while(0)
+
+#if YALGO_LOG_LEVEL >= 1 // LOG_ERROR级别
+#define YLOG_LOGGER_ERROR_FMT(logger, format, ...) YLOG_LOGGER_FMT_IMPL(logger, yalgo::log::LogLevel::LOG_ERROR, format, ##__VA_ARGS__)
+#else
+#define YLOG_LOGGER_ERROR_FMT(logger, format, ...) do {} while(0)
+#endif
+
+#if YALGO_LOG_LEVEL >= 2 // WARN级别
+#define YLOG_LOGGER_WARN_FMT(logger, format, ...) YLOG_LOGGER_FMT_IMPL(logger, yalgo::log::LogLevel::WARN, format, ##__VA_ARGS__)
+#else
+#define YLOG_LOGGER_WARN_FMT(logger, format, ...) do {} while(0)
+#endif
+
+#if YALGO_LOG_LEVEL >= 3 // INFO级别
+#define YLOG_LOGGER_INFO_FMT(logger, format, ...) YLOG_LOGGER_FMT_IMPL(logger, yalgo::log::LogLevel::INFO, format, ##__VA_ARGS__)
+#else
+#define YLOG_LOGGER_INFO_FMT(logger, format, ...) do {} while(0)
+#endif
+
+#if YALGO_LOG_LEVEL >= 4 // DEBUG级别
+#define YLOG_LOGGER_DEBUG_FMT(logger, format, ...) YLOG_LOGGER_FMT_IMPL(logger, yalgo::log::LogLevel::DEBUG, format, ##__VA_ARGS__)
+#else
+#define YLOG_LOGGER_DEBUG_FMT(logger, format, ...) do {} while(0)
+#endif
+
+#endif // YALGO_SDK_LOG_LOG_FORMAT_H
@@ -0,0 +1,398 @@
+/**
+ * @file log_sink.cpp
+ * @brief 日志输出目标接口与内置实现
+ * @author yAlgo Team
+ * @date 2026-10-16
+ * @version 1.0.0
+ */
+
+#include "log_sink.h"
+#include "async_logger.h"
+#include "mmap_file_sink.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <syslog.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace yalgo {
+namespace log {
+
+namespace {
+
+// 单调时钟纳秒数
+uint64_t steadyNanos() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// 控制台颜色码（ANSI转义序列）
+const char* consoleColor(LogLevel level) {
+    switch (level) {
+        case LogLevel::LOG_ERROR: return "\033[31m"; // 红色
+        case LogLevel::WARN:  return "\033[33m"; // 黄色
+        case LogLevel::INFO:  return "\033[32m"; // 绿色
+        case LogLevel::DEBUG: return "\033[36m"; // 青色
+        default:              return "\033[0m";  // 默认颜色
+    }
+}
+
+} // namespace
+
+// 构造函数
+ConsoleSink::ConsoleSink(bool color) : color_(color) {}
+
+// 写入控制台缓冲
+void ConsoleSink::write(const LogSinkMessage& message) {
+    if (color_) {
+        buffer_ += consoleColor(message.level);
+        buffer_ += message.text;
+        buffer_ += "\033[0m\n";
+    } else {
+        buffer_ += message.text;
+        buffer_ += '\n';
+    }
+}
+
+// 一次写出控制台缓冲
+void ConsoleSink::flush() {
+    if (buffer_.empty()) {
+        return;
+    }
+    std::fwrite(buffer_.data(), 1, buffer_.size(), stdout);
+    std::fflush(stdout);
+    buffer_.clear();
+}
+
+// 构造并打开文件
+FileLogSink::FileLogSink(const std::string& path, LogFileSinkType type) {
+    if (type == LogFileSinkType::MMAP) {
+        file_.reset(new MmapFileSink());
+    } else {
+        file_.reset(new BufferedFileSink());
+    }
+    file_->open(path);
+}
+
+// 追加一行
+void FileLogSink::write(const LogSinkMessage& message) {
+    if (file_->isOpen()) {
+        file_->append(message.text.data(), message.text.size());
+        file_->append("\n", 1);
+    }
+}
+
+// 写出文件缓冲
+void FileLogSink::flush() {
+    if (file_->isOpen()) {
+        file_->flush();
+    }
+}
+
+// 构造函数
+SyslogSink::SyslogSink(const std::string& ident, const std::string& socket_path)
+    : ident_(ident), socket_path_(socket_path) {
+#ifndef _WIN32
+    pid_ = static_cast<int>(getpid());
+#endif
+}
+
+// 析构函数
+SyslogSink::~SyslogSink() {
+    flush();
+#ifndef _WIN32
+    closeSocket();
+#endif
+}
+
+// 写入系统日志
+void SyslogSink::write(const LogSinkMessage& message) {
+    LogLevel level = message.level;
+#ifdef _WIN32
+    // Windows Event Log（简化实现）
+    HANDLE hEventSource = RegisterEventSourceA(NULL, ident_.c_str());
+    if (hEventSource != NULL) {
+        WORD type = EVENTLOG_INFORMATION_TYPE;
+        if (level == LogLevel::LOG_ERROR) type = EVENTLOG_ERROR_TYPE;
+        else if (level == LogLevel::WARN) type = EVENTLOG_WARNING_TYPE;
+
+        std::string text(message.text);
+        LPCSTR strings[1] = {text.c_str()};
+        ReportEventA(hEventSource, type, 0, 0, NULL, 1, 0, strings, NULL);
+        DeregisterEventSource(hEventSource);
+    }
+#else
+    // RFC 3164报文："<PRI>Mmm dd hh:mm:ss ident[pid]: 正文"
+    int syslog_priority = LOG_INFO;
+    if (level == LogLevel::LOG_ERROR) syslog_priority = LOG_ERR;
+    else if (level == LogLevel::WARN) syslog_priority = LOG_WARNING;
+    else if (level == LogLevel::DEBUG) syslog_priority = LOG_DEBUG;
+
+    int64_t second = static_cast<int64_t>(message.timestamp_us / 1000000);
+    if (second != cached_second_) {
+        time_t time_value = static_cast<time_t>(second);
+        struct tm local_tm;
+        if (localtime_r(&time_value, &local_tm) != nullptr &&
+            std::strftime(cached_time_, sizeof(cached_time_), "%b %e %H:%M:%S", &local_tm) > 0) {
+            cached_second_ = second;
+        } else {
+            cached_time_[0] = '\0';
+            cached_second_ = -1;
+        }
+    }
+
+    char prefix[48];
+    int length = std::snprintf(prefix, sizeof(prefix), "<%d>%s ", LOG_USER | syslog_priority, cached_time_);
+    buffer_.append(prefix, static_cast<size_t>(length));
+    buffer_ += ident_;
+    length = std::snprintf(prefix, sizeof(prefix), "[%d]: ", pid_);
+    buffer_.append(prefix, static_cast<size_t>(length));
+    buffer_ += message.text;
+    offsets_.push_back(buffer_.size());
+#endif
+}
+
+// 批量发出缓冲中的日志
+void SyslogSink::flush() {
+#ifndef _WIN32
+    if (offsets_.empty()) {
+        return;
+    }
+    size_t count = offsets_.size();
+    size_t next = 0;
+    if (fd_ >= 0 || connectSocket()) {
+        next = sendPending(0);
+    }
+    // syslogd重启后旧连接失效：重新连接一次后重发剩余部分
+    if (next < count) {
+        closeSocket();
+        if (connectSocket()) {
+            next = sendPending(next);
+        }
+    }
+    if (next < count) {
+        send_failures_.fetch_add(count - next, std::memory_order_relaxed);
+        closeSocket();
+    }
+    buffer_.clear();
+    offsets_.clear();
+#endif
+}
+
+#ifndef _WIN32
+// 连接syslog套接字
+bool SyslogSink::connectSocket() {
+    struct sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (socket_path_.empty() || socket_path_.size() >= sizeof(addr.sun_path)) {
+        return false;
+    }
+    std::memcpy(addr.sun_path, socket_path_.c_str(), socket_path_.size());
+
+    fd_ = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd_ < 0) {
+        return false;
+    }
+    if (connect(fd_, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0) {
+        closeSocket();
+        return false;
+    }
+    return true;
+}
+
+// 关闭连接
+void SyslogSink::closeSocket() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+// 用sendmmsg分组发送缓冲中的日志
+size_t SyslogSink::sendPending(size_t first) {
+    const size_t kGroup = 64;
+    struct mmsghdr messages[kGroup];
+    struct iovec iovs[kGroup];
+    size_t count = offsets_.size();
+    size_t next = first;
+    while (next < count) {
+        size_t group = std::min(kGroup, count - next);
+        for (size_t i = 0; i < group; ++i) {
+            size_t begin = (next + i == 0) ? 0 : offsets_[next + i - 1];
+            iovs[i].iov_base = &buffer_[begin];
+            iovs[i].iov_len = offsets_[next + i] - begin;
+            std::memset(&messages[i], 0, sizeof(messages[i]));
+            messages[i].msg_hdr.msg_iov = &iovs[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+        int sent = sendmmsg(fd_, messages, static_cast<unsigned int>(group), MSG_NOSIGNAL);
+        if (sent > 0) {
+            next += static_cast<size_t>(sent);
+        } else if (sent < 0 && errno == EINTR) {
+            continue;
+        } else if (sent < 0 && errno == EMSGSIZE) {
+            // 单条报文超过套接字上限：只丢弃这一条
+            send_failures_.fetch_add(1, std::memory_order_relaxed);
+            ++next;
+        } else {
+            break;
+        }
+    }
+    return next;
+}
+#endif
+
+// 构造函数
+SinkChannel::SinkChannel(std::shared_ptr<LogSink> sink, bool dedicated_thread, size_t queue_capacity)
+    : sink_(std::move(sink)),
+      name_(sink_->name()),
+      dedicated_(dedicated_thread),
+      capacity_(queue_capacity > 0 ? queue_capacity : 1) {
+    if (dedicated_) {
+        thread_ = std::thread(&SinkChannel::run, this);
+    }
+}
+
+// 析构函数
+SinkChannel::~SinkChannel() {
+    stop();
+}
+
+// 提交本段日志：整段只加锁一次
+void SinkChannel::commit(const std::shared_ptr<const LogSinkBatch>& batch) {
+    size_t count = batch ? batch->entries.size() : 0;
+    if (dedicated_ && count == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!dedicated_) {
+        // 直接调用模式同样持锁，移除通道的线程可以安全地做最后一次flush
+        if (!stopping_) {
+            if (count > 0) {
+                writeBatch(*batch, count);
+            }
+            flushTimed();
+        }
+        return;
+    }
+    // 队列剩余容量只够放下批次前一部分时，只写出这一部分，其余计为丢弃
+    size_t accepted = stopping_ ? 0 : std::min(count, capacity_ - std::min(capacity_, queued_messages_));
+    if (accepted < count) {
+        dropped_.fetch_add(count - accepted, std::memory_order_relaxed);
+    }
+    if (accepted == 0) {
+        return;
+    }
+    queue_.emplace_back(batch, accepted);
+    queued_messages_ += accepted;
+    if (queue_.size() == 1) {
+        cv_.notify_one();
+    }
+}
+
+// 停止独立线程
+void SinkChannel::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!dedicated_ && !stopping_) {
+            flushTimed();
+        }
+        stopping_ = true;
+        cv_.notify_one();
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+// 获取统计信息
+LogSinkStats SinkChannel::stats() const {
+    LogSinkStats stats;
+    stats.name = name_;
+    stats.dedicated_thread = dedicated_;
+    stats.messages = messages_.load(std::memory_order_relaxed);
+    stats.bytes_written = bytes_.load(std::memory_order_relaxed);
+    stats.dropped = dropped_.load(std::memory_order_relaxed);
+    stats.total_write_ns = total_write_ns_.load(std::memory_order_relaxed);
+    stats.max_write_ns = max_write_ns_.load(std::memory_order_relaxed);
+    stats.write_latency = write_histogram_.summary();
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.queue_size = queued_messages_;
+    return stats;
+}
+
+// 重置统计信息
+void SinkChannel::resetStats() {
+    messages_.store(0, std::memory_order_relaxed);
+    bytes_.store(0, std::memory_order_relaxed);
+    dropped_.store(0, std::memory_order_relaxed);
+    total_write_ns_.store(0, std::memory_order_relaxed);
+    max_write_ns_.store(0, std::memory_order_relaxed);
+    write_histogram_.reset();
+}
+
+// 独立线程主循环：整批取出后逐条写入，每批flush一次
+void SinkChannel::run() {
+    std::vector<std::pair<std::shared_ptr<const LogSinkBatch>, size_t>> batches;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cv_.wait(lock, [this] { return !queue_.empty() || stopping_; });
+        if (queue_.empty()) {
+            break;
+        }
+        batches.swap(queue_);
+        queued_messages_ = 0;
+        lock.unlock();
+        for (const std::pair<std::shared_ptr<const LogSinkBatch>, size_t>& batch : batches) {
+            writeBatch(*batch.first, batch.second);
+        }
+        flushTimed();
+        batches.clear();
+        lock.lock();
+    }
+}
+
+// 逐条调用输出目标并统计耗时
+void SinkChannel::writeBatch(const LogSinkBatch& batch, size_t count) {
+    uint64_t bytes = 0;
+    for (size_t i = 0; i < count; ++i) {
+        LogSinkMessage message = batch.message(i);
+        uint64_t start = steadyNanos();
+        sink_->write(message);
+        recordLatency(steadyNanos() - start);
+        bytes += message.text.size() + 1;
+    }
+    messages_.fetch_add(count, std::memory_order_relaxed);
+    bytes_.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+// flush输出目标并统计耗时
+void SinkChannel::flushTimed() {
+    uint64_t start = steadyNanos();
+    sink_->flush();
+    recordLatency(steadyNanos() - start);
+}
+
+// 累计写入耗时（统计只由一个线程更新）
+void SinkChannel::recordLatency(uint64_t ns) {
+    total_write_ns_.fetch_add(ns, std::memory_order_relaxed);
+    if (ns > max_write_ns_.load(std::memory_order_relaxed)) {
+        max_write_ns_.store(ns, std::memory_order_relaxed);
+    }
+    write_histogram_.record(ns);
+}
+
+} // namespace log
+} // namespace yalgo
@@ -0,0 +1,344 @@
+/**
+ * @file log_sink.h
+ * @brief 日志输出目标接口与内置实现
+ * @author yAlgo Team
+ * @date 2026-10-16
+ * @version 1.0.0
+ *
+ * 写入线程把格式化后的日志分发给各输出目标。慢速目标（控制台、系统日志等）
+ * 各自拥有有界队列和线程，某个目标跟不上时只会在它自己的队列中丢弃日志，
+ * 不影响文件和其他目标。
+ */
+
+#ifndef YALGO_SDK_LOG_LOG_SINK_H
+#define YALGO_SDK_LOG_LOG_SINK_H
+
+#include "log_exports.h"
+#include "file_sink.h"
+#include "log_stats.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace yalgo {
+namespace log {
+
+enum class LogLevel;
+enum class LogFileSinkType;
+
+/**
+ * @brief 分发给输出目标的一条日志
+ */
+struct LogSinkMessage {
+    LogLevel level{};          ///< 日志级别
+    uint64_t timestamp_us = 0; ///< 产生时间（Unix纪元微秒）
+    std::string_view text;     ///< "[时间] [级别] 正文"，不含换行符（指向批次缓冲，只在write调用期间有效）
+};
+
+/**
+ * @brief 写入线程一段日志的批次，写完后只读，由各输出目标通道共享
+ *
+ * @details 各条正文首尾相连存放在一块缓冲中，分发时只传递共享指针，
+ * 不按条、也不按输出目标复制正文。
+ */
+struct LogSinkBatch {
+    /**
+     * @brief 批次中的一条日志
+     */
+    struct Entry {
+        LogLevel level{};          ///< 日志级别
+        uint64_t timestamp_us = 0; ///< 产生时间（Unix纪元微秒）
+        size_t offset = 0;         ///< 正文在text中的起始位置
+        size_t length = 0;         ///< 正文字节数
+    };
+
+    std::string text;           ///< 各条正文（不含换行符）
+    std::vector<Entry> entries; ///< 各条日志
+
+    /**
+     * @brief 追加一条日志
+     */
+    void add(LogLevel level, uint64_t timestamp_us, const std::string& line) {
+        entries.push_back(Entry{level, timestamp_us, text.size(), line.size()});
+        text += line;
+    }
+
+    /**
+     * @brief 第index条日志（正文指向text）
+     */
+    LogSinkMessage message(size_t index) const {
+        const Entry& entry = entries[index];
+        LogSinkMessage result;
+        result.level = entry.level;
+        result.timestamp_us = entry.timestamp_us;
+        result.text = std::string_view(text.data() + entry.offset, entry.length);
+        return result;
+    }
+
+    /**
+     * @brief 清空（保留已分配的容量）
+     */
+    void clear() {
+        text.clear();
+        entries.clear();
+    }
+};
+
+/**
+ * @brief 单个输出目标的统计信息
+ */
+struct LogSinkStats {
+    std::string name;             ///< 输出目标名称
+    bool dedicated_thread = false;///< 是否使用独立线程
+    uint64_t messages = 0;        ///< 已写出的日志数
+    uint64_t bytes_written = 0;   ///< 已写出的字节数（含换行符）
+    uint64_t dropped = 0;         ///< 队列已满丢弃的日志数
+    uint64_t total_write_ns = 0;  ///< 总写入耗时（纳秒，含flush）
+    uint64_t max_write_ns = 0;    ///< 单次写入或flush的最大耗时（纳秒）
+    LogLatencyStats write_latency;///< 单次写入或flush耗时分布（纳秒）
+    size_t queue_size = 0;        ///< 当前排队条数
+};
+
+/**
+ * @brief 日志输出目标接口
+ *
+ * @details write与flush只会被同一个线程调用（写入线程或该目标的独立线程），
+ * 实现无需加锁。write可以只写入内部缓冲，由flush统一写出；写入线程每写出
+ * 一段日志、独立线程每取出一批日志后调用一次flush。
+ */
+class LOG_API LogSink {
+public:
+    /**
+     * @brief 析构函数
+     */
+    virtual ~LogSink() {}
+
+    /**
+     * @brief 输出目标名称（用于统计）
+     */
+    virtual std::string name() const = 0;
+
+    /**
+     * @brief 写出一条日志
+     * @param message 日志
+     */
+    virtual void write(const LogSinkMessage& message) = 0;
+
+    /**
+     * @brief 写出内部缓冲
+     */
+    virtual void flush() {}
+};
+
+/**
+ * @brief 控制台输出，按批写入stdout
+ */
+class LOG_API ConsoleSink : public LogSink {
+public:
+    /**
+     * @brief 构造函数
+     * @param color 是否按级别输出ANSI颜色
+     */
+    explicit ConsoleSink(bool color = true);
+
+    std::string name() const override { return "console"; }
+    void write(const LogSinkMessage& message) override;
+    void flush() override;
+
+private:
+    bool color_;         ///< 是否输出颜色
+    std::string buffer_; ///< 待写出的文本
+};
+
+/**
+ * @brief 文本文件输出（不轮转）
+ *
+ * @details 用于在主日志文件之外追加输出到其他文件；轮转、二进制格式与历史文件
+ * 压缩仍由LogConfig配置的主日志文件负责。
+ */
+class LOG_API FileLogSink : public LogSink {
+public:
+    /**
+     * @brief 构造并打开文件
+     * @param path 文件路径
+     * @param type 输出方式（BUFFERED为writev批量写出，MMAP为内存映射）
+     */
+    FileLogSink(const std::string& path, LogFileSinkType type);
+
+    std::string name() const override { return "file:" + file_->path(); }
+    void write(const LogSinkMessage& message) override;
+    void flush() override;
+
+    /**
+     * @brief 文件是否已打开
+     */
+    bool isOpen() const { return file_->isOpen(); }
+
+private:
+    std::unique_ptr<FileSink> file_; ///< 文件输出
+};
+
+/**
+ * @brief 系统日志输出（Linux syslog / Windows事件日志）
+ *
+ * @details Linux上保持一个到syslog套接字（默认/dev/log）的数据报连接，
+ * write按RFC 3164格式把日志追加到内部缓冲，flush用sendmmsg一次发出整批；
+ * 发送失败时关闭连接，重新连接一次后重发，仍失败则丢弃本批并计数，
+ * 下次flush时再尝试连接。
+ */
+class LOG_API SyslogSink : public LogSink {
+public:
+    /**
+     * @brief 构造函数（连接在首次flush时建立）
+     * @param ident 系统日志标识
+     * @param socket_path syslog数据报套接字路径（仅Linux）
+     */
+    explicit SyslogSink(const std::string& ident, const std::string& socket_path = "/dev/log");
+
+    /**
+     * @brief 析构函数，发出缓冲中的日志并关闭连接
+     */
+    ~SyslogSink() override;
+
+    std::string name() const override { return "syslog"; }
+    void write(const LogSinkMessage& message) override;
+    void flush() override;
+
+    /**
+     * @brief 因连接失败或发送出错而丢弃的日志数
+     */
+    uint64_t sendFailures() const { return send_failures_.load(std::memory_order_relaxed); }
+
+private:
+    /**
+     * @brief 连接syslog套接字
+     * @return 是否连接成功
+     */
+    bool connectSocket();
+
+    /**
+     * @brief 关闭连接
+     */
+    void closeSocket();
+
+    /**
+     * @brief 从第first条开始发送缓冲中的日志
+     * @param first 起始下标
+     * @return 成功发出的条数（从first算起）
+     */
+    size_t sendPending(size_t first);
+
+    std::string ident_;                     ///< 系统日志标识
+    std::string socket_path_;               ///< syslog套接字路径
+    int fd_ = -1;                           ///< 数据报套接字（-1表示未连接）
+    int pid_ = 0;                           ///< 进程号
+    int64_t cached_second_ = -1;            ///< 时间前缀缓存对应的秒
+    char cached_time_[16] = {};             ///< "Mmm dd hh:mm:ss"
+    std::string buffer_;                    ///< 待发送的报文（首尾相连）
+    std::vector<size_t> offsets_;           ///< 各报文在buffer_中的结束位置
+    std::atomic<uint64_t> send_failures_{0};///< 丢弃的日志数
+};
+
+/**
+ * @brief 输出目标通道：在写入线程上直接调用，或经有界队列交给独立线程
+ *
+ * @details 由AsyncLogger内部使用。写入线程每段日志提交一个共享批次：直接调用模式
+ * 持锁一次写完整批，独立线程模式持锁一次把批次指针放入队列。队列按条计容量，
+ * 满时丢弃新日志并计数，不阻塞写入线程。
+ */
+class LOG_API SinkChannel {
+public:
+    /**
+     * @brief 构造函数
+     * @param sink 输出目标
+     * @param dedicated_thread 是否使用独立线程
+     * @param queue_capacity 独立线程模式的队列容量（条）
+     */
+    SinkChannel(std::shared_ptr<LogSink> sink, bool dedicated_thread, size_t queue_capacity);
+
+    /**
+     * @brief 析构函数，写完队列中的日志后退出线程
+     */
+    ~SinkChannel();
+
+    SinkChannel(const SinkChannel&) = delete;
+    SinkChannel& operator=(const SinkChannel&) = delete;
+
+    /**
+     * @brief 写入线程每写出一段日志后调用一次：提交本段批次
+     *
+     * @details 直接调用模式持锁写出整批并flush；独立线程模式持锁把批次指针
+     * 放入队列，由通道线程写出。整段只加锁一次，不复制正文。
+     * @param batch 共享批次（提交后不再修改，可为空）
+     */
+    void commit(const std::shared_ptr<const LogSinkBatch>& batch);
+
+    /**
+     * @brief 写完队列中的日志并退出线程（可重复调用）
+     */
+    void stop();
+
+    /**
+     * @brief 获取统计信息
+     */
+    LogSinkStats stats() const;
+
+    /**
+     * @brief 重置统计信息
+     */
+    void resetStats();
+
+    const std::shared_ptr<LogSink>& sink() const { return sink_; }
+
+private:
+    /**
+     * @brief 独立线程主循环
+     */
+    void run();
+
+    /**
+     * @brief 调用输出目标写出批次的前count条并统计耗时
+     */
+    void writeBatch(const LogSinkBatch& batch, size_t count);
+
+    /**
+     * @brief flush输出目标并统计耗时
+     */
+    void flushTimed();
+
+    /**
+     * @brief 累计一次写入耗时
+     */
+    void recordLatency(uint64_t ns);
+
+    std::shared_ptr<LogSink> sink_;           ///< 输出目标
+    std::string name_;                        ///< 输出目标名称
+    bool dedicated_;                          ///< 是否使用独立线程
+    size_t capacity_;                         ///< 队列容量（条）
+    mutable std::mutex mutex_;                ///< 队列互斥锁
+    std::condition_variable cv_;              ///< 队列条件变量
+    std::vector<std::pair<std::shared_ptr<const LogSinkBatch>, size_t>> queue_; ///< 待写出的批次及各自写出的条数
+    size_t queued_messages_ = 0;              ///< 队列中的日志条数
+    bool stopping_ = false;                   ///< 退出标志
+    std::thread thread_;                      ///< 独立线程
+    std::atomic<uint64_t> messages_{0};       ///< 统计：已写出的日志数
+    std::atomic<uint64_t> bytes_{0};          ///< 统计：已写出的字节数
+    std::atomic<uint64_t> dropped_{0};        ///< 统计：丢弃的日志数
+    std::atomic<uint64_t> total_write_ns_{0}; ///< 统计：总写入耗时
+    std::atomic<uint64_t> max_write_ns_{0};   ///< 统计：最大写入耗时
+    LatencyHistogram write_histogram_;        ///< 统计：写入耗时分布
+};
+
+} // namespace log
+} // namespace yalgo
+
+#endif // YALGO_SDK_LOG_LOG_SINK_H
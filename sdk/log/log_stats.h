@@ -0,0 +1,271 @@
+/**
+ * @file log_stats.h
+ * @brief 无锁统计计数器与对数分桶时延直方图
+ * @author yAlgo Team
+ * @date 2026-10-16
+ * @version 1.0.0
+ *
+ * 调用线程更新的计数器按线程分片，每个分片独占缓存行，读取时汇总；
+ * 时延直方图按HDR方式分桶：每个2的幂区间再等分为16个子桶，
+ * 相对误差不超过1/16，记录一次只做一次relaxed原子加。
+ */
+
+#ifndef YALGO_SDK_LOG_LOG_STATS_H
+#define YALGO_SDK_LOG_LOG_STATS_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace yalgo {
+namespace log {
+
+/**
+ * @brief 时延分布摘要（单位由所在字段说明）
+ */
+struct LogLatencyStats {
+    uint64_t count = 0; ///< 样本数
+    uint64_t p50 = 0;   ///< 中位数
+    uint64_t p99 = 0;   ///< 99分位
+    uint64_t p999 = 0;  ///< 99.9分位
+    uint64_t max = 0;   ///< 最大值
+};
+
+/**
+ * @brief 当前线程的统计分片号（线程首次使用时轮流分配）
+ */
+inline size_t statsShardIndex() {
+    static std::atomic<size_t> next_shard{0};
+    thread_local size_t shard = next_shard.fetch_add(1, std::memory_order_relaxed);
+    return shard;
+}
+
+/**
+ * @brief 按线程分片的计数器
+ *
+ * @details 多个调用线程同时累加时各自写自己的缓存行，不互相争用；
+ * 读取时汇总全部分片，结果不是某一时刻的精确快照。
+ */
+class ShardedCounter {
+public:
+    static constexpr size_t SHARD_COUNT = 16; ///< 分片数
+
+    /**
+     * @brief 累加
+     * @param delta 增量
+     */
+    void add(uint64_t delta = 1) {
+        shards_[statsShardIndex() % SHARD_COUNT].value.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 读取全部分片之和
+     */
+    uint64_t load() const {
+        uint64_t sum = 0;
+        for (const Shard& shard : shards_) {
+            sum += shard.value.load(std::memory_order_relaxed);
+        }
+        return sum;
+    }
+
+    /**
+     * @brief 清零
+     */
+    void reset() {
+        for (Shard& shard : shards_) {
+            shard.value.store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> value{0};
+    };
+
+    Shard shards_[SHARD_COUNT];
+};
+
+/**
+ * @brief 对数分桶时延直方图
+ *
+ * @details 小于16的值各占一个桶，之后每个2的幂区间等分为16个桶；
+ * 超过2^40的值计入最后一个桶。分位数取所在桶的上界（不超过记录到的最大值）。
+ * record可由多个线程并发调用。
+ */
+class LatencyHistogram {
+public:
+    static constexpr unsigned SUB_BUCKET_BITS = 4;                         ///< 每个2的幂区间的子桶位数
+    static constexpr size_t SUB_BUCKET_COUNT = size_t(1) << SUB_BUCKET_BITS; ///< 每个区间的子桶数
+    static constexpr unsigned MAX_VALUE_BITS = 40;                         ///< 可区分的最大值位数
+    static constexpr size_t BUCKET_COUNT =
+        (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;         ///< 桶数
+
+    /**
+     * @brief 记录一个样本
+     * @param value 样本值
+     */
+    void record(uint64_t value) {
+        counts_[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+        uint64_t prev = max_.load(std::memory_order_relaxed);
+        while (value > prev && !max_.compare_exchange_weak(prev, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @brief 把各桶计数累加到counts（长度BUCKET_COUNT），并更新最大值
+     */
+    void mergeInto(std::vector<uint64_t>& counts, uint64_t& max) const {
+        counts.resize(BUCKET_COUNT, 0);
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            counts[i] += counts_[i].load(std::memory_order_relaxed);
+        }
+        max = std::max(max, max_.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief 计算分布摘要
+     */
+    LogLatencyStats summary() const {
+        std::vector<uint64_t> counts;
+        uint64_t max = 0;
+        mergeInto(counts, max);
+        return summarize(counts, max);
+    }
+
+    /**
+     * @brief 清零
+     */
+    void reset() {
+        for (std::atomic<uint64_t>& count : counts_) {
+            count.store(0, std::memory_order_relaxed);
+        }
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 由各桶计数计算分布摘要
+     * @param counts 各桶计数（长度BUCKET_COUNT）
+     * @param max 记录到的最大值
+     */
+    static LogLatencyStats summarize(const std::vector<uint64_t>& counts, uint64_t max) {
+        LogLatencyStats stats;
+        for (uint64_t count : counts) {
+            stats.count += count;
+        }
+        if (stats.count == 0) {
+            return stats;
+        }
+        stats.max = max;
+        // 第k个样本（k从1开始）所在桶的上界
+        const uint64_t ranks[3] = {
+            (stats.count * 500 + 999) / 1000,
+            (stats.count * 990 + 999) / 1000,
+            (stats.count * 999 + 999) / 1000};
+        uint64_t* outputs[3] = {&stats.p50, &stats.p99, &stats.p999};
+        uint64_t seen = 0;
+        size_t next = 0;
+        for (size_t i = 0; i < counts.size() && next < 3; ++i) {
+            seen += counts[i];
+            while (next < 3 && seen >= ranks[next]) {
+                *outputs[next++] = std::min(bucketUpperBound(i), max);
+            }
+        }
+        return stats;
+    }
+
+    /**
+     * @brief 样本值所在的桶
+     */
+    static size_t bucketIndex(uint64_t value) {
+        if (value < SUB_BUCKET_COUNT) {
+            return static_cast<size_t>(value);
+        }
+        unsigned msb = highestBit(value);
+        if (msb >= MAX_VALUE_BITS) {
+            return BUCKET_COUNT - 1;
+        }
+        unsigned shift = msb - SUB_BUCKET_BITS;
+        return (shift + 1) * SUB_BUCKET_COUNT +
+               static_cast<size_t>((value >> shift) & (SUB_BUCKET_COUNT - 1));
+    }
+
+    /**
+     * @brief 桶内最大值
+     */
+    static uint64_t bucketUpperBound(size_t index) {
+        if (index < SUB_BUCKET_COUNT) {
+            return index;
+        }
+        unsigned shift = static_cast<unsigned>(index / SUB_BUCKET_COUNT) - 1;
+        uint64_t lower = (SUB_BUCKET_COUNT + index % SUB_BUCKET_COUNT) << shift;
+        return lower + (uint64_t(1) << shift) - 1;
+    }
+
+private:
+    // 最高置位位号（value非0）
+    static unsigned highestBit(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#else
+        unsigned bit = 0;
+        while (value >>= 1) {
+            ++bit;
+        }
+        return bit;
+#endif
+    }
+
+    std::atomic<uint64_t> counts_[BUCKET_COUNT] = {}; ///< 各桶计数
+    std::atomic<uint64_t> max_{0};                    ///< 最大值
+};
+
+/**
+ * @brief 按线程分片的时延直方图，供多个调用线程同时记录
+ */
+class ShardedLatencyHistogram {
+public:
+    static constexpr size_t SHARD_COUNT = 8; ///< 分片数
+
+    /**
+     * @brief 记录一个样本
+     */
+    void record(uint64_t value) {
+        shards_[statsShardIndex() % SHARD_COUNT].histogram.record(value);
+    }
+
+    /**
+     * @brief 汇总全部分片计算分布摘要
+     */
+    LogLatencyStats summary() const {
+        std::vector<uint64_t> counts;
+        uint64_t max = 0;
+        for (const Shard& shard : shards_) {
+            shard.histogram.mergeInto(counts, max);
+        }
+        return LatencyHistogram::summarize(counts, max);
+    }
+
+    /**
+     * @brief 清零
+     */
+    void reset() {
+        for (Shard& shard : shards_) {
+            shard.histogram.reset();
+        }
+    }
+
+private:
+    struct alignas(64) Shard {
+        LatencyHistogram histogram;
+    };
+
+    Shard shards_[SHARD_COUNT];
+};
+
+} // namespace log
+} // namespace yalgo
+
+#endif // YALGO_SDK_LOG_LOG_STATS_H
@@ -6,12 +6,20 @@
  * @version 1.0.0
  *
  * 高性能异步日志模块，提供以下特性：
- * 1. 编译期+运行时双层日志级别控制
+ * 1. 编译期+运行时双层日志级别控制（运行时关闭的级别不求值参数）
  * 2. 自动打印文件名、行号、函数名
- * 3. 异步日志写入，不阻塞主线程
- * 4. 多输出支持（控制台+文件+系统日志）
- * 5. 日志文件自动轮转
- * 6. 模块/关键词过滤
+ * 3. 异步日志写入，队列容量不足时按级别丢弃、采样或限时阻塞（错误日志不丢失）
+ * 4. 多输出支持（控制台+文件+系统日志+自定义LogSink），慢速输出目标各自独立线程与有界队列
+ * 5. 日志文件自动轮转（可选后台压缩历史文件）
+ * 6. 按模块设置运行时级别（编译期模块编号 + 原子级别表）与关键词包含/排除过滤
+ * 7. 二进制延迟格式化日志（YLOG_BIN_*）
+ * 8. 按调用点限频与采样（YLOG_*_EVERY_N / YLOG_*_EVERY_MS / YLOG_*_SAMPLED）
+ * 9. 结构化键值日志（YLOG_*_KV），写入线程直接编码为JSON或logfmt
+ * 10. 无锁性能统计：分片计数器与对数分桶时延直方图（提交耗时、排队时延、输出目标写入耗时的p50/p99/p999）
+ * 11. 编译期检查的{}风格格式化日志（YLOG_*_FMT），占位符与参数个数不一致时编译失败
+ * 12. 命名日志器（AsyncLogger::createLogger + YLOG_LOGGER_*），各自拥有队列、写入线程、输出目标与配置
+ * 13. 写入线程绑核、nice值、NUMA本地环形队列与先自旋再阻塞的等待方式
+ * 14. 崩溃处理（LogConfig::crash_handler）：致命信号与std::terminate时写出队列中的日志并追加调用栈
  */
 
 #ifndef YALGO_LOG_LOGGER_H
@@ -19,5 +27,14 @@
 
 #include "version.h"
 #include "async_logger.h"
+#include "binary_log.h"
+#include "crash_handler.h"
+#include "rate_limit.h"
+#include "keyword_filter.h"
+#include "log_format.h"
+#include "log_sink.h"
+#include "log_stats.h"
+#include "segment_compressor.h"
+#include "structured_log.h"
 
 #endif // YALGO_LOG_LOGGER_H
\ No newline at end of file
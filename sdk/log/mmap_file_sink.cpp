@@ -0,0 +1,306 @@
+/**
+ * @file mmap_file_sink.cpp
+ * @brief 基于内存映射与预分配的日志文件输出实现
+ * @author yAlgo Team
+ * @date 2026-10-16
+ * @version 1.0.0
+ */
+
+#include "mmap_file_sink.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace yalgo {
+namespace log {
+
+namespace {
+
+const size_t kPageSize = 4096;
+
+size_t roundUpToPage(size_t size) {
+    return (size + kPageSize - 1) / kPageSize * kPageSize;
+}
+
+// 查找最后一个非零字节之后的位置，即崩溃遗留的零填充尾部的起点
+size_t findDataEnd(const char* data, size_t size) {
+    size_t end = size;
+    while (end >= sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, data + end - sizeof(word), sizeof(word));
+        if (word != 0) {
+            break;
+        }
+        end -= sizeof(word);
+    }
+    while (end > 0 && data[end - 1] == 0) {
+        --end;
+    }
+    return end;
+}
+
+#ifndef _WIN32
+// 预分配[offset, offset + length)，不支持fallocate的文件系统退化为ftruncate
+bool preallocate(int fd, size_t offset, size_t length) {
+#ifdef __linux__
+    if (fallocate(fd, 0, static_cast<off_t>(offset), static_cast<off_t>(length)) == 0) {
+        return true;
+    }
+#endif
+    return ftruncate(fd, static_cast<off_t>(offset + length)) == 0;
+}
+#else
+// 设置文件长度
+bool resizeFile(HANDLE file, size_t size) {
+    LARGE_INTEGER pos;
+    pos.QuadPart = static_cast<LONGLONG>(size);
+    return SetFilePointerEx(file, pos, NULL, FILE_BEGIN) && SetEndOfFile(file);
+}
+#endif
+
+} // namespace
+
+// 构造函数
+MmapFileSink::MmapFileSink(size_t segment_size)
+    : segment_size_(roundUpToPage(std::max<size_t>(segment_size, kPageSize))),
+      data_(nullptr),
+      capacity_(0),
+      cursor_(0),
+      spare_ready_(false),
+#ifdef _WIN32
+      file_(INVALID_HANDLE_VALUE),
+      mapping_(NULL) {}
+#else
+      fd_(-1) {}
+#endif
+
+// 析构函数
+MmapFileSink::~MmapFileSink() {
+    close();
+}
+
+// 打开文件
+bool MmapFileSink::open(const std::string& path) {
+    close();
+    path_ = path;
+    if (!mapFile(path, false)) {
+        return false;
+    }
+    prepareSpare();
+    return true;
+}
+
+// 关闭文件
+void MmapFileSink::close() {
+    unmapFile();
+    if (spare_ready_) {
+        std::remove(spareName().c_str());
+        spare_ready_ = false;
+    }
+}
+
+// 追加数据
+void MmapFileSink::append(const char* data, size_t size) {
+    if (!data_ || !reserve(cursor_ + size)) {
+        return;
+    }
+    std::memcpy(data_ + cursor_, data, size);
+    cursor_ += size;
+}
+
+// 崩溃时在已映射空间内追加
+bool MmapFileSink::appendOnCrash(const char* data, size_t size) {
+    if (!data_ || cursor_ + size > capacity_) {
+        return false;
+    }
+    std::memcpy(data_ + cursor_, data, size);
+    cursor_ += size;
+    return true;
+}
+
+// 轮转
+bool MmapFileSink::rotate(const std::string& backup_path) {
+    unmapFile();
+    std::rename(path_.c_str(), backup_path.c_str());
+
+    // 备用段已预分配好时直接改名映射，否则就地新建
+    bool fresh = spare_ready_ && std::rename(spareName().c_str(), path_.c_str()) == 0;
+    spare_ready_ = false;
+    if (!mapFile(path_, fresh)) {
+        return false;
+    }
+    prepareSpare();
+    return true;
+}
+
+// 设置写游标
+void MmapFileSink::setCursor(size_t cursor) {
+    cursor_ = std::min(cursor, capacity_);
+}
+
+// 打开并映射文件
+bool MmapFileSink::mapFile(const std::string& path, bool fresh) {
+    size_t file_size = 0;
+#ifdef _WIN32
+    file_ = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+                        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                        NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file_ == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (GetFileSizeEx(file_, &size)) {
+        file_size = static_cast<size_t>(size.QuadPart);
+    }
+#else
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd_, &st) == 0) {
+        file_size = static_cast<size_t>(st.st_size);
+    }
+#endif
+
+    capacity_ = 0;
+    cursor_ = 0;
+    if (file_size > 0 && !reserve(file_size)) {
+        unmapFile(false);
+        return false;
+    }
+    if (!fresh && data_) {
+        cursor_ = findDataEnd(data_, capacity_);
+    }
+    // 保证打开后至少还有一段可写空间
+    if (!reserve(std::max(cursor_ + segment_size_, capacity_))) {
+        unmapFile(false);
+        return false;
+    }
+    return true;
+}
+
+// 解除映射并截断
+void MmapFileSink::unmapFile(bool truncate) {
+#ifdef _WIN32
+    if (data_) {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_) {
+        CloseHandle(mapping_);
+        mapping_ = NULL;
+    }
+    if (file_ != INVALID_HANDLE_VALUE) {
+        if (truncate) {
+            resizeFile(file_, cursor_);
+        }
+        CloseHandle(file_);
+        file_ = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (data_) {
+        munmap(data_, capacity_);
+    }
+    if (fd_ >= 0) {
+        if (truncate && ftruncate(fd_, static_cast<off_t>(cursor_)) != 0) {
+            // 截断失败时保留零填充尾部，下次打开时会跳过
+        }
+        ::close(fd_);
+        fd_ = -1;
+    }
+#endif
+    data_ = nullptr;
+    capacity_ = 0;
+    cursor_ = 0;
+}
+
+// 扩展映射区
+bool MmapFileSink::reserve(size_t needed) {
+    if (needed <= capacity_ && data_) {
+        return true;
+    }
+    size_t new_capacity = roundUpToPage(std::max(needed, capacity_ + segment_size_));
+    if (capacity_ == 0) {
+        new_capacity = roundUpToPage(needed);
+    }
+
+#ifdef _WIN32
+    if (file_ == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    if (data_) {
+        UnmapViewOfFile(data_);
+        data_ = nullptr;
+    }
+    if (mapping_) {
+        CloseHandle(mapping_);
+        mapping_ = NULL;
+    }
+    LARGE_INTEGER size;
+    size.QuadPart = static_cast<LONGLONG>(new_capacity);
+    mapping_ = CreateFileMappingA(file_, NULL, PAGE_READWRITE,
+                                  static_cast<DWORD>(size.HighPart), size.LowPart, NULL);
+    if (!mapping_) {
+        capacity_ = 0;
+        return false;
+    }
+    data_ = static_cast<char*>(MapViewOfFile(mapping_, FILE_MAP_WRITE, 0, 0, new_capacity));
+#else
+    if (fd_ < 0) {
+        return false;
+    }
+    if (data_) {
+        munmap(data_, capacity_);
+        data_ = nullptr;
+    }
+    struct stat st;
+    size_t file_size = (fstat(fd_, &st) == 0) ? static_cast<size_t>(st.st_size) : 0;
+    if (new_capacity > file_size && !preallocate(fd_, file_size, new_capacity - file_size)) {
+        capacity_ = 0;
+        return false;
+    }
+    void* addr = mmap(nullptr, new_capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    data_ = (addr == MAP_FAILED) ? nullptr : static_cast<char*>(addr);
+#endif
+
+    capacity_ = data_ ? new_capacity : 0;
+    return data_ != nullptr;
+}
+
+// 预分配备用段
+void MmapFileSink::prepareSpare() {
+    if (spare_ready_) {
+        return;
+    }
+    std::string spare = spareName();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(spare.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS,
+                              FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return;
+    }
+    spare_ready_ = resizeFile(file, segment_size_);
+    CloseHandle(file);
+#else
+    int fd = ::open(spare.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return;
+    }
+    spare_ready_ = preallocate(fd, 0, segment_size_);
+    ::close(fd);
+#endif
+    if (!spare_ready_) {
+        std::remove(spare.c_str());
+    }
+}
+
+} // namespace log
+} // namespace yalgo
@@ -0,0 +1,125 @@
+/**
+ * @file mmap_file_sink.h
+ * @brief 基于内存映射与预分配的日志文件输出
+ * @author yAlgo Team
+ * @date 2026-10-16
+ * @version 1.0.0
+ */
+
+#ifndef YALGO_SDK_LOG_MMAP_FILE_SINK_H
+#define YALGO_SDK_LOG_MMAP_FILE_SINK_H
+
+#include "file_sink.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace yalgo {
+namespace log {
+
+/**
+ * @brief 基于内存映射与预分配的日志文件输出
+ *
+ * @details 文件按段预分配（Linux上使用fallocate）并以共享方式映射，日志直接memcpy到
+ * 映射区并推进写游标，不经过write系统调用。数据写入即进入内核页缓存，进程崩溃后
+ * 仍会落盘。正常关闭时文件截断到实际长度；崩溃遗留的零填充尾部在下次打开时识别，
+ * 从数据末尾继续写入。
+ *
+ * 轮转时当前文件截断、改名，然后直接映射事先预分配好的备用段（路径+".next"），
+ * 随后再预分配下一个备用段。
+ */
+class LOG_API MmapFileSink : public FileSink {
+public:
+    /**
+     * @brief 构造函数
+     * @param segment_size 每次预分配的字节数
+     */
+    explicit MmapFileSink(size_t segment_size = 64 * 1024 * 1024);
+
+    /**
+     * @brief 析构函数，截断到实际长度并关闭文件
+     */
+    ~MmapFileSink() override;
+
+    MmapFileSink(const MmapFileSink&) = delete;
+    MmapFileSink& operator=(const MmapFileSink&) = delete;
+
+    bool open(const std::string& path) override;
+    void close() override;
+    bool isOpen() const override { return data_ != nullptr; }
+    void append(const char* data, size_t size) override;
+
+    /**
+     * @brief 数据已在页缓存中，无需写出
+     */
+    bool flush() override { return true; }
+
+    size_t pendingBytes() const override { return 0; }
+    uint64_t size() const override { return cursor_; }
+    bool rotate(const std::string& backup_path) override;
+
+    /**
+     * @brief 在已映射的空间内直接拷贝（不扩展映射，空间不足时返回false）
+     */
+    bool appendOnCrash(const char* data, size_t size) override;
+
+    /**
+     * @brief 映射区起始地址（用于打开已有文件时校正写游标）
+     */
+    const char* data() const { return data_; }
+
+    /**
+     * @brief 映射区大小（含预分配部分）
+     */
+    size_t capacity() const { return capacity_; }
+
+    /**
+     * @brief 设置写游标
+     * @param cursor 新的写位置，不超过capacity()
+     */
+    void setCursor(size_t cursor);
+
+private:
+    /**
+     * @brief 打开并映射文件
+     * @param path 文件路径
+     * @param fresh 是否为刚预分配的空段（跳过数据末尾扫描）
+     */
+    bool mapFile(const std::string& path, bool fresh);
+
+    /**
+     * @brief 解除映射并关闭文件
+     * @param truncate 是否把文件截断到写游标
+     */
+    void unmapFile(bool truncate = true);
+
+    /**
+     * @brief 确保映射区至少needed字节，不足时按段扩展并重新映射
+     */
+    bool reserve(size_t needed);
+
+    /**
+     * @brief 预分配备用段
+     */
+    void prepareSpare();
+
+    std::string spareName() const { return path_ + ".next"; }
+
+    size_t segment_size_; ///< 每次预分配的字节数
+    char* data_;          ///< 映射区起始地址
+    size_t capacity_;     ///< 映射区大小
+    size_t cursor_;       ///< 写游标
+    bool spare_ready_;    ///< 备用段是否已预分配
+#ifdef _WIN32
+    HANDLE file_;         ///< 文件句柄
+    HANDLE mapping_;      ///< 映射对象句柄
+#else
+    int fd_;              ///< 文件描述符
+#endif
+};
+
+} // namespace log
+} // namespace yalgo
+
+#endif // YALGO_SDK_LOG_MMAP_FILE_SINK_H
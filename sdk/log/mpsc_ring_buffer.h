@@ -0,0 +1,174 @@
+/**
+ * @file mpsc_ring_buffer.h
+ * @brief 有界无锁多生产者/单消费者环形队列
+ * @author yAlgo Team
+ * @date 2026-10-16
+ * @version 1.0.0
+ */
+
+#ifndef YALGO_SDK_LOG_MPSC_RING_BUFFER_H
+#define YALGO_SDK_LOG_MPSC_RING_BUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace yalgo {
+namespace log {
+
+/**
+ * @brief 有界无锁MPSC环形队列
+ *
+ * @details 基于每槽位序号的环形缓冲（Vyukov算法）。槽位在构造时一次性预分配，
+ * 生产者通过一次CAS抢占写位置，消费者只读写自己的出队位置，全程不加锁。
+ * 容量会向上取整为2的幂。
+ *
+ * @tparam T 元素类型，需支持默认构造和移动赋值
+ */
+template <typename T>
+class MpscRingBuffer {
+public:
+    /**
+     * @brief 构造函数
+     * @param capacity 期望容量（向上取整为2的幂，最小为2）
+     */
+    explicit MpscRingBuffer(size_t capacity)
+        : mask_(roundUpPowerOfTwo(capacity) - 1),
+          slots_(new Slot[mask_ + 1]),
+          enqueue_pos_(0),
+          dequeue_pos_(0) {
+        for (size_t i = 0; i <= mask_; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRingBuffer(const MpscRingBuffer&) = delete;
+    MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+    /**
+     * @brief 入队（多生产者安全）
+     * @param value 待入队元素，成功时被移走
+     * @return 队列已满时返回false，value保持不变
+     */
+    bool tryPush(T&& value) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &slots_[pos & mask_];
+            size_t seq = slot->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // 槽位尚未被消费者释放，队列已满
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        slot->value = std::move(value);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief 出队（仅允许单个消费者线程调用）
+     * @param out 接收出队元素
+     * @return 队列为空时返回false
+     */
+    bool tryPop(T& out) {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        Slot* slot = &slots_[pos & mask_];
+        size_t seq = slot->sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1) < 0) {
+            return false;
+        }
+        out = std::move(slot->value);
+        slot->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        dequeue_pos_.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief 队列是否为空（仅消费者线程调用时结果准确）
+     */
+    bool empty() const {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        const Slot& slot = slots_[pos & mask_];
+        return slot.sequence.load(std::memory_order_acquire) != pos + 1;
+    }
+
+    /**
+     * @brief 读取指定位置上尚未取出的元素，不移动、不修改队列（崩溃处理用）
+     *
+     * @details 只做原子读取、不分配内存，可在信号处理函数中调用；从dequeuedCount()
+     * 开始逐个递增位置即按出队顺序遍历。与消费者并发时结果不精确。
+     * @param pos 位置（与enqueuedCount()、dequeuedCount()同一计数）
+     * @return 该位置的元素尚未写入完成或已被取出时返回nullptr
+     */
+    const T* pendingAt(size_t pos) const {
+        const Slot& slot = slots_[pos & mask_];
+        if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+            return nullptr;
+        }
+        return &slot.value;
+    }
+
+    /**
+     * @brief 当前元素个数的近似值（并发时仅供统计使用）
+     */
+    size_t sizeApprox() const {
+        size_t head = dequeue_pos_.load(std::memory_order_relaxed);
+        size_t tail = enqueue_pos_.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+    /**
+     * @brief 生产者已占用的槽位总数（单调递增，占用后很快写入完成）
+     */
+    size_t enqueuedCount() const {
+        return enqueue_pos_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 已取出的元素总数（仅消费者线程调用时结果准确）
+     */
+    size_t dequeuedCount() const {
+        return dequeue_pos_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 队列容量（槽位数）
+     */
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    /**
+     * @brief 槽位，按缓存行对齐避免相邻槽位伪共享
+     */
+    struct alignas(64) Slot {
+        std::atomic<size_t> sequence{0};
+        T value{};
+    };
+
+    static size_t roundUpPowerOfTwo(size_t n) {
+        size_t cap = 2;
+        while (cap < n) {
+            cap <<= 1;
+        }
+        return cap;
+    }
+
+    const size_t mask_;                              ///< 容量掩码
+    std::unique_ptr<Slot[]> slots_;                  ///< 预分配槽位
+    alignas(64) std::atomic<size_t> enqueue_pos_;    ///< 生产者写位置
+    alignas(64) std::atomic<size_t> dequeue_pos_;    ///< 消费者读位置
+};
+
+} // namespace log
+} // namespace yalgo
+
+#endif // YALGO_SDK_LOG_MPSC_RING_BUFFER_H
@@ -0,0 +1,135 @@
+/**
+ * @file rate_limit.cpp
+ * @brief 按调用点限频与采样的日志实现
+ * @author yAlgo Team
+ * @date 2026-10-16
+ * @version 1.0.0
+ */
+
+#include "rate_limit.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace yalgo {
+namespace log {
+
+namespace {
+
+// 调用点登记表
+struct SiteRegistry {
+    std::mutex mutex;
+    std::vector<RateLimitSite*> sites;
+};
+
+// 登记表在首个调用点构造时创建，因此晚于所有调用点析构
+SiteRegistry& siteRegistry() {
+    static SiteRegistry registry;
+    return registry;
+}
+
+// 区间[0, calls)中n的倍数个数，即EVERY_N输出的次数
+uint64_t emittedCalls(uint64_t calls, uint64_t n) {
+    return (calls + n - 1) / n;
+}
+
+} // namespace
+
+// 构造并登记调用点
+RateLimitSite::RateLimitSite(RateLimitMode mode, LogLevel level, const char* file, int line,
+                             const char* func)
+    : state_(0),
+      interval_(1),
+      carried_(0),
+      reported_calls_(0),
+      mode_(mode),
+      level_(level),
+      file_(file),
+      line_(line),
+      func_(func) {
+    SiteRegistry& registry = siteRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.sites.push_back(this);
+}
+
+// 注销调用点
+RateLimitSite::~RateLimitSite() {
+    SiteRegistry& registry = siteRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.sites.erase(std::remove(registry.sites.begin(), registry.sites.end(), this),
+                         registry.sites.end());
+}
+
+// 线程本地随机数状态
+uint64_t& RateLimitSite::rngState() {
+    // 以线程本地变量地址作种子，各线程序列互不相同
+    thread_local uint64_t state = 0;
+    if (state == 0) {
+        state = (reinterpret_cast<uintptr_t>(&state) | 1) * 0x9E3779B97F4A7C15ull;
+    }
+    return state;
+}
+
+// 争夺下一窗口
+bool RateLimitSite::claimWindow(uint64_t state, uint64_t now, uint64_t interval_ms) {
+    uint64_t desired = (now + interval_ms) << COUNT_BITS;
+    while (now >= (state >> COUNT_BITS)) {
+        if (state_.compare_exchange_weak(state, desired, std::memory_order_relaxed)) {
+            // 计数包含本次调用，其余是上一窗口内被抑制的调用
+            uint64_t suppressed = state & COUNT_MASK;
+            if (suppressed > 1) {
+                carried_.fetch_add(suppressed - 1, std::memory_order_relaxed);
+            }
+            return true;
+        }
+    }
+    // 其他线程已开启新窗口，本次调用计入新窗口的抑制次数
+    return false;
+}
+
+// 取出被抑制的次数
+uint64_t RateLimitSite::takeSuppressed() {
+    switch (mode_) {
+    case RateLimitMode::EVERY_N: {
+        uint64_t calls = state_.load(std::memory_order_relaxed);
+        uint64_t n = std::max<uint64_t>(interval_.load(std::memory_order_relaxed), 1);
+        uint64_t total = calls - reported_calls_;
+        uint64_t emitted = emittedCalls(calls, n) - emittedCalls(reported_calls_, n);
+        reported_calls_ = calls;
+        return total > emitted ? total - emitted : 0;
+    }
+    case RateLimitMode::EVERY_MS: {
+        // 清零当前窗口的计数，保留窗口起点
+        uint64_t state = state_.load(std::memory_order_relaxed);
+        while (!state_.compare_exchange_weak(state, state & ~COUNT_MASK,
+                                             std::memory_order_relaxed)) {
+        }
+        return (state & COUNT_MASK) + carried_.exchange(0, std::memory_order_relaxed);
+    }
+    case RateLimitMode::SAMPLED:
+    default:
+        return state_.exchange(0, std::memory_order_relaxed);
+    }
+}
+
+// 汇总被抑制的次数
+void collectSuppressed(std::vector<SuppressedSummary>& out) {
+    SiteRegistry& registry = siteRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (RateLimitSite* site : registry.sites) {
+        uint64_t count = site->takeSuppressed();
+        if (count == 0) {
+            continue;
+        }
+        SuppressedSummary summary;
+        summary.level = site->level();
+        summary.file = site->file();
+        summary.line = site->line();
+        summary.func = site->func();
+        summary.count = count;
+        out.push_back(summary);
+    }
+}
+
+} // namespace log
+} // namespace yalgo
@@ -0,0 +1,239 @@
+/**
+ * @file rate_limit.h
+ * @brief 按调用点限频与采样的日志宏
+ * @author yAlgo Team
+ * @date 2026-10-16
+ * @version 1.0.0
+ *
+ * 每个调用点持有一个静态RateLimitSite，被抑制的调用只做一次relaxed原子操作，
+ * 不格式化、不入队。被抑制的次数由写入线程按LogConfig::suppressed_report_ms
+ * 周期性汇总为一行 "suppressed N similar messages"。
+ */
+
+#ifndef YALGO_SDK_LOG_RATE_LIMIT_H
+#define YALGO_SDK_LOG_RATE_LIMIT_H
+
+#include "log_exports.h"
+#include "async_logger.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#ifdef __linux__
+#include <time.h>
+#endif
+
+namespace yalgo {
+namespace log {
+
+/**
+ * @brief 调用点限频方式
+ */
+enum class RateLimitMode {
+    EVERY_N = 0,  ///< 每N次调用输出1次
+    EVERY_MS = 1, ///< 每个时间窗口最多输出1次
+    SAMPLED = 2   ///< 按概率随机采样
+};
+
+/**
+ * @brief 一个调用点在汇报周期内被抑制的次数
+ */
+struct SuppressedSummary {
+    LogLevel level = LogLevel::OFF; ///< 日志级别
+    const char* file = "";          ///< 源文件
+    int line = 0;                   ///< 行号
+    const char* func = "";          ///< 函数名
+    uint64_t count = 0;             ///< 被抑制的次数
+};
+
+/**
+ * @brief 限频调用点状态
+ *
+ * @details 以函数内静态对象的形式存在，构造时登记、析构时注销。
+ * EVERY_MS模式把下一窗口起点（毫秒，高40位）与窗口内抑制次数（低24位）
+ * 打包在一个原子量中，被抑制的调用只需一次fetch_add；单个汇报周期内
+ * 抑制超过2^24次时计数按模回绕，窗口顺延1毫秒。
+ */
+class LOG_API RateLimitSite {
+public:
+    /**
+     * @brief 构造并登记调用点
+     * @param mode 限频方式
+     * @param level 日志级别
+     * @param file 源文件
+     * @param line 行号
+     * @param func 函数名
+     */
+    RateLimitSite(RateLimitMode mode, LogLevel level, const char* file, int line, const char* func);
+
+    /**
+     * @brief 注销调用点
+     */
+    ~RateLimitSite();
+
+    RateLimitSite(const RateLimitSite&) = delete;
+    RateLimitSite& operator=(const RateLimitSite&) = delete;
+
+    /**
+     * @brief 每N次调用输出1次（第1次总是输出）
+     * @param n 间隔次数
+     * @return 本次是否输出
+     */
+    bool everyN(uint64_t n) {
+        uint64_t calls = state_.fetch_add(1, std::memory_order_relaxed);
+        if (n <= 1 || calls % n == 0) {
+            interval_.store(n, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief 每interval_ms毫秒最多输出1次
+     * @param interval_ms 时间窗口（毫秒）
+     * @return 本次是否输出
+     */
+    bool everyMs(uint64_t interval_ms) {
+        uint64_t now = steadyMillis();
+        uint64_t state = state_.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (now < (state >> COUNT_BITS)) {
+            return false;
+        }
+        return claimWindow(state, now, interval_ms);
+    }
+
+    /**
+     * @brief 按概率采样
+     * @param probability 输出概率（0~1）
+     * @return 本次是否输出
+     */
+    bool sampled(double probability) {
+        // 线程本地xorshift，取高53位作为[0, 1)均匀分布
+        uint64_t& x = rngState();
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        if (static_cast<double>(x >> 11) * (1.0 / 9007199254740992.0) < probability) {
+            return true;
+        }
+        state_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    /**
+     * @brief 取出自上次汇报以来被抑制的次数（写入线程调用）
+     * @return uint64_t 次数
+     */
+    uint64_t takeSuppressed();
+
+    LogLevel level() const { return level_; }
+    const char* file() const { return file_; }
+    int line() const { return line_; }
+    const char* func() const { return func_; }
+
+private:
+    static const int COUNT_BITS = 24;                            ///< EVERY_MS打包计数位数
+    static const uint64_t COUNT_MASK = (1ull << COUNT_BITS) - 1; ///< EVERY_MS计数掩码
+
+    /**
+     * @brief 单调时钟毫秒数（Linux上使用粗粒度时钟，精度为一个时钟节拍）
+     */
+    static uint64_t steadyMillis() {
+#ifdef __linux__
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1000 + static_cast<uint64_t>(ts.tv_nsec) / 1000000;
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    /**
+     * @brief 线程本地随机数状态
+     */
+    static uint64_t& rngState();
+
+    /**
+     * @brief 窗口已过期时争夺下一窗口，成功者输出并把窗口内的抑制次数转入待汇报计数
+     * @param state fetch_add之后的状态
+     * @param now 当前时间（毫秒）
+     * @param interval_ms 时间窗口（毫秒）
+     * @return 是否由本次调用输出
+     */
+    bool claimWindow(uint64_t state, uint64_t now, uint64_t interval_ms);
+
+    std::atomic<uint64_t> state_;    ///< EVERY_N：调用次数；EVERY_MS：窗口起点|计数；SAMPLED：抑制次数
+    std::atomic<uint64_t> interval_; ///< EVERY_N：最近一次输出时的N
+    std::atomic<uint64_t> carried_;  ///< EVERY_MS：已结束窗口中尚未汇报的抑制次数
+    uint64_t reported_calls_;        ///< EVERY_N：上次汇报时的调用次数（仅写入线程访问）
+    RateLimitMode mode_;             ///< 限频方式
+    LogLevel level_;                 ///< 日志级别
+    const char* file_;               ///< 源文件
+    int line_;                       ///< 行号
+    const char* func_;               ///< 函数名
+};
+
+/**
+ * @brief 取出所有调用点在本周期内被抑制的次数（写入线程调用）
+ * @param out 追加抑制次数非零的调用点
+ */
+LOG_API void collectSuppressed(std::vector<SuppressedSummary>& out);
+
+} // namespace log
+} // namespace yalgo
+
+// 限频宏实现：site静态构造一次，check为RateLimitSite的成员调用；级别关闭时不计数
+#define YLOG_RATE_LIMIT_IMPL(mode, check, level, log_macro, format, ...) do { \
+    if (YLOG_LEVEL_ENABLED(level)) { \
+        static yalgo::log::RateLimitSite yalgo_rate_limit_site( \
+            yalgo::log::RateLimitMode::mode, level, __FILE__, __LINE__, __func__); \
+        if (yalgo_rate_limit_site.check) { \
+            log_macro(format, ##__VA_ARGS__); \
+        } \
+    } \
+} while(0)
+
+#if YALGO_LOG_LEVEL >= 1 // LOG_ERROR级别
+#define YLOG_ERROR_EVERY_N(n, format, ...) YLOG_RATE_LIMIT_IMPL(EVERY_N, everyN(n), yalgo::log::LogLevel::LOG_ERROR, YLOG_ERROR, format, ##__VA_ARGS__)
+#define YLOG_ERROR_EVERY_MS(ms, format, ...) YLOG_RATE_LIMIT_IMPL(EVERY_MS, everyMs(ms), yalgo::log::LogLevel::LOG_ERROR, YLOG_ERROR, format, ##__VA_ARGS__)
+#define YLOG_ERROR_SAMPLED(p, format, ...) YLOG_RATE_LIMIT_IMPL(SAMPLED, sampled(p), yalgo::log::LogLevel::LOG_ERROR, YLOG_ERROR, format, ##__VA_ARGS__)
+#else
+#define YLOG_ERROR_EVERY_N(n, format, ...) do {} while(0)
+#define YLOG_ERROR_EVERY_MS(ms, format, ...) do {} while(0)
+#define YLOG_ERROR_SAMPLED(p, format, ...) do {} while(0)
+#endif
+
+#if YALGO_LOG_LEVEL >= 2 // WARN级别
+#define YLOG_WARN_EVERY_N(n, format, ...) YLOG_RATE_LIMIT_IMPL(EVERY_N, everyN(n), yalgo::log::LogLevel::WARN, YLOG_WARN, format, ##__VA_ARGS__)
+#define YLOG_WARN_EVERY_MS(ms, format, ...) YLOG_RATE_LIMIT_IMPL(EVERY_MS, everyMs(ms), yalgo::log::LogLevel::WARN, YLOG_WARN, format, ##__VA_ARGS__)
+#define YLOG_WARN_SAMPLED(p, format, ...) YLOG_RATE_LIMIT_IMPL(SAMPLED, sampled(p), yalgo::log::LogLevel::WARN, YLOG_WARN, format, ##__VA_ARGS__)
+#else
+#define YLOG_WARN_EVERY_N(n, format, ...) do {} while(0)
+#define YLOG_WARN_EVERY_MS(ms, format, ...) do {} while(0)
+#define YLOG_WARN_SAMPLED(p, format, ...) do {} while(0)
+#endif
+
+#if YALGO_LOG_LEVEL >= 3 // INFO级别
+#define YLOG_INFO_EVERY_N(n, format, ...) YLOG_RATE_LIMIT_IMPL(EVERY_N, everyN(n), yalgo::log::LogLevel::INFO, YLOG_INFO, format, ##__VA_ARGS__)
+#define YLOG_INFO_EVERY_MS(ms, format, ...) YLOG_RATE_LIMIT_IMPL(EVERY_MS, everyMs(ms), yalgo::log::LogLevel::INFO, YLOG_INFO, format, ##__VA_ARGS__)
+#define YLOG_INFO_SAMPLED(p, format, ...) YLOG_RATE_LIMIT_IMPL(SAMPLED, sampled(p), yalgo::log::LogLevel::INFO, YLOG_INFO, format, ##__VA_ARGS__)
+#else
+#define YLOG_INFO_EVERY_N(n, format, ...) do {} while(0)
+#define YLOG_INFO_EVERY_MS(ms, format, ...) do {} while(0)
+#define YLOG_INFO_SAMPLED(p, format, ...) do {} while(0)
+#endif
+
+#if YALGO_LOG_LEVEL >= 4 // DEBUG级别
+#define YLOG_DEBUG_EVERY_N(n, format, ...) YLOG_RATE_LIMIT_IMPL(EVERY_N, everyN(n), yalgo::log::LogLevel::DEBUG, YLOG_DEBUG, format, ##__VA_ARGS__)
+#define YLOG_DEBUG_EVERY_MS(ms, format, ...) YLOG_RATE_LIMIT_IMPL(EVERY_MS, everyMs(ms), yalgo::log::LogLevel::DEBUG, YLOG_DEBUG, format, ##__VA_ARGS__)
+#define YLOG_DEBUG_SAMPLED(p, format, ...) YLOG_RATE_LIMIT_IMPL(SAMPLED, sampled(p), yalgo::log::LogLevel::DEBUG, YLOG_DEBUG, format, ##__VA_ARGS__)
+#else
+#define YLOG_DEBUG_EVERY_N(n, format, ...) do {} while(0)
+#define YLOG_DEBUG_EVERY_MS(ms, format, ...) do {} while(0)
+#define YLOG_DEBUG_SAMPLED(p, format, ...) do {} while(0)
+#endif
+
+#endif // YALGO_SDK_LOG_RATE_LIMIT_H
@@ -0,0 +1,526 @@
+/**
+ * @file segment_compressor.cpp
+ * @brief 历史日志文件压缩与按时间检索实现
+ * @author yAlgo Team
+ * @date 2026-10-16
+ * @version 1.0.0
+ */
+
+#include "segment_compressor.h"
+#include "binary_log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+
+namespace yalgo {
+namespace log {
+
+namespace {
+
+const size_t kMinMatch = 4;         ///< LZ4最短匹配
+const size_t kLastLiterals = 5;     ///< 块末尾必须为字面量的字节数
+const size_t kMatchFindLimit = 12;  ///< 最后一个匹配距块末尾的最小距离
+const size_t kMaxOffset = 65535;    ///< 最大回溯距离
+const int kHashLog = 12;            ///< 哈希表大小（2^12项）
+
+const size_t kBlockSize = 256 * 1024; ///< 压缩块目标大小
+const size_t kReadSize = 1024 * 1024; ///< 每次读取原始文件的字节数
+
+const char kIndexMagic[8] = {'Y', 'L', 'Z', 'I', 'N', 'D', 'E', 'X'};
+const size_t kIndexEntrySize = 8 + 8 + 8 + 4 + 4;
+const size_t kFooterSize = 8 + 4 + 4 + sizeof(kIndexMagic);
+
+inline uint32_t read32(const uint8_t* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint32_t hashSequence(uint32_t sequence) {
+    return (sequence * 2654435761U) >> (32 - kHashLog);
+}
+
+// 追加LZ4变长长度的扩展字节
+void appendLength(std::string& out, size_t length) {
+    while (length >= 255) {
+        out.push_back(static_cast<char>(255));
+        length -= 255;
+    }
+    out.push_back(static_cast<char>(length));
+}
+
+// 输出一个序列：字面量 + 匹配（match_length为0时只输出字面量，用于块末尾）
+void appendSequence(std::string& out, const uint8_t* literals, size_t literal_length,
+                    size_t offset, size_t match_length) {
+    size_t token_pos = out.size();
+    out.push_back(0);
+    uint8_t token = 0;
+
+    if (literal_length >= 15) {
+        token = 15 << 4;
+        appendLength(out, literal_length - 15);
+    } else {
+        token = static_cast<uint8_t>(literal_length << 4);
+    }
+    out.append(reinterpret_cast<const char*>(literals), literal_length);
+
+    if (match_length > 0) {
+        out.push_back(static_cast<char>(offset & 0xFF));
+        out.push_back(static_cast<char>(offset >> 8));
+        size_t extra = match_length - kMinMatch;
+        if (extra >= 15) {
+            token |= 15;
+            appendLength(out, extra - 15);
+        } else {
+            token |= static_cast<uint8_t>(extra);
+        }
+    }
+    out[token_pos] = static_cast<char>(token);
+}
+
+template <typename T>
+void appendValue(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T readValue(const char* p) {
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+int seekFile(FILE* file, uint64_t offset, int origin) {
+#ifdef _WIN32
+    return _fseeki64(file, static_cast<__int64>(offset), origin);
+#else
+    return fseeko(file, static_cast<off_t>(offset), origin);
+#endif
+}
+
+uint64_t tellFile(FILE* file) {
+#ifdef _WIN32
+    return static_cast<uint64_t>(_ftelli64(file));
+#else
+    return static_cast<uint64_t>(ftello(file));
+#endif
+}
+
+// 解析固定位数的十进制数
+bool parseDigits(const char* p, int count, int& value) {
+    value = 0;
+    for (int i = 0; i < count; ++i) {
+        if (p[i] < '0' || p[i] > '9') {
+            return false;
+        }
+        value = value * 10 + (p[i] - '0');
+    }
+    return true;
+}
+
+// 文本日志块切分：尽量在kBlockSize之内的最后一个换行处切分
+size_t findTextCut(const std::string& pending, bool eof) {
+    if (eof && pending.size() <= kBlockSize) {
+        return pending.size();
+    }
+    size_t limit = std::min(pending.size(), kBlockSize);
+    size_t pos = pending.rfind('\n', limit - 1);
+    if (pos != std::string::npos) {
+        return pos + 1;
+    }
+    // 单行超过块大小
+    pos = pending.find('\n', limit);
+    if (pos != std::string::npos) {
+        return pos + 1;
+    }
+    return eof ? pending.size() : limit;
+}
+
+// 文本日志块首条日志的时间（跳过多行消息的续行）
+bool findTextTimestamp(const char* data, size_t size, uint64_t& timestamp_us) {
+    size_t pos = 0;
+    while (pos < size) {
+        if (parseTextLogTimestamp(data + pos, size - pos, timestamp_us)) {
+            return true;
+        }
+        const void* newline = std::memchr(data + pos, '\n', size - pos);
+        if (!newline) {
+            break;
+        }
+        pos = static_cast<const char*>(newline) - data + 1;
+    }
+    return false;
+}
+
+} // namespace
+
+// LZ4块压缩
+size_t lz4CompressBlock(const char* src, size_t size, std::string& out) {
+    size_t start = out.size();
+    const uint8_t* base = reinterpret_cast<const uint8_t*>(src);
+    size_t anchor = 0;
+
+    if (size > kMatchFindLimit) {
+        // 哈希表保存位置+1，0表示空
+        std::vector<uint32_t> table(1u << kHashLog, 0);
+        const size_t match_limit = size - kLastLiterals;
+        const size_t ip_limit = size - kMatchFindLimit;
+        size_t ip = 0;
+
+        while (ip < ip_limit) {
+            uint32_t sequence = read32(base + ip);
+            uint32_t hash = hashSequence(sequence);
+            size_t candidate = table[hash];
+            table[hash] = static_cast<uint32_t>(ip + 1);
+
+            if (candidate == 0 || ip - (candidate - 1) > kMaxOffset ||
+                read32(base + candidate - 1) != sequence) {
+                // 不可压缩的数据逐步加大步长
+                ip += 1 + ((ip - anchor) >> 6);
+                continue;
+            }
+
+            size_t ref = candidate - 1;
+            while (ip > anchor && ref > 0 && base[ip - 1] == base[ref - 1]) {
+                --ip;
+                --ref;
+            }
+            size_t length = kMinMatch;
+            while (ip + length < match_limit && base[ip + length] == base[ref + length]) {
+                ++length;
+            }
+
+            appendSequence(out, base + anchor, ip - anchor, ip - ref, length);
+            ip += length;
+            anchor = ip;
+            if (ip < ip_limit) {
+                table[hashSequence(read32(base + ip - 2))] = static_cast<uint32_t>(ip - 2 + 1);
+            }
+        }
+    }
+
+    appendSequence(out, base + anchor, size - anchor, 0, 0);
+    return out.size() - start;
+}
+
+// LZ4块解压
+long long lz4DecompressBlock(const char* src, size_t size, char* dst, size_t capacity) {
+    const uint8_t* in = reinterpret_cast<const uint8_t*>(src);
+    size_t ip = 0;
+    size_t op = 0;
+
+    while (ip < size) {
+        uint8_t token = in[ip++];
+
+        size_t literal_length = token >> 4;
+        if (literal_length == 15) {
+            uint8_t b = 255;
+            while (b == 255) {
+                if (ip >= size) {
+                    return -1;
+                }
+                b = in[ip++];
+                literal_length += b;
+            }
+        }
+        if (literal_length > size - ip || literal_length > capacity - op) {
+            return -1;
+        }
+        std::memcpy(dst + op, in + ip, literal_length);
+        ip += literal_length;
+        op += literal_length;
+        if (ip == size) {
+            break; // 最后一个序列只有字面量
+        }
+
+        if (size - ip < 2) {
+            return -1;
+        }
+        size_t offset = in[ip] | (static_cast<size_t>(in[ip + 1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > op) {
+            return -1;
+        }
+
+        size_t match_length = token & 15;
+        if (match_length == 15) {
+            uint8_t b = 255;
+            while (b == 255) {
+                if (ip >= size) {
+                    return -1;
+                }
+                b = in[ip++];
+                match_length += b;
+            }
+        }
+        match_length += kMinMatch;
+        if (match_length > capacity - op) {
+            return -1;
+        }
+
+        // 重叠匹配（offset小于长度）必须逐字节复制
+        const char* match = dst + op - offset;
+        if (offset >= match_length) {
+            std::memcpy(dst + op, match, match_length);
+        } else {
+            for (size_t i = 0; i < match_length; ++i) {
+                dst[op + i] = match[i];
+            }
+        }
+        op += match_length;
+    }
+    return static_cast<long long>(op);
+}
+
+// 解析文本日志时间戳
+bool parseTextLogTimestamp(const char* line, size_t size, uint64_t& timestamp_us) {
+    // "[YYYY-mm-dd HH:MM:SS.uuuuuu]"
+    const size_t length = 28;
+    if (size < length || line[0] != '[' || line[5] != '-' || line[8] != '-' || line[11] != ' ' ||
+        line[14] != ':' || line[17] != ':' || line[20] != '.' || line[27] != ']') {
+        return false;
+    }
+    int year, month, day, hour, minute, second, micros;
+    if (!parseDigits(line + 1, 4, year) || !parseDigits(line + 6, 2, month) ||
+        !parseDigits(line + 9, 2, day) || !parseDigits(line + 12, 2, hour) ||
+        !parseDigits(line + 15, 2, minute) || !parseDigits(line + 18, 2, second) ||
+        !parseDigits(line + 21, 6, micros)) {
+        return false;
+    }
+
+    // 同一秒内的行复用上一次mktime的结果
+    thread_local char cached_text[19] = {0};
+    thread_local int64_t cached_seconds = -1;
+    if (cached_seconds < 0 || std::memcmp(cached_text, line + 1, sizeof(cached_text)) != 0) {
+        struct tm local_tm;
+        std::memset(&local_tm, 0, sizeof(local_tm));
+        local_tm.tm_year = year - 1900;
+        local_tm.tm_mon = month - 1;
+        local_tm.tm_mday = day;
+        local_tm.tm_hour = hour;
+        local_tm.tm_min = minute;
+        local_tm.tm_sec = second;
+        local_tm.tm_isdst = -1;
+        time_t seconds = mktime(&local_tm);
+        if (seconds == static_cast<time_t>(-1)) {
+            return false;
+        }
+        std::memcpy(cached_text, line + 1, sizeof(cached_text));
+        cached_seconds = static_cast<int64_t>(seconds);
+    }
+    timestamp_us = static_cast<uint64_t>(cached_seconds) * 1000000 + static_cast<uint64_t>(micros);
+    return true;
+}
+
+// 压缩历史日志文件
+bool compressLogSegment(const std::string& src_path, const std::string& dst_path) {
+    FILE* in = fopen(src_path.c_str(), "rb");
+    if (!in) {
+        return false;
+    }
+    std::string tmp_path = dst_path + ".tmp";
+    FILE* out = fopen(tmp_path.c_str(), "wb");
+    if (!out) {
+        fclose(in);
+        return false;
+    }
+
+    std::string pending;
+    std::string compressed;
+    std::vector<SegmentBlockInfo> blocks;
+    std::vector<char> read_buf(kReadSize);
+    BinaryLogDecoder decoder;
+    BinaryLogEntry entry;
+    SegmentContentType content_type = SegmentContentType::TEXT;
+    bool first = true;
+    bool eof = false;
+    bool ok = fwrite(COMPRESSED_SEGMENT_MAGIC, 1, sizeof(COMPRESSED_SEGMENT_MAGIC), out) ==
+              sizeof(COMPRESSED_SEGMENT_MAGIC);
+    uint64_t file_offset = sizeof(COMPRESSED_SEGMENT_MAGIC);
+    uint64_t raw_offset = 0;
+    uint64_t last_timestamp = 0;
+
+    while (ok) {
+        // 保持缓冲中至少有两个块的数据，便于在日志边界处切分
+        while (!eof && pending.size() < 2 * kBlockSize) {
+            size_t n = fread(read_buf.data(), 1, read_buf.size(), in);
+            pending.append(read_buf.data(), n);
+            eof = (n < read_buf.size());
+        }
+        if (pending.empty()) {
+            break;
+        }
+
+        size_t offset = 0;
+        if (first) {
+            if (BinaryLogDecoder::checkHeader(pending.data(), pending.size(), offset)) {
+                content_type = SegmentContentType::BINARY;
+            }
+            first = false;
+        }
+
+        // 按日志边界确定块长度，并取块内首条日志时间作为索引
+        size_t cut = 0;
+        uint64_t timestamp = 0;
+        bool has_timestamp = false;
+        if (content_type == SegmentContentType::BINARY) {
+            size_t limit = std::min(pending.size(), kBlockSize);
+            while (offset < limit && decoder.next(pending.data(), pending.size(), offset, entry)) {
+                if (!has_timestamp) {
+                    timestamp = entry.timestamp_us;
+                    has_timestamp = true;
+                }
+            }
+            cut = offset;
+            if (eof && offset < limit) {
+                cut = pending.size(); // 末尾截断或零填充的部分原样保存
+            } else if (cut == 0) {
+                cut = limit;
+            }
+        } else {
+            cut = findTextCut(pending, eof);
+            has_timestamp = findTextTimestamp(pending.data(), cut, timestamp);
+        }
+        if (!has_timestamp) {
+            timestamp = last_timestamp;
+        }
+        last_timestamp = timestamp;
+
+        compressed.clear();
+        lz4CompressBlock(pending.data(), cut, compressed);
+
+        SegmentBlockInfo block;
+        block.first_timestamp_us = timestamp;
+        block.file_offset = file_offset;
+        block.raw_offset = raw_offset;
+        block.raw_size = static_cast<uint32_t>(cut);
+        block.compressed_size = static_cast<uint32_t>(compressed.size());
+        blocks.push_back(block);
+
+        uint32_t sizes[2] = {block.raw_size, block.compressed_size};
+        ok = fwrite(sizes, 1, sizeof(sizes), out) == sizeof(sizes) &&
+             fwrite(compressed.data(), 1, compressed.size(), out) == compressed.size();
+        file_offset += sizeof(sizes) + compressed.size();
+        raw_offset += cut;
+        pending.erase(0, cut);
+    }
+    ok = ok && !ferror(in);
+    fclose(in);
+
+    // 索引与文件尾
+    if (ok) {
+        std::string index;
+        index.reserve(blocks.size() * kIndexEntrySize + kFooterSize);
+        for (const SegmentBlockInfo& block : blocks) {
+            appendValue(index, block.first_timestamp_us);
+            appendValue(index, block.file_offset);
+            appendValue(index, block.raw_offset);
+            appendValue(index, block.raw_size);
+            appendValue(index, block.compressed_size);
+        }
+        appendValue(index, file_offset);
+        appendValue(index, static_cast<uint32_t>(blocks.size()));
+        appendValue(index, static_cast<uint32_t>(content_type));
+        index.append(kIndexMagic, sizeof(kIndexMagic));
+        ok = fwrite(index.data(), 1, index.size(), out) == index.size();
+    }
+    ok = (fclose(out) == 0) && ok;
+
+    if (!ok || std::rename(tmp_path.c_str(), dst_path.c_str()) != 0) {
+        std::remove(tmp_path.c_str());
+        return false;
+    }
+    std::remove(src_path.c_str());
+    return true;
+}
+
+// 构造函数
+CompressedSegmentReader::CompressedSegmentReader()
+    : file_(nullptr), content_type_(SegmentContentType::TEXT), blocks_(), buffer_() {}
+
+// 析构函数
+CompressedSegmentReader::~CompressedSegmentReader() {
+    if (file_) {
+        fclose(file_);
+    }
+}
+
+// 打开压缩文件
+bool CompressedSegmentReader::open(const std::string& path) {
+    if (file_) {
+        fclose(file_);
+    }
+    blocks_.clear();
+    file_ = fopen(path.c_str(), "rb");
+    if (!file_) {
+        return false;
+    }
+
+    char magic[sizeof(COMPRESSED_SEGMENT_MAGIC)];
+    if (fread(magic, 1, sizeof(magic), file_) != sizeof(magic) ||
+        std::memcmp(magic, COMPRESSED_SEGMENT_MAGIC, sizeof(magic)) != 0) {
+        return false;
+    }
+
+    char footer[kFooterSize];
+    if (seekFile(file_, 0, SEEK_END) != 0) {
+        return false;
+    }
+    uint64_t file_size = tellFile(file_);
+    if (file_size < sizeof(magic) + kFooterSize ||
+        seekFile(file_, file_size - kFooterSize, SEEK_SET) != 0 ||
+        fread(footer, 1, kFooterSize, file_) != kFooterSize ||
+        std::memcmp(footer + 16, kIndexMagic, sizeof(kIndexMagic)) != 0) {
+        return false;
+    }
+    uint64_t index_offset = readValue<uint64_t>(footer);
+    uint32_t count = readValue<uint32_t>(footer + 8);
+    content_type_ = static_cast<SegmentContentType>(readValue<uint32_t>(footer + 12));
+    if (index_offset + static_cast<uint64_t>(count) * kIndexEntrySize + kFooterSize != file_size) {
+        return false;
+    }
+
+    std::string index(static_cast<size_t>(count) * kIndexEntrySize, '\0');
+    if (seekFile(file_, index_offset, SEEK_SET) != 0 ||
+        fread(&index[0], 1, index.size(), file_) != index.size()) {
+        return false;
+    }
+    blocks_.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        const char* p = index.data() + static_cast<size_t>(i) * kIndexEntrySize;
+        SegmentBlockInfo& block = blocks_[i];
+        block.first_timestamp_us = readValue<uint64_t>(p);
+        block.file_offset = readValue<uint64_t>(p + 8);
+        block.raw_offset = readValue<uint64_t>(p + 16);
+        block.raw_size = readValue<uint32_t>(p + 24);
+        block.compressed_size = readValue<uint32_t>(p + 28);
+    }
+    return true;
+}
+
+// 按时间定位数据块
+size_t CompressedSegmentReader::findBlock(uint64_t timestamp_us) const {
+    auto it = std::upper_bound(blocks_.begin(), blocks_.end(), timestamp_us,
+        [](uint64_t ts, const SegmentBlockInfo& block) { return ts < block.first_timestamp_us; });
+    return it == blocks_.begin() ? 0 : static_cast<size_t>(it - blocks_.begin()) - 1;
+}
+
+// 解压数据块
+bool CompressedSegmentReader::readBlock(size_t index, std::string& out) {
+    if (!file_ || index >= blocks_.size()) {
+        return false;
+    }
+    const SegmentBlockInfo& block = blocks_[index];
+    buffer_.resize(block.compressed_size);
+    if (seekFile(file_, block.file_offset + 2 * sizeof(uint32_t), SEEK_SET) != 0 ||
+        fread(&buffer_[0], 1, buffer_.size(), file_) != buffer_.size()) {
+        return false;
+    }
+    out.resize(block.raw_size);
+    long long n = lz4DecompressBlock(buffer_.data(), buffer_.size(), &out[0], out.size());
+    return n == static_cast<long long>(block.raw_size);
+}
+
+} // namespace log
+} // namespace yalgo
@@ -0,0 +1,158 @@
+/**
+ * @file segment_compressor.h
+ * @brief 历史日志文件压缩与按时间检索
+ * @author yAlgo Team
+ * @date 2026-10-16
+ * @version 1.0.0
+ *
+ * 压缩文件（.ylz）布局，整数均为小端序：
+ *   文件头：  "YLOGLZ01"
+ *   数据块：  uint32 原始长度 | uint32 压缩长度 | LZ4块格式数据
+ *   索引：    每块 uint64 首条日志时间戳 | uint64 块偏移 | uint64 原始偏移 | uint32 原始长度 | uint32 压缩长度
+ *   文件尾：  uint64 索引偏移 | uint32 块数 | uint32 内容类型 | "YLZINDEX"
+ *
+ * 数据块在日志边界处切分（文本按行，二进制按条目），因此可以按时间戳二分定位到块，
+ * 只解压需要的部分。二进制内容的格式串定义可能位于更早的块，解码时仍需顺序读取。
+ */
+
+#ifndef YALGO_SDK_LOG_SEGMENT_COMPRESSOR_H
+#define YALGO_SDK_LOG_SEGMENT_COMPRESSOR_H
+
+#include "log_exports.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace yalgo {
+namespace log {
+
+/**
+ * @brief 压缩文件扩展名
+ */
+constexpr char COMPRESSED_SEGMENT_SUFFIX[] = ".ylz";
+
+/**
+ * @brief 压缩文件头
+ */
+constexpr char COMPRESSED_SEGMENT_MAGIC[8] = {'Y', 'L', 'O', 'G', 'L', 'Z', '0', '1'};
+
+/**
+ * @brief 压缩文件中日志内容的类型
+ */
+enum class SegmentContentType : uint32_t {
+    TEXT = 0,  ///< 文本日志
+    BINARY = 1 ///< 二进制日志（LogFileFormat::BINARY）
+};
+
+/**
+ * @brief 压缩文件中一个数据块的索引信息
+ */
+struct SegmentBlockInfo {
+    uint64_t first_timestamp_us = 0; ///< 块内首条日志时间（Unix纪元微秒）
+    uint64_t file_offset = 0;        ///< 块在压缩文件中的偏移
+    uint64_t raw_offset = 0;         ///< 块在原始文件中的偏移
+    uint32_t raw_size = 0;           ///< 原始长度
+    uint32_t compressed_size = 0;    ///< 压缩长度
+};
+
+/**
+ * @brief LZ4块格式压缩
+ * @param src 原始数据
+ * @param size 原始长度
+ * @param out 追加压缩结果
+ * @return size_t 压缩后字节数
+ */
+LOG_API size_t lz4CompressBlock(const char* src, size_t size, std::string& out);
+
+/**
+ * @brief LZ4块格式解压
+ * @param src 压缩数据
+ * @param size 压缩长度
+ * @param dst 输出缓冲
+ * @param capacity 输出缓冲容量（即原始长度）
+ * @return 解压后字节数，数据损坏时返回-1
+ */
+LOG_API long long lz4DecompressBlock(const char* src, size_t size, char* dst, size_t capacity);
+
+/**
+ * @brief 解析文本日志行首的 "[YYYY-mm-dd HH:MM:SS.uuuuuu]" 时间戳（本地时间）
+ * @param line 行首
+ * @param size 可读字节数
+ * @param timestamp_us 接收Unix纪元微秒
+ * @return 是否解析成功
+ */
+LOG_API bool parseTextLogTimestamp(const char* line, size_t size, uint64_t& timestamp_us);
+
+/**
+ * @brief 压缩一个历史日志文件
+ *
+ * @details 流式读取，按日志边界切成约256KB的块分别压缩，并在文件尾写入时间索引。
+ * 先写入临时文件再改名，成功后删除原文件。
+ * @param src_path 原始文件
+ * @param dst_path 压缩文件
+ * @return 是否成功
+ */
+LOG_API bool compressLogSegment(const std::string& src_path, const std::string& dst_path);
+
+/**
+ * @brief 压缩文件读取器
+ */
+class LOG_API CompressedSegmentReader {
+public:
+    CompressedSegmentReader();
+    ~CompressedSegmentReader();
+
+    CompressedSegmentReader(const CompressedSegmentReader&) = delete;
+    CompressedSegmentReader& operator=(const CompressedSegmentReader&) = delete;
+
+    /**
+     * @brief 打开压缩文件并读取索引
+     * @param path 文件路径
+     * @return 是否为有效的压缩文件
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief 日志内容类型
+     */
+    SegmentContentType contentType() const { return content_type_; }
+
+    /**
+     * @brief 数据块数量
+     */
+    size_t blockCount() const { return blocks_.size(); }
+
+    /**
+     * @brief 数据块索引信息
+     */
+    const SegmentBlockInfo& block(size_t index) const { return blocks_[index]; }
+
+    /**
+     * @brief 查找可能包含指定时间之后日志的第一个块
+     * @param timestamp_us Unix纪元微秒
+     * @return 首条日志时间不晚于timestamp_us的最后一个块（都晚于时返回0）
+     */
+    size_t findBlock(uint64_t timestamp_us) const;
+
+    /**
+     * @brief 解压一个数据块
+     * @param index 块序号
+     * @param out 接收原始数据（覆盖）
+     * @return 是否成功
+     */
+    bool readBlock(size_t index, std::string& out);
+
+private:
+    FILE* file_;                          ///< 文件句柄
+    SegmentContentType content_type_;     ///< 内容类型
+    std::vector<SegmentBlockInfo> blocks_;///< 块索引
+    std::string buffer_;                  ///< 压缩数据读取缓冲
+};
+
+} // namespace log
+} // namespace yalgo
+
+#endif // YALGO_SDK_LOG_SEGMENT_COMPRESSOR_H
@@ -0,0 +1,343 @@
+/**
+ * @file structured_log.cpp
+ * @brief 结构化键值日志编码实现
+ * @author yAlgo Team
+ * @date 2026-10-16
+ * @version 1.0.0
+ */
+
+#include "structured_log.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <string_view>
+
+namespace yalgo {
+namespace log {
+
+namespace {
+
+const char kHexDigits[] = "0123456789abcdef";
+
+// 编码缓冲：先写入栈上缓冲，满时整段追加到输出，避免逐个小片段调用std::string::append
+class EncodeBuffer {
+public:
+    explicit EncodeBuffer(std::string& out) : out_(out) {}
+    ~EncodeBuffer() { flush(); }
+
+    EncodeBuffer(const EncodeBuffer&) = delete;
+    EncodeBuffer& operator=(const EncodeBuffer&) = delete;
+
+    void put(char c) {
+        if (size_ == sizeof(buf_)) {
+            flush();
+        }
+        buf_[size_++] = c;
+    }
+
+    void put(const char* data, size_t len) {
+        if (len > sizeof(buf_) - size_) {
+            flush();
+            if (len > sizeof(buf_)) {
+                out_.append(data, len);
+                return;
+            }
+        }
+        std::memcpy(buf_ + size_, data, len);
+        size_ += len;
+    }
+
+    void put(std::string_view text) { put(text.data(), text.size()); }
+
+    template <size_t N>
+    void literal(const char (&text)[N]) { put(text, N - 1); }
+
+    // 预留len字节供直接写入，写完后调用commit
+    char* reserve(size_t len) {
+        if (len > sizeof(buf_) - size_) {
+            flush();
+        }
+        return buf_ + size_;
+    }
+
+    void commit(const char* end) { size_ = static_cast<size_t>(end - buf_); }
+
+    void flush() {
+        out_.append(buf_, size_);
+        size_ = 0;
+    }
+
+private:
+    std::string& out_;
+    char buf_[512];
+    size_t size_ = 0;
+};
+
+// 追加整数（to_chars，不分配内存）
+template <typename T>
+void appendInteger(EncodeBuffer& out, T value) {
+    char* buf = out.reserve(24);
+    out.commit(std::to_chars(buf, buf + 24, value).ptr);
+}
+
+// 追加浮点数：可精确还原的最短表示
+void appendDouble(EncodeBuffer& out, double value, bool json) {
+    if (!std::isfinite(value)) {
+        if (json) {
+            out.literal("null");
+        } else {
+            out.put(std::isnan(value) ? "NaN" : (value > 0 ? "+Inf" : "-Inf"), 3 + !std::isnan(value));
+        }
+        return;
+    }
+    char* buf = out.reserve(32);
+    out.commit(std::to_chars(buf, buf + 32, value).ptr);
+}
+
+// 追加指针地址（0x十六进制）
+void appendPointer(EncodeBuffer& out, uint64_t value) {
+    char* buf = out.reserve(24);
+    buf[0] = '0';
+    buf[1] = 'x';
+    out.commit(std::to_chars(buf + 2, buf + 24, value, 16).ptr);
+}
+
+// 追加转义后的字符串内容（不含引号），按无需转义的连续片段整段追加
+void appendEscaped(EncodeBuffer& out, std::string_view text) {
+    const char* p = text.data();
+    const char* end = p + text.size();
+    const char* run = p;
+    for (; p != end; ++p) {
+        unsigned char c = static_cast<unsigned char>(*p);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        out.put(run, static_cast<size_t>(p - run));
+        run = p + 1;
+        switch (c) {
+            case '"':  out.literal("\\\""); break;
+            case '\\': out.literal("\\\\"); break;
+            case '\n': out.literal("\\n"); break;
+            case '\r': out.literal("\\r"); break;
+            case '\t': out.literal("\\t"); break;
+            default: {
+                char esc[6] = {'\\', 'u', '0', '0', kHexDigits[c >> 4], kHexDigits[c & 0xF]};
+                out.put(esc, sizeof(esc));
+                break;
+            }
+        }
+    }
+    out.put(run, static_cast<size_t>(p - run));
+}
+
+// 追加带引号的JSON字符串
+void appendJsonString(EncodeBuffer& out, std::string_view text) {
+    out.put('"');
+    appendEscaped(out, text);
+    out.put('"');
+}
+
+// 追加logfmt值：含空格、等号、引号或控制字符时加引号
+void appendLogfmtString(EncodeBuffer& out, std::string_view text) {
+    bool quote = text.empty();
+    for (char ch : text) {
+        unsigned char c = static_cast<unsigned char>(ch);
+        if (c <= ' ' || c == '=' || c == '"' || c == '\\' || c == 0x7F) {
+            quote = true;
+            break;
+        }
+    }
+    if (!quote) {
+        out.put(text);
+        return;
+    }
+    appendJsonString(out, text);
+}
+
+// 按类型顺序读取字段值
+class FieldReader {
+public:
+    FieldReader(const char* data, size_t size) : data_(data), size_(size) {}
+
+    template <typename T>
+    bool read(T& value) {
+        if (size_ - pos_ < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, data_ + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return true;
+    }
+
+    bool readString(std::string_view& value) {
+        uint32_t len = 0;
+        if (!read(len) || size_ - pos_ < len) {
+            return false;
+        }
+        value = std::string_view(data_ + pos_, len);
+        pos_ += len;
+        return true;
+    }
+
+private:
+    const char* data_;
+    size_t size_;
+    size_t pos_ = 0;
+};
+
+// 追加一个字段值，数据不完整时返回false
+bool appendFieldValue(EncodeBuffer& out, BinaryArgType type, FieldReader& reader, bool json) {
+    switch (type) {
+        case BinaryArgType::INT32: {
+            int32_t value;
+            if (!reader.read(value)) return false;
+            appendInteger(out, value);
+            return true;
+        }
+        case BinaryArgType::INT64: {
+            int64_t value;
+            if (!reader.read(value)) return false;
+            appendInteger(out, value);
+            return true;
+        }
+        case BinaryArgType::UINT32: {
+            uint32_t value;
+            if (!reader.read(value)) return false;
+            appendInteger(out, value);
+            return true;
+        }
+        case BinaryArgType::UINT64: {
+            uint64_t value;
+            if (!reader.read(value)) return false;
+            appendInteger(out, value);
+            return true;
+        }
+        case BinaryArgType::DOUBLE: {
+            double value;
+            if (!reader.read(value)) return false;
+            appendDouble(out, value, json);
+            return true;
+        }
+        case BinaryArgType::CHAR: {
+            char value;
+            if (!reader.read(value)) return false;
+            std::string_view text(&value, 1);
+            json ? appendJsonString(out, text) : appendLogfmtString(out, text);
+            return true;
+        }
+        case BinaryArgType::STRING: {
+            std::string_view text;
+            if (!reader.readString(text)) return false;
+            json ? appendJsonString(out, text) : appendLogfmtString(out, text);
+            return true;
+        }
+        case BinaryArgType::BOOL: {
+            uint8_t value;
+            if (!reader.read(value)) return false;
+            if (value) {
+                out.literal("true");
+            } else {
+                out.literal("false");
+            }
+            return true;
+        }
+        case BinaryArgType::POINTER: {
+            uint64_t value;
+            if (!reader.read(value)) return false;
+            if (json) out.put('"');
+            appendPointer(out, value);
+            if (json) out.put('"');
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+// 追加全部字段：JSON为 ,"key":value；logfmt为 key=value
+void appendFields(const BinaryLogSite& site, const char* args, size_t size, bool json,
+                  EncodeBuffer& out) {
+    FieldReader reader(args, size);
+    for (size_t i = 0; i < site.arg_count; ++i) {
+        if (json) {
+            out.put(',');
+            appendJsonString(out, site.keys[i]);
+            out.put(':');
+        } else {
+            out.put(' ');
+            out.put(site.keys[i]);
+            out.put('=');
+        }
+        if (!appendFieldValue(out, site.arg_types[i], reader, json)) {
+            if (json) {
+                out.literal("null");
+            } else {
+                out.literal("<truncated>");
+            }
+            break;
+        }
+    }
+}
+
+} // namespace
+
+// 编码一条结构化日志
+void encodeStructuredRecord(LogKvFormat format, uint64_t timestamp_us, LogLevel level,
+                            const BinaryLogSite& site, const char* args, size_t size,
+                            std::string& out) {
+    EncodeBuffer buffer(out);
+    char* time_buf = buffer.reserve(AsyncLogger::TIME_BUFFER_SIZE + 16);
+    bool has_module = site.module && site.module[0] != '\0';
+
+    if (format == LogKvFormat::JSON) {
+        std::memcpy(time_buf, "{\"time\":\"", 9);
+        buffer.commit(time_buf + 9 + AsyncLogger::formatTimestamp(timestamp_us, time_buf + 9));
+        buffer.literal("\",\"level\":\"");
+        buffer.put(AsyncLogger::levelToString(level));
+        buffer.put('"');
+        if (has_module) {
+            buffer.literal(",\"module\":");
+            appendJsonString(buffer, site.module);
+        }
+        buffer.literal(",\"file\":");
+        appendJsonString(buffer, site.file);
+        buffer.literal(",\"line\":");
+        appendInteger(buffer, site.line);
+        buffer.literal(",\"func\":");
+        appendJsonString(buffer, site.func);
+        buffer.literal(",\"msg\":");
+        appendJsonString(buffer, site.format);
+        appendFields(site, args, size, true, buffer);
+        buffer.put('}');
+        return;
+    }
+
+    std::memcpy(time_buf, "time=\"", 6);
+    buffer.commit(time_buf + 6 + AsyncLogger::formatTimestamp(timestamp_us, time_buf + 6));
+    buffer.literal("\" level=");
+    buffer.put(AsyncLogger::levelToString(level));
+    if (has_module) {
+        buffer.literal(" module=");
+        appendLogfmtString(buffer, site.module);
+    }
+    buffer.literal(" file=");
+    appendLogfmtString(buffer, site.file);
+    buffer.literal(" line=");
+    appendInteger(buffer, site.line);
+    buffer.literal(" func=");
+    appendLogfmtString(buffer, site.func);
+    buffer.literal(" msg=");
+    appendLogfmtString(buffer, site.format);
+    appendFields(site, args, size, false, buffer);
+}
+
+// 以logfmt追加字段
+void appendStructuredFields(const BinaryLogSite& site, const char* args, size_t size,
+                            std::string& out) {
+    EncodeBuffer buffer(out);
+    appendFields(site, args, size, false, buffer);
+}
+
+} // namespace log
+} // namespace yalgo
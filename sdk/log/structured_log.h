@@ -0,0 +1,163 @@
+/**
+ * @file structured_log.h
+ * @brief 结构化键值日志（JSON / logfmt）
+ * @author yAlgo Team
+ * @date 2026-10-16
+ * @version 1.0.0
+ *
+ * 调用线程按类型打包字段值，字段名与消息随调用点静态登记一次；
+ * 写入线程把记录直接编码为一行JSON或logfmt，下游无需再用正则解析文本日志。
+ * 编码器只向复用的输出缓冲追加，数字用std::to_chars格式化，
+ * 浮点数输出可精确还原的最短表示。
+ */
+
+#ifndef YALGO_SDK_LOG_STRUCTURED_LOG_H
+#define YALGO_SDK_LOG_STRUCTURED_LOG_H
+
+#include "log_exports.h"
+#include "async_logger.h"
+#include "binary_log.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace yalgo {
+namespace log {
+
+/**
+ * @brief 把结构化日志编码为一行（不含换行符）
+ *
+ * @details JSON：{"time":"...","level":"INFO","module":"...","file":"...","line":1,"func":"...","msg":"...",字段...}
+ * logfmt：time="..." level=INFO module=... file=... line=1 func=... msg="..." 字段...
+ * 无模块时省略module。JSON中的非有限浮点数输出为null。
+ * @param format 编码格式
+ * @param timestamp_us 时间戳（Unix纪元微秒）
+ * @param level 日志级别
+ * @param site 结构化调用点（keys非空）
+ * @param args 字段值原始字节
+ * @param size 字段值字节数
+ * @param out 追加输出
+ */
+LOG_API void encodeStructuredRecord(LogKvFormat format, uint64_t timestamp_us, LogLevel level,
+                                    const BinaryLogSite& site, const char* args, size_t size,
+                                    std::string& out);
+
+/**
+ * @brief 以logfmt追加全部字段（每个字段前加一个空格），用于文本布局与关键词过滤
+ * @param site 结构化调用点（keys非空）
+ * @param args 字段值原始字节
+ * @param size 字段值字节数
+ * @param out 追加输出
+ */
+LOG_API void appendStructuredFields(const BinaryLogSite& site, const char* args, size_t size,
+                                    std::string& out);
+
+namespace detail {
+
+/**
+ * @brief 按字段对提交一条结构化日志
+ *
+ * @details 偶数位置为字段名，奇数位置为字段值。字段名数组在首次调用时保存，
+ * 之后只拷贝字段值。
+ */
+template <typename SiteTag, size_t... I, typename... Args>
+inline void logStructuredFields(SiteTag, std::index_sequence<I...>, LogLevel level, const char* module,
+                                const char* file, int line, const char* func, const char* message,
+                                const std::tuple<const Args&...>& fields) {
+    using Fields = std::tuple<Args...>;
+    static_assert((std::is_convertible<typename std::tuple_element<2 * I, Fields>::type,
+                                       const char*>::value && ...),
+                  "结构化日志字段名须为字符串字面量");
+
+    static const BinaryArgType value_types[sizeof...(I) + 1] = {
+        binaryArgType<typename std::tuple_element<2 * I + 1, Fields>::type>()...};
+    static const char* const keys[sizeof...(I) + 1] = {std::get<2 * I>(fields)...};
+    static const BinaryLogSite* site = [&]() {
+        BinaryLogSite desc;
+        desc.level = level;
+        desc.module = module;
+        desc.file = file;
+        desc.line = line;
+        desc.func = func;
+        desc.format = message;
+        desc.arg_types = value_types;
+        desc.arg_count = sizeof...(I);
+        desc.keys = keys;
+        return registerBinaryLogSite(desc);
+    }();
+
+    LogRecord record;
+    record.level = level;
+    record.site = site;
+    record.args.resize((size_t(0) + ... + binaryArgSize(std::get<2 * I + 1>(fields))));
+    char* out = &record.args[0];
+    (void)out;
+    (encodeBinaryArg(out, std::get<2 * I + 1>(fields)), ...);
+    AsyncLogger::getInstance().submit(std::move(record));
+}
+
+/**
+ * @brief 提交一条结构化日志（SiteTag保证每个调用点拥有独立的静态描述）
+ */
+template <typename SiteTag, typename... Args>
+inline void logStructured(SiteTag tag, LogLevel level, uint32_t module_id, const char* module,
+                          const char* file, int line, const char* func, const char* message,
+                          const Args&... fields) {
+    static_assert(sizeof...(Args) % 2 == 0, "结构化日志字段须按 字段名, 值 成对给出");
+    if (!AsyncLogger::moduleLevelEnabled(module_id, level)) {
+        return;
+    }
+    logStructuredFields(tag, std::make_index_sequence<sizeof...(Args) / 2>(), level, module, file,
+                        line, func, message, std::tuple<const Args&...>(fields...));
+}
+
+} // namespace detail
+
+} // namespace log
+} // namespace yalgo
+
+// 结构化日志宏：消息、字段名与模块名须为字符串字面量，级别关闭时不求值字段值
+#define YLOG_KV_IMPL(level, module, message, ...) do { \
+    if (YLOG_MODULE_ENABLED(module, level)) { \
+        yalgo::log::detail::logStructured([] {}, level, YLOG_MODULE_ID(module), module, __FILE__, __LINE__, \
+                                          __func__, message, ##__VA_ARGS__); \
+    } \
+} while(0)
+
+#if YALGO_LOG_LEVEL >= 1 // LOG_ERROR级别
+#define YLOG_ERROR_KV(message, ...) YLOG_KV_IMPL(yalgo::log::LogLevel::LOG_ERROR, "", message, ##__VA_ARGS__)
+#define YLOG_MODULE_ERROR_KV(module, message, ...) YLOG_KV_IMPL(yalgo::log::LogLevel::LOG_ERROR, module, message, ##__VA_ARGS__)
+#else
+#define YLOG_ERROR_KV(message, ...) do {} while(0)
+#define YLOG_MODULE_ERROR_KV(module, message, ...) do {} while(0)
+#endif
+
+#if YALGO_LOG_LEVEL >= 2 // WARN级别
+#define YLOG_WARN_KV(message, ...) YLOG_KV_IMPL(yalgo::log::LogLevel::WARN, "", message, ##__VA_ARGS__)
+#define YLOG_MODULE_WARN_KV(module, message, ...) YLOG_KV_IMPL(yalgo::log::LogLevel::WARN, module, message, ##__VA_ARGS__)
+#else
+#define YLOG_WARN_KV(message, ...) do {} while(0)
+#define YLOG_MODULE_WARN_KV(module, message, ...) do {} while(0)
+#endif
+
+#if YALGO_LOG_LEVEL >= 3 // INFO级别
+#define YLOG_INFO_KV(message, ...) YLOG_KV_IMPL(yalgo::log::LogLevel::INFO, "", message, ##__VA_ARGS__)
+#define YLOG_MODULE_INFO_KV(module, message, ...) YLOG_KV_IMPL(yalgo::log::LogLevel::INFO, module, message, ##__VA_ARGS__)
+#else
+#define YLOG_INFO_KV(message, ...) do {} while(0)
+#define YLOG_MODULE_INFO_KV(module, message, ...) do {} while(0)
+#endif
+
+#if YALGO_LOG_LEVEL >= 4 // DEBUG级别
+#define YLOG_DEBUG_KV(message, ...) YLOG_KV_IMPL(yalgo::log::LogLevel::DEBUG, "", message, ##__VA_ARGS__)
+#define YLOG_MODULE_DEBUG_KV(module, message, ...) YLOG_KV_IMPL(yalgo::log::LogLevel::DEBUG, module, message, ##__VA_ARGS__)
+#else
+#define YLOG_DEBUG_KV(message, ...) do {} while(0)
+#define YLOG_MODULE_DEBUG_KV(module, message, ...) do {} while(0)
+#endif
+
+#endif // YALGO_SDK_LOG_STRUCTURED_LOG_H